@@ -10,6 +10,8 @@ check_include_files(sys/epoll.h SOLID_USE_EPOLL)
 if(SOLID_USE_EPOLL)
     set(SOLID_USE_EPOLLRDHUP TRUE)
 endif()
+
+option(SOLID_WITH_IO_URING "Use io_uring instead of epoll for frame::aio::Reactor (Linux only)" OFF)
 #check_include_files("unordered_map" HAVE_UNORDERED_MAP)
 
 # check if function local static variables are thread safe
@@ -32,3 +34,29 @@ file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/gnuatomic.cpp" source_code)
 
 CHECK_CXX_SOURCE_RUNS("${source_code}" SOLID_USE_GNU_ATOMIC)
 
+if(SOLID_USE_EPOLL)
+    # sub-millisecond reactor timeouts - the kernel support is checked at runtime
+    file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/epoll_pwait2.cpp" source_code)
+
+    CHECK_CXX_SOURCE_COMPILES("${source_code}" SOLID_USE_EPOLL_PWAIT2)
+endif()
+
+if(SOLID_USE_EPOLL AND SOLID_WITH_IO_URING)
+    file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/io_uring.cpp" source_code)
+
+    CHECK_CXX_SOURCE_RUNS("${source_code}" SOLID_USE_IO_URING)
+endif()
+
+
+# the optional coroutine layer (solid/frame/aio/aiocoroutine.hpp) needs C++20 - the libraries do not
+file (READ "${CMAKE_CURRENT_SOURCE_DIR}/cmake/check/coroutine.cpp" source_code)
+
+if(MSVC)
+    set(CMAKE_REQUIRED_FLAGS "/std:c++20")
+else()
+    set(CMAKE_REQUIRED_FLAGS "-std=c++20")
+endif()
+
+CHECK_CXX_SOURCE_COMPILES("${source_code}" SOLID_HAS_COROUTINES)
+
+unset(CMAKE_REQUIRED_FLAGS)
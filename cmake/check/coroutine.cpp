@@ -0,0 +1,22 @@
+#include <coroutine>
+
+struct Task {
+    struct promise_type {
+        Task               get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void               return_void() noexcept {}
+        void               unhandled_exception() noexcept {}
+    };
+};
+
+Task run()
+{
+    co_await std::suspend_never{};
+}
+
+int main()
+{
+    run();
+    return 0;
+}
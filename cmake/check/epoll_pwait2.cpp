@@ -0,0 +1,9 @@
+#include <sys/epoll.h>
+#include <time.h>
+#include <cstddef>
+
+int main(){
+    epoll_event ev;
+    timespec    ts = {0, 100000};
+    return epoll_pwait2(-1, &ev, 1, &ts, NULL) == 0 ? 1 : 0;
+}
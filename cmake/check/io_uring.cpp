@@ -0,0 +1,17 @@
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+
+int main(){
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = syscall(__NR_io_uring_setup, 8, &params);
+    printf("io_uring = %d features = %x", fd, params.features);
+    if(fd < 0 || (params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_NODROP) == 0){
+        return 1;
+    }
+    close(fd);
+    return 0;
+}
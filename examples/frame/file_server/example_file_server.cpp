@@ -144,6 +144,7 @@ private:
         WaitRead,
         WaitWrite,
         RunRead,
+        RunSendFile,
         RunWrite,
         CloseFileError,
     };
@@ -471,7 +472,12 @@ void Connection::doRun(frame::aio::ReactorContext& _rctx)
         solid_log(generic_logger, Info, "keep waiting");
         break;
     case RunRead:
-        if (!iofs.eof()) {
+        if (iofs.device()->device() != nullptr) {
+            //regular files go from the page cache directly to the socket
+            FileDevice& rfd = *iofs.device()->device();
+            state           = RunSendFile;
+            sock.postSendFile(_rctx, rfd, 0, static_cast<size_t>(rfd.size()), onSend);
+        } else if (!iofs.eof()) {
             iofs.read(bbeg, BufferCapacity);
 
             sock.postSendAll(_rctx, bbeg, iofs.gcount(), onSend);
@@ -480,6 +486,10 @@ void Connection::doRun(frame::aio::ReactorContext& _rctx)
             postStop(_rctx);
         }
         break;
+    case RunSendFile:
+        iofs.close();
+        postStop(_rctx);
+        break;
     case RunWrite: {
         const char* p = findEnd(bpos);
         iofs.write(bpos, p - bpos);
@@ -0,0 +1,565 @@
+// solid/frame/aio/aiocoroutine.hpp
+//
+// Copyright (c) 2026 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+/*
+    Optional C++20 coroutine layer over the callback based aio API.
+
+    The header is only usable from code compiled with coroutine support -
+    the solid libraries themselves stay C++14.
+
+    An aio::Object keeps the aio::Task returned by its coroutine and starts it
+    from a callback (usually onEvent on generic_event_start). The coroutine
+    runs until the first co_await that cannot complete immediately and it is
+    resumed from the completion callback, on the reactor thread of the object.
+    CoroutineContext follows the ReactorContext of the callback that resumed
+    the coroutine:
+
+    frame::aio::Task run(frame::aio::ReactorContext& _rctx)
+    {
+        frame::aio::CoroutineContext ctx(_rctx);
+
+        while (true) {
+            const size_t sz = co_await frame::aio::co_recv_some(ctx, sock, buf, sizeof(buf));
+            if (ctx->error()) {
+                break;
+            }
+            co_await frame::aio::co_send_all(ctx, sock, buf, sz);
+            ...
+        }
+        postStop(*ctx);
+    }
+
+    The coroutine frames are allocated from a pool of the reactor thread.
+    When the object stops, the pending operations are dropped and the
+    frame is destroyed along with the Task.
+*/
+
+#if defined(__cpp_impl_coroutine)
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/manager.hpp"
+#include "solid/utility/event.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace solid {
+namespace frame {
+namespace aio {
+
+//! Per thread - so, per reactor - pool of coroutine frames
+/*!
+    Frames are grouped in classes of Granularity bytes and at most
+    MaxFreeCount free frames are kept for every class.
+    A frame released on another thread - e.g. after its object was moved
+    to another reactor - goes to the pool of that thread.
+*/
+class CoroutineFramePool {
+public:
+    enum {
+        Granularity  = 64,
+        ClassCount   = 64, //frames up to 4KB are pooled
+        MaxFreeCount = 32,
+    };
+
+    static CoroutineFramePool& specific()
+    {
+        thread_local CoroutineFramePool pool;
+        return pool;
+    }
+
+    CoroutineFramePool(const CoroutineFramePool&) = delete;
+    CoroutineFramePool& operator=(const CoroutineFramePool&) = delete;
+
+    ~CoroutineFramePool()
+    {
+        for (size_t i = 0; i < ClassCount; ++i) {
+            while (free_vec_[i] != nullptr) {
+                Node* pnode  = free_vec_[i];
+                free_vec_[i] = pnode->pnext;
+                ::operator delete(pnode);
+            }
+        }
+    }
+
+    void* allocate(const size_t _sz)
+    {
+        const size_t idx = classIndex(_sz);
+
+        if (idx < ClassCount) {
+            if (free_vec_[idx] != nullptr) {
+                Node* pnode    = free_vec_[idx];
+                free_vec_[idx] = pnode->pnext;
+                --count_vec_[idx];
+                return pnode;
+            }
+            return ::operator new((idx + 1) * Granularity);
+        }
+        return ::operator new(_sz);
+    }
+
+    void release(void* _p, const size_t _sz)
+    {
+        const size_t idx = classIndex(_sz);
+
+        if (idx < ClassCount && count_vec_[idx] < MaxFreeCount) {
+            Node* pnode    = static_cast<Node*>(_p);
+            pnode->pnext   = free_vec_[idx];
+            free_vec_[idx] = pnode;
+            ++count_vec_[idx];
+        } else {
+            ::operator delete(_p);
+        }
+    }
+
+private:
+    struct Node {
+        Node* pnext;
+    };
+
+    CoroutineFramePool()
+    {
+        for (size_t i = 0; i < ClassCount; ++i) {
+            free_vec_[i]  = nullptr;
+            count_vec_[i] = 0;
+        }
+    }
+
+    static size_t classIndex(const size_t _sz)
+    {
+        return (_sz - 1) / Granularity;
+    }
+
+private:
+    Node*  free_vec_[ClassCount];
+    size_t count_vec_[ClassCount];
+};
+
+//! The coroutine of an aio::Object
+/*!
+    Starts eagerly and owns the coroutine frame - keep it in the object.
+    An exception escaping the coroutine terminates the program.
+*/
+class [[nodiscard]] Task {
+public:
+    struct promise_type {
+        Task get_return_object()
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        //the frame is destroyed by the Task
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        static void* operator new(const size_t _sz)
+        {
+            return CoroutineFramePool::specific().allocate(_sz);
+        }
+
+        static void operator delete(void* _p, const size_t _sz)
+        {
+            CoroutineFramePool::specific().release(_p, _sz);
+        }
+    };
+
+    Task() noexcept {}
+
+    Task(Task&& _rtask) noexcept
+        : handle_(_rtask.handle_)
+    {
+        _rtask.handle_ = nullptr;
+    }
+
+    Task& operator=(Task&& _rtask) noexcept
+    {
+        if (this != &_rtask) {
+            clear();
+            handle_        = _rtask.handle_;
+            _rtask.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        clear();
+    }
+
+    bool done() const
+    {
+        return !handle_ || handle_.done();
+    }
+
+    //! Destroys the coroutine frame - no completion of a pending operation may resume it afterwards
+    void clear()
+    {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> _handle)
+        : handle_(_handle)
+    {
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+//! The ReactorContext of the callback that last resumed the coroutine
+class CoroutineContext {
+public:
+    explicit CoroutineContext(ReactorContext& _rctx)
+        : pctx_(&_rctx)
+    {
+    }
+
+    CoroutineContext(const CoroutineContext&) = delete;
+    CoroutineContext& operator=(const CoroutineContext&) = delete;
+
+    ReactorContext& operator*() const
+    {
+        return *pctx_;
+    }
+
+    ReactorContext* operator->() const
+    {
+        return pctx_;
+    }
+
+    void reset(ReactorContext& _rctx)
+    {
+        pctx_ = &_rctx;
+    }
+
+private:
+    ReactorContext* pctx_;
+};
+
+//! Payload of the generic_event_resume events raised by the operations completing outside the reactor
+struct CoroutineResume {
+    CoroutineContext*       pcctx;
+    std::coroutine_handle<> handle;
+};
+
+//! Resumes a coroutine waiting on co_resolve - call it from Object::onEvent
+/*!
+    Returns false if the event is not for a coroutine.
+*/
+inline bool resume_coroutine(ReactorContext& _rctx, Event& _revent)
+{
+    if (generic_event_resume == _revent) {
+        CoroutineResume* presume = _revent.any().cast<CoroutineResume>();
+
+        if (presume != nullptr) {
+            presume->pcctx->reset(_rctx);
+            presume->handle.resume();
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+//  Awaitables
+//-----------------------------------------------------------------------------
+
+template <class Stream>
+class RecvSomeAwaiter {
+public:
+    RecvSomeAwaiter(CoroutineContext& _rcctx, Stream& _rstream, char* _buf, const size_t _bufcp)
+        : rcctx_(_rcctx)
+        , rstream_(_rstream)
+        , buf_(_buf)
+        , bufcp_(_bufcp)
+        , sz_(0)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    //does not suspend when the data was already available
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        return !rstream_.recvSome(
+            *rcctx_, buf_, bufcp_,
+            [this, _handle](ReactorContext& _rctx, size_t _sz) {
+                sz_ = _sz;
+                rcctx_.reset(_rctx);
+                _handle.resume();
+            },
+            sz_);
+    }
+
+    size_t await_resume() const noexcept
+    {
+        return sz_;
+    }
+
+private:
+    CoroutineContext& rcctx_;
+    Stream&           rstream_;
+    char*             buf_;
+    const size_t      bufcp_;
+    size_t            sz_;
+};
+
+template <class Stream>
+class SendAllAwaiter {
+public:
+    SendAllAwaiter(CoroutineContext& _rcctx, Stream& _rstream, char* _buf, const size_t _bufcp)
+        : rcctx_(_rcctx)
+        , rstream_(_rstream)
+        , buf_(_buf)
+        , bufcp_(_bufcp)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        return !rstream_.sendAll(
+            *rcctx_, buf_, bufcp_,
+            [this, _handle](ReactorContext& _rctx) {
+                rcctx_.reset(_rctx);
+                _handle.resume();
+            });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    CoroutineContext& rcctx_;
+    Stream&           rstream_;
+    char*             buf_;
+    const size_t      bufcp_;
+};
+
+template <class Stream>
+class ConnectAwaiter {
+public:
+    ConnectAwaiter(CoroutineContext& _rcctx, Stream& _rstream, SocketAddressStub const& _rsas)
+        : rcctx_(_rcctx)
+        , rstream_(_rstream)
+        , rsas_(_rsas)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        return !rstream_.connect(
+            *rcctx_, rsas_,
+            [this, _handle](ReactorContext& _rctx) {
+                rcctx_.reset(_rctx);
+                _handle.resume();
+            });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    CoroutineContext&        rcctx_;
+    Stream&                  rstream_;
+    SocketAddressStub const& rsas_;
+};
+
+template <class Timer, class TimePoint>
+class WaitAwaiter {
+public:
+    WaitAwaiter(CoroutineContext& _rcctx, Timer& _rtimer, TimePoint const& _rtp)
+        : rcctx_(_rcctx)
+        , rtimer_(_rtimer)
+        , tp_(_rtp)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> _handle)
+    {
+        return !rtimer_.waitUntil(
+            *rcctx_, tp_,
+            [this, _handle](ReactorContext& _rctx) {
+                rcctx_.reset(_rctx);
+                _handle.resume();
+            });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    CoroutineContext& rcctx_;
+    Timer&            rtimer_;
+    TimePoint         tp_;
+};
+
+struct ResolveResult {
+    ResolveData data;
+    ErrorCodeT  error;
+};
+
+//! The resolver runs on its own threads - the coroutine is resumed through a generic_event_resume event
+class ResolveAwaiter {
+    struct State {
+        CoroutineResume resume;
+        ResolveResult   result;
+    };
+
+    using StatePointerT = std::shared_ptr<State>;
+
+public:
+    ResolveAwaiter(
+        CoroutineContext& _rcctx, Resolver& _rresolver,
+        const char* _host, const char* _srvc,
+        int _flags, int _family, int _type, int _proto)
+        : rcctx_(_rcctx)
+        , rresolver_(_rresolver)
+        , host_(_host)
+        , srvc_(_srvc)
+        , flags_(_flags)
+        , family_(_family)
+        , type_(_type)
+        , proto_(_proto)
+        , state_ptr_(std::make_shared<State>())
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> _handle)
+    {
+        Manager&        rmanager = rcctx_->manager();
+        const ObjectIdT objuid   = rmanager.id(rcctx_->object());
+        StatePointerT   state_ptr(state_ptr_); //keeps the result alive if the object stops
+
+        state_ptr_->resume.pcctx  = &rcctx_;
+        state_ptr_->resume.handle = _handle;
+
+        rresolver_.requestResolve(
+            [&rmanager, objuid, state_ptr](ResolveData& _rrd, ErrorCodeT const& _rerr) {
+                state_ptr->result.data  = std::move(_rrd);
+                state_ptr->result.error = _rerr;
+                rmanager.notify(objuid, make_event(GenericEvents::Resume, state_ptr->resume));
+            },
+            host_.c_str(), srvc_.c_str(), flags_, family_, type_, proto_);
+    }
+
+    ResolveResult await_resume()
+    {
+        return std::move(state_ptr_->result);
+    }
+
+private:
+    CoroutineContext& rcctx_;
+    Resolver&         rresolver_;
+    std::string       host_;
+    std::string       srvc_;
+    int               flags_;
+    int               family_;
+    int               type_;
+    int               proto_;
+    StatePointerT     state_ptr_;
+};
+
+//! Receive some data - the size is zero on error
+template <class Stream>
+RecvSomeAwaiter<Stream> co_recv_some(CoroutineContext& _rcctx, Stream& _rstream, char* _buf, const size_t _bufcp)
+{
+    return RecvSomeAwaiter<Stream>(_rcctx, _rstream, _buf, _bufcp);
+}
+
+//! Send all the data - check _rcctx->error()
+template <class Stream>
+SendAllAwaiter<Stream> co_send_all(CoroutineContext& _rcctx, Stream& _rstream, char* _buf, const size_t _bufcp)
+{
+    return SendAllAwaiter<Stream>(_rcctx, _rstream, _buf, _bufcp);
+}
+
+//! Connect the stream - check _rcctx->error()
+template <class Stream>
+ConnectAwaiter<Stream> co_connect(CoroutineContext& _rcctx, Stream& _rstream, SocketAddressStub const& _rsas)
+{
+    return ConnectAwaiter<Stream>(_rcctx, _rstream, _rsas);
+}
+
+//! Wait on the timer - _rcctx->error() is set if the timer was canceled
+template <class Timer, class Rep, class Period>
+auto co_wait_for(CoroutineContext& _rcctx, Timer& _rtimer, std::chrono::duration<Rep, Period> const& _rd)
+{
+    return co_wait_until(_rcctx, _rtimer, _rcctx->steadyTime() + _rd);
+}
+
+template <class Timer, class Clock, class Duration>
+WaitAwaiter<Timer, std::chrono::time_point<Clock, Duration>> co_wait_until(CoroutineContext& _rcctx, Timer& _rtimer, std::chrono::time_point<Clock, Duration> const& _rtp)
+{
+    return WaitAwaiter<Timer, std::chrono::time_point<Clock, Duration>>(_rcctx, _rtimer, _rtp);
+}
+
+//! Resolve on the resolver threads - the object must forward generic_event_resume to resume_coroutine
+inline ResolveAwaiter co_resolve(
+    CoroutineContext& _rcctx, Resolver& _rresolver,
+    const char* _host, const char* _srvc,
+    int _flags = 0, int _family = -1, int _type = -1, int _proto = -1)
+{
+    return ResolveAwaiter(_rcctx, _rresolver, _host, _srvc, _flags, _family, _type, _proto);
+}
+
+} //namespace aio
+} //namespace frame
+} //namespace solid
+
+#endif // __cpp_impl_coroutine
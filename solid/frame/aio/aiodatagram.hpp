@@ -239,6 +239,66 @@ class Datagram : public CompletionHandler {
         }
     };
 
+    template <class F>
+    struct RecvFromBatchFunctor {
+        F f;
+
+        RecvFromBatchFunctor(F& _rf)
+            : f{std::move(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            size_t recv_cnt = 0;
+
+            if (!_rctx.error()) {
+                bool       can_retry;
+                ErrorCodeT err;
+                ssize_t    rv = _rthis.s.recvFrom(_rctx, _rthis.recv_slot, _rthis.recv_slot_cnt, can_retry, err);
+
+                if (rv > 0) {
+                    recv_cnt = rv;
+                } else if (rv == 0) {
+                    _rthis.error(_rctx, error_datagram_shutdown);
+                } else if (rv == -1) {
+                    if (can_retry) {
+                        return;
+                    } else {
+                        _rthis.error(_rctx, error_datagram_system);
+                        _rthis.systemError(_rctx, err);
+                        SOLID_ASSERT(err);
+                    }
+                }
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearRecv(_rctx);
+            tmp(_rctx, recv_cnt);
+        }
+    };
+
+    template <class F>
+    struct SendToBatchFunctor {
+        F f;
+
+        SendToBatchFunctor(F& _rf)
+            : f{std::move(_rf)}
+        {
+        }
+
+        void operator()(ThisT& _rthis, ReactorContext& _rctx)
+        {
+            if (!_rctx.error() && !_rthis.doTrySendBatch(_rctx)) {
+                return;
+            }
+
+            F tmp{std::move(f)};
+            _rthis.doClearSend(_rctx);
+            tmp(_rctx);
+        }
+    };
+
     template <class F>
     struct ConnectFunctor {
         F f;
@@ -264,9 +324,13 @@ public:
         , recv_buf(nullptr)
         , recv_buf_cp(0)
         , recv_is_posted(false)
+        , recv_slot(nullptr)
+        , recv_slot_cnt(0)
         , send_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_slot(nullptr)
+        , send_slot_cnt(0)
     {
     }
 
@@ -276,9 +340,13 @@ public:
         , recv_buf(nullptr)
         , recv_buf_cp(0)
         , recv_is_posted(false)
+        , recv_slot(nullptr)
+        , recv_slot_cnt(0)
         , send_buf(nullptr)
         , send_buf_cp(0)
         , send_is_posted(false)
+        , send_slot(nullptr)
+        , send_slot_cnt(0)
     {
     }
 
@@ -574,7 +642,149 @@ public:
         return true;
     }
 
+    //! Receive a batch of datagrams - at least one slot is filled on success
+    /*!
+        _f is called with the number of filled slots.
+    */
+    template <typename F>
+    bool postRecvFrom(
+        ReactorContext& _rctx,
+        DatagramSlot* _pslot, size_t _cnt,
+        F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            recv_fnc       = RecvFromBatchFunctor<F>(_f);
+            recv_slot      = _pslot;
+            recv_slot_cnt  = _cnt;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool recvFrom(
+        ReactorContext& _rctx,
+        DatagramSlot* _pslot, size_t _cnt,
+        F       _f,
+        size_t& _rcnt)
+    {
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            contextBind(_rctx);
+
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = s.recvFrom(_rctx, _pslot, _cnt, can_retry, err);
+
+            _rcnt = 0;
+
+            if (rv > 0) {
+                _rcnt = rv;
+                errorClear(_rctx);
+            } else if (rv == 0) {
+                error(_rctx, error_datagram_shutdown);
+            } else if (rv == -1) {
+                if (can_retry) {
+                    recv_slot     = _pslot;
+                    recv_slot_cnt = _cnt;
+                    recv_fnc      = RecvFromBatchFunctor<F>(_f);
+                    errorClear(_rctx);
+                    return false;
+                } else {
+                    error(_rctx, error_datagram_system);
+                    systemError(_rctx, err);
+                    SOLID_ASSERT(err);
+                }
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Send a batch of datagrams - _f is called after all the slots were sent
+    /*!
+        The slots must stay valid until the completion.
+    */
+    template <typename F>
+    bool postSendTo(
+        ReactorContext& _rctx,
+        const DatagramSlot* _pslot, size_t _cnt,
+        F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            send_fnc       = SendToBatchFunctor<F>(_f);
+            send_slot      = _pslot;
+            send_slot_cnt  = _cnt;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            SOLID_ASSERT(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendTo(
+        ReactorContext& _rctx,
+        const DatagramSlot* _pslot, size_t _cnt,
+        F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            contextBind(_rctx);
+
+            send_slot     = _pslot;
+            send_slot_cnt = _cnt;
+
+            errorClear(_rctx);
+
+            if (doTrySendBatch(_rctx)) {
+                send_slot     = nullptr;
+                send_slot_cnt = 0;
+            } else {
+                send_fnc = SendToBatchFunctor<F>(_f);
+                return false;
+            }
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
 private:
+    //returns false if it must wait for the socket to become writable
+    bool doTrySendBatch(ReactorContext& _rctx)
+    {
+        while (send_slot_cnt != 0) {
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = s.sendTo(_rctx, send_slot, send_slot_cnt, can_retry, err);
+
+            if (rv > 0) {
+                send_slot += rv;
+                send_slot_cnt -= rv;
+            } else if (rv == 0) {
+                error(_rctx, error_datagram_shutdown);
+                break;
+            } else if (can_retry) {
+                return false;
+            } else {
+                error(_rctx, error_datagram_system);
+                systemError(_rctx, err);
+                SOLID_ASSERT(err);
+                break;
+            }
+        }
+        return true;
+    }
+
     void doPostRecvSome(ReactorContext& _rctx)
     {
         reactor(_rctx).post(_rctx, on_posted_recv, Event(), *this);
@@ -616,15 +826,19 @@ private:
     void doClearRecv(ReactorContext& _rctx)
     {
         SOLID_FUNCTION_CLEAR(recv_fnc);
-        recv_buf    = nullptr;
-        recv_buf_cp = 0;
+        recv_buf      = nullptr;
+        recv_buf_cp   = 0;
+        recv_slot     = nullptr;
+        recv_slot_cnt = 0;
     }
 
     void doClearSend(ReactorContext& _rctx)
     {
         SOLID_FUNCTION_CLEAR(send_fnc);
-        send_buf    = nullptr;
-        recv_buf_cp = 0;
+        send_buf      = nullptr;
+        recv_buf_cp   = 0;
+        send_slot     = nullptr;
+        send_slot_cnt = 0;
     }
     void doClear(ReactorContext& _rctx)
     {
@@ -641,12 +855,16 @@ private:
     size_t        recv_buf_cp;
     RecvFunctionT recv_fnc;
     bool          recv_is_posted;
-
-    const char*   send_buf;
-    size_t        send_buf_cp;
-    SendFunctionT send_fnc;
-    SocketAddress send_addr;
-    bool          send_is_posted;
+    DatagramSlot* recv_slot;
+    size_t        recv_slot_cnt;
+
+    const char*         send_buf;
+    size_t              send_buf_cp;
+    SendFunctionT       send_fnc;
+    SocketAddress       send_addr;
+    bool                send_is_posted;
+    const DatagramSlot* send_slot;
+    size_t              send_slot_cnt;
 };
 
 } //namespace aio
@@ -29,6 +29,7 @@ extern const ErrorConditionT error_datagram_socket;
 extern const ErrorConditionT error_stream_system;
 extern const ErrorConditionT error_stream_socket;
 extern const ErrorConditionT error_stream_shutdown;
+extern const ErrorConditionT error_stream_file_end;
 
 extern const ErrorConditionT error_timer_cancel;
 
@@ -16,10 +16,15 @@
 #include "aioreactorcontext.hpp"
 #include "solid/frame/aio/aiocompletion.hpp"
 #include "solid/frame/aio/aiosocketbase.hpp"
+#include "solid/utility/event.hpp"
+#include <vector>
 
 namespace solid {
 struct Event;
 namespace frame {
+
+class Service;
+
 namespace aio {
 
 struct ObjectProxy;
@@ -32,12 +37,15 @@ class Listener : public CompletionHandler {
     static void on_dummy(ReactorContext&, SocketDevice&);
 
 public:
+    using SocketDeviceVectorT = std::vector<SocketDevice>;
+
     Listener(
         ObjectProxy const& _robj,
         SocketDevice&&     _rsd)
         : CompletionHandler(_robj, Listener::on_init_completion)
         , s(std::move(_rsd))
         , waitreq(ReactorWaitNone)
+        , batchmax(0)
     {
     }
 
@@ -56,7 +64,7 @@ public:
     template <typename F>
     bool postAccept(ReactorContext& _rctx, F _f)
     {
-        if (SOLID_FUNCTION_EMPTY(f)) {
+        if (SOLID_FUNCTION_EMPTY(f) && SOLID_FUNCTION_EMPTY(bf)) {
             f = std::move(_f);
             doPostAccept(_rctx);
             return false;
@@ -66,12 +74,31 @@ public:
         }
     }
 
+    //Like postAccept but accepts up to _max_count sockets per readiness event.
+    //On completion _f(ReactorContext&, SocketDeviceVectorT&) is called once with
+    //all of them - the sockets not moved out of the vector are closed.
+    //On error the vector is empty. A full vector means there might be more
+    //sockets waiting, so postAcceptBatch should be called again.
+    template <typename F>
+    bool postAcceptBatch(ReactorContext& _rctx, const size_t _max_count, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(f) && SOLID_FUNCTION_EMPTY(bf)) {
+            bf       = std::move(_f);
+            batchmax = _max_count != 0 ? _max_count : 1;
+            doPostAccept(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
     //Returns true when the operation completed. Check _rctx.error() for success or fail
     //Returns false when operation is scheduled for completion. On completion _f(...) will be called.
     template <typename F>
     bool accept(ReactorContext& _rctx, F _f, SocketDevice& _rsd)
     {
-        if (SOLID_FUNCTION_EMPTY(f)) {
+        if (SOLID_FUNCTION_EMPTY(f) && SOLID_FUNCTION_EMPTY(bf)) {
             contextBind(_rctx);
 
             if (this->doTryAccept(_rctx, _rsd)) {
@@ -89,15 +116,71 @@ private:
     void doPostAccept(ReactorContext& _rctx);
     bool doTryAccept(ReactorContext& _rctx, SocketDevice& _rsd);
     void doAccept(ReactorContext& _rctx, solid::SocketDevice& _rsd);
+    void doAcceptBatch(ReactorContext& _rctx, SocketDeviceVectorT& _rsd_vec);
+    void doCompleteAcceptBatch(ReactorContext& _rctx);
     void doClear(ReactorContext& _rctx);
 
 private:
     typedef SOLID_FUNCTION(void(ReactorContext&, SocketDevice&)) FunctionT;
+    typedef SOLID_FUNCTION(void(ReactorContext&, SocketDeviceVectorT&)) BatchFunctionT;
     FunctionT            f;
+    BatchFunctionT       bf;
     SocketBase           s;
     ReactorWaitRequestsE waitreq;
+    size_t               batchmax;
 };
 
+//! Creates _count listening sockets bound with SO_REUSEPORT to the same address
+/*!
+    The first socket is bound to _rai and the others to its local address,
+    which is returned in _rlocal_address.
+*/
+ErrorCodeT prepare_sharded_accept(
+    std::vector<SocketDevice>& _rsd_vec, const size_t _count, ResolveIterator const& _rai,
+    SocketAddress& _rlocal_address, const size_t _listencnt = SocketInfo::max_listen_backlog_size());
+
+//! Starts one listener object on every reactor of _rsch
+/*!
+    Every listener owns its own SO_REUSEPORT socket so the kernel spreads
+    the incoming connections among the reactors and each reactor accepts
+    on its own socket, without sharing a listen queue with the others.
+    The listener should start the accepted connections on the same
+    reactor - see ReactorContext::reactorIndex and Scheduler::startObject.
+
+    _create_fnc(SocketDevice&) must return a Sch::ObjectPointerT listener
+    owning the given socket.
+    Returns error_listener_system (and the cause in _rsys_err) when the
+    sockets cannot be prepared - e.g. SO_REUSEPORT is not available.
+*/
+template <class Sch, class F>
+ErrorConditionT start_sharded_listeners(
+    Sch& _rsch, Service& _rsvc, ResolveIterator const& _rai,
+    F _create_fnc, SocketAddress& _rlocal_address, ErrorCodeT& _rsys_err,
+    const size_t _listencnt = SocketInfo::max_listen_backlog_size())
+{
+    std::vector<SocketDevice> sd_vec;
+    ErrorConditionT           err;
+    const size_t              reactor_count = _rsch.reactorCount();
+
+    //on a stopped scheduler, startObject reports the error
+    _rsys_err = prepare_sharded_accept(sd_vec, reactor_count != 0 ? reactor_count : 1, _rai, _rlocal_address, _listencnt);
+
+    if (_rsys_err) {
+        return error_listener_system;
+    }
+
+    for (size_t i = 0; i < sd_vec.size(); ++i) {
+        typename Sch::ObjectPointerT objptr(_create_fnc(sd_vec[i]));
+
+        _rsch.startObject(objptr, _rsvc, i, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            break;
+        }
+    }
+    return err;
+}
+
 } //namespace aio
 } //namespace frame
 } //namespace solid
@@ -36,6 +36,7 @@ struct ChangeTimerIndexCallback;
 struct TimerCallback;
 struct EventHandler;
 struct ExecStub;
+struct MigrateTaskStub;
 
 typedef DynamicPointer<Object> ObjectPointerT;
 
@@ -112,6 +113,20 @@ public:
 
     void addConnect(ReactorContext& _rctx);
     void remConnect(ReactorContext& _rctx);
+#if defined(SOLID_USE_IO_URING)
+    //! Completion based socket I/O - see Socket and SocketBase::accept
+    /*!
+        The data goes through reactor owned buffers, so the caller's buffers
+        need not outlive the call.
+        While the request is in flight the calls fail with _can_retry set and
+        its completion is notified with ReactorEventRecv or ReactorEventSend.
+        A send is reported as done once the data was copied - its error, if
+        any, is reported by the next send.
+    */
+    ssize_t    recv(ReactorContext& _rctx, SocketDevice const& _rsd, IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr);
+    ssize_t    send(ReactorContext& _rctx, SocketDevice const& _rsd, const IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr);
+    ErrorCodeT accept(ReactorContext& _rctx, SocketDevice const& _rsd, SocketDevice& _rnewsd, bool& _can_retry);
+#endif
 
     bool start();
 
@@ -119,11 +134,16 @@ public:
     bool raise(UniqueId const& _robjuid, Event&& _uevt) override;
     void stop() override;
 
+    bool migrateObject(UniqueId const& _robjuid, const size_t _reactor_index) override;
+    bool migrateBusiestObjects(const size_t _count, const size_t _reactor_index) override;
+
     void registerCompletionHandler(CompletionHandler& _rch, Object const& _robj);
     void unregisterCompletionHandler(CompletionHandler& _rch);
 
     void run();
     bool push(TaskT& _robj, Service& _rsvc, Event&& _revt);
+    //! Push a batch of objects with a single inbox push and at most one wakeup
+    bool push(TaskT* const* _ptasks, const size_t _count, Service& _rsvc, Event const& _revt);
 
     Service& service(ReactorContext const& _rctx) const;
 
@@ -145,8 +165,10 @@ private:
     void doCompleteIo(NanoTime const& _rcrttime, const size_t _sz);
     void doCompleteTimer(NanoTime const& _rcrttime);
     void doCompleteExec(NanoTime const& _rcrttime);
+    void doCompleteExecBudget(ReactorContext& _rctx, size_t _sz);
     void doCompleteEvents(ReactorContext const& _rctx);
     void doCompleteEvents(NanoTime const& _rcrttime);
+    void doUpdatePollEvents();
     void doStoreSpecific();
     void doClearSpecific();
     void doUpdateTimerIndex(const size_t _chidx, const size_t _newidx, const size_t _oldidx);
@@ -156,11 +178,23 @@ private:
 
     void doStopObject(ReactorContext& _rctx);
 
+    void doCompleteMigrate(NanoTime const& _rcrttime);
+    void doMigrateObject(ReactorContext& _rctx, const size_t _objidx, const size_t _reactor_index);
+    void doDetachObject(ReactorContext& _rctx, MigrateTaskStub& _rtask);
+    void doAttachObject(ReactorContext& _rctx, MigrateTaskStub& _rtask);
+#if defined(SOLID_USE_IO_URING)
+    void doWakeIo(const size_t _objidx);
+#endif
+
     void        onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx);
     static void call_object_on_event(ReactorContext& _rctx, Event&& _uev);
     static void increase_event_vector_size(ReactorContext& _rctx, Event&& _uev);
     static void stop_object(ReactorContext& _rctx, Event&& _uevent);
     static void stop_object_repost(ReactorContext& _rctx, Event&& _uevent);
+#if defined(SOLID_USE_IO_URING)
+    static void wake_io_recv(ReactorContext& _rctx, Event&& _uevent);
+    static void wake_io_send(ReactorContext& _rctx, Event&& _uevent);
+#endif
 
     UniqueId objectUid(ReactorContext const& _rctx) const;
 
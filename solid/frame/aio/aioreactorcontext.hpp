@@ -61,6 +61,9 @@ struct ReactorContext {
 
     UniqueId objectUid() const;
 
+    //! The index of the current reactor within its scheduler
+    size_t reactorIndex() const;
+
     std::mutex& objectMutex() const;
 
     void clearError()
@@ -15,6 +15,7 @@
 #include "solid/system/socketaddress.hpp"
 #include "solid/utility/dynamictype.hpp"
 #include "solid/utility/function.hpp"
+#include <chrono>
 #include <string>
 
 namespace solid {
@@ -60,6 +61,9 @@ struct DirectResolve : ResolveBase {
     }
 
     ResolveData doRun();
+
+    //! Completes the request with an already resolved - possibly cached - result
+    virtual void complete(ResolveData& _rrd) = 0;
 };
 
 struct ReverseResolve : ResolveBase {
@@ -107,6 +111,11 @@ struct DirectResolveCbk : DirectResolve {
         }
         cbk(rd, this->error);
     }
+
+    /*virtual*/ void complete(ResolveData& _rrd)
+    {
+        cbk(_rrd, this->error);
+    }
 };
 
 template <class Cbk>
@@ -134,11 +143,60 @@ struct ReverseResolveCbk : ReverseResolve {
     }
 };
 
+//! Configuration of the Resolver cache of direct resolves
+/*!
+    Requests with the same host, service, flags, family, type and protocol
+    share an entry:
+    * while an entry is resolved, the requests for it wait for the one lookup;
+    * for ttl after the lookup, the requests get the cached address list;
+    * for stale_ttl past ttl, the requests get the old address list while the
+        entry is refreshed in background;
+    * an empty address list is cached for negative_ttl.
+    Cached results are still delivered on a resolver thread.
+*/
+struct ResolverCacheConfiguration {
+    ResolverCacheConfiguration(
+        const std::chrono::milliseconds _ttl             = std::chrono::milliseconds(0),
+        const std::chrono::milliseconds _negative_ttl    = std::chrono::milliseconds(0),
+        const std::chrono::milliseconds _stale_ttl       = std::chrono::milliseconds(0),
+        const size_t                    _max_entry_count = 1024)
+        : ttl(_ttl)
+        , negative_ttl(_negative_ttl)
+        , stale_ttl(_stale_ttl)
+        , max_entry_count(_max_entry_count)
+    {
+    }
+
+    bool enabled() const
+    {
+        return ttl.count() != 0 || negative_ttl.count() != 0;
+    }
+
+    std::chrono::milliseconds ttl; //zero and zero negative_ttl disable the cache
+    std::chrono::milliseconds negative_ttl;
+    std::chrono::milliseconds stale_ttl;
+    size_t                    max_entry_count; //when full, the requests for new entries are not cached
+};
+
+struct ResolverCacheStatistic {
+    ResolverCacheStatistic();
+
+    size_t lookup_count; //getaddrinfo calls, including the background refreshes
+    size_t hit_count;
+    size_t negative_hit_count; //included in hit_count
+    size_t stale_hit_count;
+    size_t coalesced_count; //requests waiting for the lookup of another request
+    size_t entry_count;
+};
+
 class Resolver {
 public:
     Resolver(const size_t _max_thr_cnt = 0, const size_t _max_job_cnt = 1024 * 64);
     ~Resolver();
 
+    //! Must be called before start
+    void cache(ResolverCacheConfiguration const& _rcfg);
+
     ErrorConditionT start(ushort _thrcnt = 0);
 
     template <class Cbk>
@@ -165,8 +223,11 @@ public:
 
     void stop();
 
+    void cacheStatistic(ResolverCacheStatistic& _rstat) const;
+
 private:
     void doSchedule(ResolveBase* _pb);
+    void doSchedule(DirectResolve* _pb);
 
 private:
     struct Data;
@@ -34,9 +34,44 @@ public:
     {
         return _evt;
     }
+#if defined(SOLID_USE_IO_URING)
+    //recv and send are completion based, so the poll interest is only
+    //registered by the first readiness based call that has to wait
+    void init(ReactorContext& _rctx)
+    {
+        addReactorRequestEvents(_rctx, ReactorWaitNone);
+    }
+
+    SocketDevice reset(ReactorContext& _rctx, SocketDevice&& _rsd)
+    {
+        SocketDevice tmpsd = std::move(device());
+        device()           = std::move(_rsd);
+
+        if (device()) {
+            device().makeNonBlocking();
+            init(_rctx);
+        }
+        return tmpsd;
+    }
+
+    ErrorCodeT checkConnect(ReactorContext& _rctx) const
+    {
+        ErrorCodeT err = device().error();
+        if (!err) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitNone);
+        }
+        return err;
+    }
+#endif
 
     ssize_t recv(ReactorContext& _rctx, char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
     {
+#if defined(SOLID_USE_IO_URING)
+        IoVecT iov;
+        iov.iov_base = _pb;
+        iov.iov_len  = _bl;
+        return reactorRecv(_rctx, &iov, 1, _can_retry, _rerr);
+#else
         const ssize_t rv = device().recv(_pb, _bl, _can_retry, _rerr);
 #if defined(SOLID_USE_WSAPOLL)
         if (rv < 0 && _can_retry) {
@@ -44,15 +79,103 @@ public:
         }
 #endif
         return rv;
+#endif
     }
 
     ssize_t send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
     {
+#if defined(SOLID_USE_IO_URING)
+        IoVecT iov;
+        iov.iov_base = const_cast<char*>(_pb);
+        iov.iov_len  = _bl;
+        return reactorSend(_rctx, &iov, 1, _can_retry, _rerr);
+#else
         const ssize_t rv = device().send(_pb, _bl, _can_retry, _rerr);
 #if defined(SOLID_USE_WSAPOLL)
         if (rv < 0 && _can_retry) {
             modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
         }
+#endif
+        return rv;
+#endif
+    }
+
+    ErrorCodeT enableZeroCopy()
+    {
+        return device().enableZeroCopy();
+    }
+
+    ssize_t sendZeroCopy(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _rzero_copy, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().sendZeroCopy(_pb, _bl, _rzero_copy, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
+#endif
+        return rv;
+    }
+
+    ssize_t recv(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+#if defined(SOLID_USE_IO_URING)
+        return reactorRecv(_rctx, _piov, _iovcnt, _can_retry, _rerr);
+#else
+        const ssize_t rv = device().recv(_piov, _iovcnt, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRead);
+        }
+#endif
+        return rv;
+#endif
+    }
+
+    ssize_t send(ReactorContext& _rctx, const IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+#if defined(SOLID_USE_IO_URING)
+        return reactorSend(_rctx, _piov, _iovcnt, _can_retry, _rerr);
+#else
+        const ssize_t rv = device().send(_piov, _iovcnt, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
+#endif
+        return rv;
+#endif
+    }
+
+    ssize_t sendFile(ReactorContext& _rctx, FileDevice& _rfd, int64_t _off, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().sendFile(_rfd, _off, _bl, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
+#endif
+        return rv;
+    }
+
+    //splice(2) is Linux only, so there is no WSAPoll handling
+    ssize_t recv(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().recv(_rpd, _bl, _can_retry, _rerr);
+#if defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
+#endif
+        return rv;
+    }
+
+    ssize_t send(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().send(_rpd, _bl, _can_retry, _rerr);
+#if defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
 #endif
         return rv;
     }
@@ -64,6 +187,8 @@ public:
         if (rv < 0 && _can_retry) {
             modifyReactorRequestEvents(_rctx, ReactorWaitRead);
         }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
 #endif
         return rv;
     }
@@ -75,9 +200,46 @@ public:
         if (rv < 0 && _can_retry) {
             modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
         }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
 #endif
         return rv;
     }
+
+    ssize_t recvFrom(ReactorContext& _rctx, DatagramSlot* _pslot, size_t _cnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().recv(_pslot, _cnt, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitRead);
+        }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
+#endif
+        return rv;
+    }
+
+    ssize_t sendTo(ReactorContext& _rctx, const DatagramSlot* _pslot, size_t _cnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        const ssize_t rv = device().send(_pslot, _cnt, _can_retry, _rerr);
+#if defined(SOLID_USE_WSAPOLL)
+        if (rv < 0 && _can_retry) {
+            modifyReactorRequestEvents(_rctx, ReactorWaitWrite);
+        }
+#elif defined(SOLID_USE_IO_URING)
+        waitReadiness(_rctx);
+#endif
+        return rv;
+    }
+#if defined(SOLID_USE_IO_URING)
+private:
+    //the readiness based calls need the poll interest even after a partial
+    //transfer - a spurious readiness event only costs a failed call
+    void waitReadiness(ReactorContext& _rctx) const
+    {
+        modifyReactorRequestEvents(_rctx, ReactorWaitReadOrWrite);
+    }
+#endif
 };
 
 } //namespace aio
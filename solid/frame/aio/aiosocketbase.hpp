@@ -66,7 +66,10 @@ public:
 
     void initAccept(ReactorContext& _rctx)
     {
-#if defined(SOLID_USE_EPOLL) || defined(SOLID_USE_KQUEUE)
+#if defined(SOLID_USE_IO_URING)
+        //accept is completion based
+        addReactorRequestEvents(_rctx, ReactorWaitNone);
+#elif defined(SOLID_USE_EPOLL) || defined(SOLID_USE_KQUEUE)
         addReactorRequestEvents(_rctx, ReactorWaitRead);
 #else
         addReactorRequestEvents(_rctx, ReactorWaitNone);
@@ -84,6 +87,9 @@ public:
 
     ErrorCodeT accept(ReactorContext& _rctx, SocketDevice& _rsd, bool& _can_retry)
     {
+#if defined(SOLID_USE_IO_URING)
+        return _rctx.reactor().accept(_rctx, device(), _rsd, _can_retry);
+#else
         ErrorCodeT err = device().accept(_rsd, _can_retry);
 #if defined(SOLID_USE_WSAPOLL)
         if (err && _can_retry) {
@@ -91,6 +97,7 @@ public:
         }
 #endif
         return err;
+#endif
     }
 
     bool create(ReactorContext& _rctx, SocketAddressStub const& _rsas, ErrorCodeT& _rerr)
@@ -100,6 +107,9 @@ public:
             _rerr = device().makeNonBlocking();
 #if defined(SOLID_USE_WSAPOLL)
             addReactorRequestEvents(_rctx, ReactorWaitNone);
+#elif defined(SOLID_USE_EPOLL)
+            //the events checkConnect asks for - so it does not need a epoll_ctl
+            addReactorRequestEvents(_rctx, ReactorWaitReadOrWrite);
 #else
             addReactorRequestEvents(_rctx, ReactorWaitWrite);
 #endif
@@ -159,6 +169,16 @@ protected:
     {
         _rctx.reactor().remConnect(_rctx);
     }
+#if defined(SOLID_USE_IO_URING)
+    ssize_t reactorRecv(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr) const
+    {
+        return _rctx.reactor().recv(_rctx, device(), _piov, _iovcnt, _can_retry, _rerr);
+    }
+    ssize_t reactorSend(ReactorContext& _rctx, const IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr) const
+    {
+        return _rctx.reactor().send(_rctx, device(), _piov, _iovcnt, _can_retry, _rerr);
+    }
+#endif
 
 private:
     SocketDevice dev_;
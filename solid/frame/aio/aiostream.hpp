@@ -13,6 +13,7 @@
 #include "aiocompletion.hpp"
 #include "aioerror.hpp"
 #include "solid/system/common.hpp"
+#include "solid/system/pipedevice.hpp"
 #include "solid/system/socketdevice.hpp"
 #include <cassert>
 
@@ -123,13 +124,17 @@ class Stream : public CompletionHandler {
 
         void operator()(ThisT& _rthis, ReactorContext& _rctx)
         {
-            while (_rthis.doTrySend(_rctx)) {
-                if (_rthis.send_buf_sz == _rthis.send_buf_cp) {
-                    F tmp{std::move(f)};
-                    _rthis.doClearSend(_rctx);
-                    tmp(_rctx);
-                    break;
-                }
+            //everything might have been sent already, waiting for the zero copy notifications
+            bool done = _rthis.send_buf_sz == _rthis.send_buf_cp;
+
+            while (!done && _rthis.doTrySend(_rctx)) {
+                done = _rthis.send_buf_sz == _rthis.send_buf_cp;
+            }
+
+            if (done && !_rthis.doIsZeroCopyPending(_rctx)) {
+                F tmp{std::move(f)};
+                _rthis.doClearSend(_rctx);
+                tmp(_rctx);
             }
         }
     };
@@ -269,11 +274,22 @@ public:
         , recv_buf(nullptr)
         , recv_buf_sz(0)
         , recv_buf_cp(0)
+        , recv_iov(nullptr)
+        , recv_iov_cnt(0)
+        , recv_pipe(nullptr)
         , recv_is_posted(false)
         , send_buf(nullptr)
         , send_buf_sz(0)
         , send_buf_cp(0)
+        , send_iov(nullptr)
+        , send_iov_cnt(0)
+        , send_file(nullptr)
+        , send_file_off(0)
+        , send_pipe(nullptr)
         , send_is_posted(false)
+        , zc_threshold(0)
+        , zc_send_count(0)
+        , zc_done_count(0)
     {
     }
 
@@ -285,11 +301,22 @@ public:
         , recv_buf(nullptr)
         , recv_buf_sz(0)
         , recv_buf_cp(0)
+        , recv_iov(nullptr)
+        , recv_iov_cnt(0)
+        , recv_pipe(nullptr)
         , recv_is_posted(false)
         , send_buf(nullptr)
         , send_buf_sz(0)
         , send_buf_cp(0)
+        , send_iov(nullptr)
+        , send_iov_cnt(0)
+        , send_file(nullptr)
+        , send_file_off(0)
+        , send_pipe(nullptr)
         , send_is_posted(false)
+        , zc_threshold(0)
+        , zc_send_count(0)
+        , zc_done_count(0)
     {
     }
 
@@ -299,11 +326,22 @@ public:
         , recv_buf(nullptr)
         , recv_buf_sz(0)
         , recv_buf_cp(0)
+        , recv_iov(nullptr)
+        , recv_iov_cnt(0)
+        , recv_pipe(nullptr)
         , recv_is_posted(false)
         , send_buf(nullptr)
         , send_buf_sz(0)
         , send_buf_cp(0)
+        , send_iov(nullptr)
+        , send_iov_cnt(0)
+        , send_file(nullptr)
+        , send_file_off(0)
+        , send_pipe(nullptr)
         , send_is_posted(false)
+        , zc_threshold(0)
+        , zc_send_count(0)
+        , zc_done_count(0)
     {
     }
 
@@ -315,11 +353,22 @@ public:
         , recv_buf(nullptr)
         , recv_buf_sz(0)
         , recv_buf_cp(0)
+        , recv_iov(nullptr)
+        , recv_iov_cnt(0)
+        , recv_pipe(nullptr)
         , recv_is_posted(false)
         , send_buf(nullptr)
         , send_buf_sz(0)
         , send_buf_cp(0)
+        , send_iov(nullptr)
+        , send_iov_cnt(0)
+        , send_file(nullptr)
+        , send_file_off(0)
+        , send_pipe(nullptr)
         , send_is_posted(false)
+        , zc_threshold(0)
+        , zc_send_count(0)
+        , zc_done_count(0)
     {
     }
 
@@ -361,6 +410,8 @@ public:
         contextBind(_rctx);
 
         SocketDevice sd(s.reset(_rctx, std::move(_rnewdev)));
+        zc_threshold  = 0;
+        zc_send_count = zc_done_count = 0;
         if (s.device()) {
             completionCallback(&on_completion);
         }
@@ -440,8 +491,264 @@ public:
             send_buf_cp = _bufcp;
             send_buf_sz = 0;
 
+            if (doTrySend(_rctx)) {
+                if (send_buf_sz == send_buf_cp && !doIsZeroCopyPending(_rctx)) {
+                    return true;
+                }
+            }
+            send_fnc = SendAllFunctor<F>(_f);
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Scatter read - completes after a single read into the _iovcnt buffers
+    /*!
+        The buffers array must stay valid until the completion.
+    */
+    template <typename F>
+    bool postRecvSome(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            recv_fnc       = RecvSomeFunctor<F>(_f);
+            recv_iov       = _piov;
+            recv_iov_cnt   = _iovcnt;
+            recv_buf_cp    = iov_size(_piov, _iovcnt);
+            recv_buf_sz    = 0;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool recvSome(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, F _f, size_t& _sz)
+    {
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            recv_iov     = _piov;
+            recv_iov_cnt = _iovcnt;
+            recv_buf_cp  = iov_size(_piov, _iovcnt);
+            recv_buf_sz  = 0;
+
+            if (doTryRecv(_rctx)) {
+                _sz = recv_buf_sz;
+                doClearRecvIov();
+                return true;
+            } else {
+                recv_fnc = RecvSomeFunctor<F>(_f);
+                return false;
+            }
+
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Gather write - completes when all the _iovcnt buffers were sent
+    /*!
+        The buffers array must stay valid until the completion and it is
+        modified while sending - the partially sent entries are advanced.
+    */
+    template <typename F>
+    bool postSendAll(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            send_fnc       = SendAllFunctor<F>(_f);
+            send_iov       = _piov;
+            send_iov_cnt   = _iovcnt;
+            send_buf_cp    = iov_size(_piov, _iovcnt);
+            send_buf_sz    = 0;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            SOLID_ASSERT(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendAll(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_iov     = _piov;
+            send_iov_cnt = _iovcnt;
+            send_buf_cp  = iov_size(_piov, _iovcnt);
+            send_buf_sz  = 0;
+
+            if (doTrySend(_rctx)) {
+                if (send_buf_sz == send_buf_cp) {
+                    doClearSendIov();
+                    return true;
+                }
+            }
+            send_fnc = SendAllFunctor<F>(_f);
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Sends _len bytes of _rfd starting at _off - completes when all were sent
+    /*!
+        Plain sockets use sendfile(2) on Linux so the data is not copied to user space.
+        The file device must stay valid until the completion.
+        The completion gets error_stream_file_end if the file is shorter.
+    */
+    template <typename F>
+    bool postSendFile(ReactorContext& _rctx, FileDevice& _rfd, int64_t _off, size_t _len, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            send_fnc       = SendAllFunctor<F>(_f);
+            send_file      = &_rfd;
+            send_file_off  = _off;
+            send_buf_cp    = _len;
+            send_buf_sz    = 0;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            SOLID_ASSERT(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendFile(ReactorContext& _rctx, FileDevice& _rfd, int64_t _off, size_t _len, F _f)
+    {
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_file     = &_rfd;
+            send_file_off = _off;
+            send_buf_cp   = _len;
+            send_buf_sz   = 0;
+
+            if (doTrySend(_rctx)) {
+                if (send_buf_sz == send_buf_cp) {
+                    doClearSendFile();
+                    return true;
+                }
+            }
+            send_fnc = SendAllFunctor<F>(_f);
+            return false;
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Zero copy read - moves the received data into the free space of the pipe
+    /*!
+        Linux only, on plain sockets - uses splice(2).
+        The pipe must stay valid until the completion and must not be full.
+        Forward the data with sendAll(PipeDevice&) on another stream.
+    */
+    template <typename F>
+    bool postRecvSome(ReactorContext& _rctx, PipeDevice& _rpd, F _f)
+    {
+        SOLID_ASSERT(!_rpd.full());
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            recv_fnc       = RecvSomeFunctor<F>(_f);
+            recv_pipe      = &_rpd;
+            recv_buf_cp    = _rpd.capacity() - _rpd.size();
+            recv_buf_sz    = 0;
+            recv_is_posted = true;
+            doPostRecvSome(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool recvSome(ReactorContext& _rctx, PipeDevice& _rpd, F _f, size_t& _sz)
+    {
+        SOLID_ASSERT(!_rpd.full());
+        if (SOLID_FUNCTION_EMPTY(recv_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            recv_pipe   = &_rpd;
+            recv_buf_cp = _rpd.capacity() - _rpd.size();
+            recv_buf_sz = 0;
+
+            if (doTryRecv(_rctx)) {
+                _sz = recv_buf_sz;
+                doClearRecvPipe();
+                return true;
+            } else {
+                recv_fnc = RecvSomeFunctor<F>(_f);
+                return false;
+            }
+
+        } else {
+            error(_rctx, error_already);
+        }
+        return true;
+    }
+
+    //! Zero copy write - completes when the pipe was drained into the socket
+    /*!
+        Linux only, on plain sockets - uses splice(2).
+        The pipe must stay valid until the completion and must not be empty.
+    */
+    template <typename F>
+    bool postSendAll(ReactorContext& _rctx, PipeDevice& _rpd, F _f)
+    {
+        SOLID_ASSERT(!_rpd.empty());
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            send_fnc       = SendAllFunctor<F>(_f);
+            send_pipe      = &_rpd;
+            send_buf_cp    = _rpd.size();
+            send_buf_sz    = 0;
+            send_is_posted = true;
+            doPostSendAll(_rctx);
+            errorClear(_rctx);
+            return false;
+        } else {
+            error(_rctx, error_already);
+            SOLID_ASSERT(false);
+            return true;
+        }
+    }
+
+    template <typename F>
+    bool sendAll(ReactorContext& _rctx, PipeDevice& _rpd, F _f)
+    {
+        SOLID_ASSERT(!_rpd.empty());
+        if (SOLID_FUNCTION_EMPTY(send_fnc)) {
+            errorClear(_rctx);
+            contextBind(_rctx);
+
+            send_pipe   = &_rpd;
+            send_buf_cp = _rpd.size();
+            send_buf_sz = 0;
+
             if (doTrySend(_rctx)) {
                 if (send_buf_sz == send_buf_cp) {
+                    doClearSendPipe();
                     return true;
                 }
             }
@@ -453,6 +760,23 @@ public:
         return true;
     }
 
+    //! Sends of at least _threshold bytes from plain buffers will use MSG_ZEROCOPY
+    /*!
+        Linux only, on plain sockets.
+        A send completes only after the kernel released the pages of the buffer,
+        which it reports through the socket error queue.
+        It pays off only for large buffers - the kernel documentation suggests more than 10KB.
+    */
+    ErrorCodeT enableZeroCopy(const size_t _threshold)
+    {
+        SOLID_ASSERT(_threshold != 0);
+        ErrorCodeT err = s.enableZeroCopy();
+        if (!err) {
+            zc_threshold = _threshold;
+        }
+        return err;
+    }
+
     template <typename F>
     bool connect(ReactorContext& _rctx, SocketAddressStub const& _rsas, F _f)
     {
@@ -649,13 +973,23 @@ private:
         bool       can_retry;
         ErrorCodeT err;
 
-        ssize_t rv = s.recv(_rctx, recv_buf, recv_buf_cp - recv_buf_sz, can_retry, err);
+        ssize_t rv;
+
+        if (recv_iov != nullptr) {
+            rv = s.recv(_rctx, recv_iov, recv_iov_cnt, can_retry, err);
+        } else if (recv_pipe != nullptr) {
+            rv = s.recv(_rctx, *recv_pipe, recv_buf_cp - recv_buf_sz, can_retry, err);
+        } else {
+            rv = s.recv(_rctx, recv_buf, recv_buf_cp - recv_buf_sz, can_retry, err);
+        }
 
         solid_dbg(logger, Verbose, "recv (" << (recv_buf_cp - recv_buf_sz) << ") = " << rv);
 
         if (rv > 0) {
             recv_buf_sz += rv;
-            recv_buf += rv;
+            if (recv_iov == nullptr && recv_pipe == nullptr) {
+                recv_buf += rv;
+            }
         } else if (rv == 0) {
             error(_rctx, error_stream_shutdown);
             recv_buf_sz = recv_buf_cp = 0;
@@ -676,15 +1010,37 @@ private:
     {
         bool       can_retry;
         ErrorCodeT err;
-        ssize_t    rv = s.send(_rctx, send_buf, send_buf_cp - send_buf_sz, can_retry, err);
+        ssize_t    rv;
+
+        if (send_iov != nullptr) {
+            rv = s.send(_rctx, send_iov, send_iov_cnt, can_retry, err);
+        } else if (send_file != nullptr) {
+            rv = s.sendFile(_rctx, *send_file, send_file_off, send_buf_cp - send_buf_sz, can_retry, err);
+        } else if (send_pipe != nullptr) {
+            rv = s.send(_rctx, *send_pipe, send_buf_cp - send_buf_sz, can_retry, err);
+        } else if (zc_threshold != 0 && (send_buf_cp - send_buf_sz) >= zc_threshold) {
+            bool zero_copy;
+            rv = s.sendZeroCopy(_rctx, send_buf, send_buf_cp - send_buf_sz, zero_copy, can_retry, err);
+            if (zero_copy) {
+                ++zc_send_count;
+            }
+        } else {
+            rv = s.send(_rctx, send_buf, send_buf_cp - send_buf_sz, can_retry, err);
+        }
 
         solid_dbg(logger, Verbose, "send (" << (send_buf_cp - send_buf_sz) << ") = " << rv << ' ' << can_retry);
 
         if (rv > 0) {
             send_buf_sz += rv;
-            send_buf += rv;
+            if (send_iov != nullptr) {
+                doAdvanceSendIov(rv);
+            } else if (send_file != nullptr) {
+                send_file_off += rv;
+            } else if (send_pipe == nullptr) {
+                send_buf += rv;
+            }
         } else if (rv == 0) {
-            error(_rctx, error_stream_shutdown);
+            error(_rctx, send_file != nullptr ? error_stream_file_end : error_stream_shutdown);
             send_buf_sz = send_buf_cp = 0;
         } else if (rv < 0) {
             if (can_retry) {
@@ -699,6 +1055,87 @@ private:
         return true;
     }
 
+    void doAdvanceSendIov(size_t _sz)
+    {
+        while (_sz != 0 && send_iov_cnt != 0) {
+            if (_sz >= send_iov->iov_len) {
+                _sz -= send_iov->iov_len;
+                ++send_iov;
+                --send_iov_cnt;
+            } else {
+                send_iov->iov_base = static_cast<char*>(send_iov->iov_base) + _sz;
+                send_iov->iov_len -= _sz;
+                _sz = 0;
+            }
+        }
+    }
+
+    static size_t iov_size(const IoVecT* _piov, const size_t _iovcnt)
+    {
+        size_t sz = 0;
+        for (size_t i = 0; i < _iovcnt; ++i) {
+            sz += _piov[i].iov_len;
+        }
+        return sz;
+    }
+
+    void doClearRecvIov()
+    {
+        recv_iov     = nullptr;
+        recv_iov_cnt = 0;
+    }
+
+    void doClearSendIov()
+    {
+        send_iov     = nullptr;
+        send_iov_cnt = 0;
+    }
+
+    void doClearSendFile()
+    {
+        send_file     = nullptr;
+        send_file_off = 0;
+    }
+
+    void doClearRecvPipe()
+    {
+        recv_pipe = nullptr;
+    }
+
+    void doClearSendPipe()
+    {
+        send_pipe = nullptr;
+    }
+
+    bool doIsZeroCopyPending(ReactorContext& _rctx) const
+    {
+        //on error the completion is not delayed - the kernel keeps the pages pinned anyway
+        return zc_send_count != zc_done_count && !_rctx.error();
+    }
+
+    //returns true if at least one notification was read
+    bool doRecvZeroCopyCompletions()
+    {
+        bool rv = false;
+
+        if (zc_threshold != 0) {
+            uint32_t   first;
+            uint32_t   last;
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    readcnt;
+
+            while ((readcnt = s.device().recvZeroCopyCompletion(first, last, can_retry, err)) >= 0) {
+                if (readcnt > 0) {
+                    zc_done_count += (last - first + 1);
+                    solid_dbg(logger, Verbose, "zero copy completion [" << first << ", " << last << "] " << zc_done_count << " of " << zc_send_count);
+                }
+                rv = true;
+            }
+        }
+        return rv;
+    }
+
     void doCheckConnect(ReactorContext& _rctx)
     {
         ErrorCodeT err = s.checkConnect(_rctx);
@@ -710,8 +1147,17 @@ private:
 
     void doError(ReactorContext& _rctx)
     {
+        const ErrorCodeT err = s.device().error();
+
+        if (!err && doRecvZeroCopyCompletions()) {
+            //the error queue only had zero copy notifications
+            doSend(_rctx);
+            doRecv(_rctx);
+            return;
+        }
+
         error(_rctx, error_stream_socket);
-        systemError(_rctx, s.device().error());
+        systemError(_rctx, err);
 
         if (!SOLID_FUNCTION_EMPTY(send_fnc)) {
             send_buf_sz = send_buf_cp = 0;
@@ -729,6 +1175,8 @@ private:
         SOLID_ASSERT(SOLID_FUNCTION_EMPTY(recv_fnc));
         recv_buf    = nullptr;
         recv_buf_sz = recv_buf_cp = 0;
+        doClearRecvIov();
+        doClearRecvPipe();
     }
 
     void doClearSend(ReactorContext& _rctx)
@@ -737,6 +1185,9 @@ private:
         SOLID_ASSERT(SOLID_FUNCTION_EMPTY(send_fnc));
         send_buf    = nullptr;
         send_buf_sz = send_buf_cp = 0;
+        doClearSendIov();
+        doClearSendFile();
+        doClearSendPipe();
     }
 
     void doClear(ReactorContext& _rctx)
@@ -754,14 +1205,26 @@ private:
     char*         recv_buf;
     size_t        recv_buf_sz;
     size_t        recv_buf_cp;
+    IoVecT*       recv_iov;
+    size_t        recv_iov_cnt;
+    PipeDevice*   recv_pipe;
     RecvFunctionT recv_fnc;
     bool          recv_is_posted;
 
     const char*   send_buf;
     size_t        send_buf_sz;
     size_t        send_buf_cp;
+    IoVecT*       send_iov;
+    size_t        send_iov_cnt;
+    FileDevice*   send_file;
+    int64_t       send_file_off;
+    PipeDevice*   send_pipe;
     SendFunctionT send_fnc;
     bool          send_is_posted;
+
+    size_t   zc_threshold;
+    uint32_t zc_send_count;
+    uint32_t zc_done_count;
 };
 
 } //namespace aio
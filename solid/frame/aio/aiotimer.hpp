@@ -58,6 +58,7 @@ public:
         ObjectProxy const& _robj)
         : CompletionHandler(_robj, SteadyTimer::on_init_completion)
         , storeidx(-1)
+        , expirynsec(0)
     {
     }
 
@@ -82,6 +83,41 @@ public:
     {
         f = std::move(_f);
         NanoTime steady_nt{time_point_clock_cast<std::chrono::steady_clock>(_rtp)};
+        expirynsec = nanoseconds(steady_nt);
+        this->addTimer(_rctx, steady_nt, storeidx);
+        return false;
+    }
+
+    //! Same as waitFor but the timer may fire up to _slack later
+    /*!
+        Meant for timers re-armed very often, like keepalive or inactivity
+        timers. The expiry is rounded up to a multiple of _slack, so the timers
+        with the same slack fire together, and a timer already expiring within
+        _slack after the new time is not moved in the timer store.
+    */
+    template <class Rep, class Period, class SlackRep, class SlackPeriod, typename F>
+    bool waitFor(ReactorContext& _rctx, std::chrono::duration<Rep, Period> const& _rd, std::chrono::duration<SlackRep, SlackPeriod> const& _rslack, F _f)
+    {
+        return waitUntil(_rctx, _rctx.steadyTime() + _rd, _rslack, _f);
+    }
+
+    template <class Clock, class Duration, class SlackRep, class SlackPeriod, typename F>
+    bool waitUntil(ReactorContext& _rctx, std::chrono::time_point<Clock, Duration> const& _rtp, std::chrono::duration<SlackRep, SlackPeriod> const& _rslack, F _f)
+    {
+        const uint64_t slacknsec = std::chrono::duration_cast<std::chrono::nanoseconds>(_rslack).count();
+        NanoTime       steady_nt{time_point_clock_cast<std::chrono::steady_clock>(_rtp)};
+        const uint64_t nsec = nanoseconds(steady_nt);
+
+        f = std::move(_f);
+
+        if (slacknsec == 0) {
+            expirynsec = nsec;
+        } else if (storeidx != InvalidIndex() && expirynsec >= nsec && expirynsec <= (nsec + slacknsec)) {
+            return false;
+        } else {
+            expirynsec = ((nsec + slacknsec - 1) / slacknsec) * slacknsec;
+            steady_nt  = NanoTime(std::chrono::nanoseconds(expirynsec));
+        }
         this->addTimer(_rctx, steady_nt, storeidx);
         return false;
     }
@@ -118,11 +154,17 @@ private:
         storeidx = InvalidIndex();
     }
 
+    static uint64_t nanoseconds(NanoTime const& _rnt)
+    {
+        return _rnt.durationCast<std::chrono::nanoseconds>().count();
+    }
+
 private:
     typedef SOLID_FUNCTION(void(ReactorContext&)) FunctionT;
 
     FunctionT f;
     size_t    storeidx;
+    uint64_t  expirynsec;
 };
 
 } //namespace aio
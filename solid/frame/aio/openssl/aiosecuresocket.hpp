@@ -86,6 +86,24 @@ public:
 
     ssize_t send(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
 
+    //the data is encrypted in OpenSSL buffers, so zero copy sends are not possible
+    ErrorCodeT enableZeroCopy();
+
+    ssize_t sendZeroCopy(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _rzero_copy, bool& _can_retry, ErrorCodeT& _rerr);
+
+    //OpenSSL has no scatter/gather I/O - only the first non empty buffer is used
+    ssize_t recv(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr);
+
+    ssize_t send(ReactorContext& _rctx, const IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr);
+
+    //the data must be encrypted so it is read in a SocketDevice::SendFileBufferCapacity stack buffer
+    ssize_t sendFile(ReactorContext& _rctx, FileDevice& _rfd, int64_t _off, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+
+    //splice cannot be used on encrypted streams - they fail with error_not_implemented
+    ssize_t recv(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+
+    ssize_t send(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr);
+
     NativeHandleT nativeHandle() const;
 
     ssize_t recvFrom(ReactorContext& _rctx, char* _pb, size_t _bl, SocketAddress& _addr, bool& _can_retry, ErrorCodeT& _rerr);
@@ -15,6 +15,7 @@
 #include "solid/system/cassert.hpp"
 #include "solid/system/error.hpp"
 #include "solid/system/exception.hpp"
+#include "solid/system/filedevice.hpp"
 #include "solid/system/log.hpp"
 #include <mutex>
 #include <thread>
@@ -830,6 +831,72 @@ bool Socket::secureShutdown(ReactorContext& _rctx, bool& _can_retry, ErrorCodeT&
     return false;
 }
 
+ErrorCodeT Socket::enableZeroCopy()
+{
+    return solid::error_not_implemented;
+}
+
+ssize_t Socket::sendZeroCopy(ReactorContext& _rctx, const char* _pb, size_t _bl, bool& _rzero_copy, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    _rzero_copy = false;
+    return send(_rctx, _pb, _bl, _can_retry, _rerr);
+}
+
+namespace {
+size_t first_not_empty(const IoVecT* _piov, const size_t _iovcnt)
+{
+    size_t i = 0;
+    while (i < (_iovcnt - 1) && _piov[i].iov_len == 0) {
+        ++i;
+    }
+    return i;
+}
+} //namespace
+
+ssize_t Socket::recv(ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_iovcnt != 0);
+    IoVecT& riov = _piov[first_not_empty(_piov, _iovcnt)];
+    return recv(_rctx, static_cast<char*>(riov.iov_base), riov.iov_len, _can_retry, _rerr);
+}
+
+ssize_t Socket::send(ReactorContext& _rctx, const IoVecT* _piov, size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_iovcnt != 0);
+    const IoVecT& riov = _piov[first_not_empty(_piov, _iovcnt)];
+    return send(_rctx, static_cast<const char*>(riov.iov_base), riov.iov_len, _can_retry, _rerr);
+}
+
+ssize_t Socket::sendFile(ReactorContext& _rctx, FileDevice& _rfd, int64_t _off, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    //SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER is set, so on retry the same data can be read again in a new buffer
+    char          buf[SocketDevice::SendFileBufferCapacity];
+    const ssize_t readsz = _rfd.read(buf, _bl < sizeof(buf) ? _bl : sizeof(buf), _off);
+
+    if (readsz <= 0) {
+        _can_retry = false;
+        if (readsz < 0) {
+            _rerr = last_system_error();
+        }
+        return readsz;
+    }
+    return send(_rctx, buf, readsz, _can_retry, _rerr);
+}
+
+ssize_t Socket::recv(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    _can_retry = false;
+    _rerr      = solid::error_not_implemented;
+    return -1;
+}
+
+ssize_t Socket::send(ReactorContext& _rctx, PipeDevice& _rpd, size_t _bl, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    _can_retry = false;
+    _rerr      = solid::error_not_implemented;
+    return -1;
+}
+
 ssize_t Socket::recvFrom(ReactorContext& _rctx, char* _pb, size_t _bl, SocketAddress& _addr, bool& _can_retry, ErrorCodeT& _rerr)
 {
     return -1;
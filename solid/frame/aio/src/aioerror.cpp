@@ -38,6 +38,7 @@ enum {
     ErrorSecureAcceptE,
     ErrorSecureConnectE,
     ErrorSecureShutdownE,
+    ErrorStreamFileEndE,
 };
 
 class ErrorCategory : public ErrorCategoryT {
@@ -92,6 +93,9 @@ std::string ErrorCategory::message(int _ev) const
     case ErrorStreamShutdownE:
         oss << "Stream: peer shutdown";
         break;
+    case ErrorStreamFileEndE:
+        oss << "Stream: file ended before the requested length";
+        break;
     case ErrorTimerCancelE:
         oss << "Timer: canceled";
         break;
@@ -144,6 +148,7 @@ std::string ErrorCategory::message(int _ev) const
 /*extern*/ const ErrorConditionT error_stream_system(ErrorStreamSystemE, category);
 /*extern*/ const ErrorConditionT error_stream_socket(ErrorStreamSocketE, category);
 /*extern*/ const ErrorConditionT error_stream_shutdown(ErrorStreamShutdownE, category);
+/*extern*/ const ErrorConditionT error_stream_file_end(ErrorStreamFileEndE, category);
 
 /*extern*/ const ErrorConditionT error_timer_cancel(ErrorTimerCancelE, category);
 
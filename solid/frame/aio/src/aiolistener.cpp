@@ -44,6 +44,8 @@ const LoggerT logger("solid::frame::aio");
             rthis.doAccept(_rctx, sd);
 
             tmpf(_rctx, sd);
+        } else if (!SOLID_FUNCTION_EMPTY(rthis.bf)) {
+            rthis.doCompleteAcceptBatch(_rctx);
         }
         break;
     case ReactorEventError:
@@ -56,6 +58,14 @@ const LoggerT logger("solid::frame::aio");
             rthis.error(_rctx, error_listener_hangup);
 
             tmpf(_rctx, sd);
+        } else if (!SOLID_FUNCTION_EMPTY(rthis.bf)) {
+            SocketDeviceVectorT sd_vec;
+            BatchFunctionT      tmpf;
+            std::swap(tmpf, rthis.bf);
+
+            rthis.error(_rctx, error_listener_hangup);
+
+            tmpf(_rctx, sd_vec);
         }
         break;
     case ReactorEventClear:
@@ -76,6 +86,8 @@ const LoggerT logger("solid::frame::aio");
         FunctionT tmpf;
         std::swap(tmpf, rthis.f);
         tmpf(_rctx, sd);
+    } else if (!SOLID_FUNCTION_EMPTY(rthis.bf)) {
+        rthis.doCompleteAcceptBatch(_rctx);
     }
 }
 
@@ -132,13 +144,85 @@ void Listener::doAccept(ReactorContext& _rctx, SocketDevice& _rsd)
     }
 }
 
+void Listener::doAcceptBatch(ReactorContext& _rctx, SocketDeviceVectorT& _rsd_vec)
+{
+    while (_rsd_vec.size() < batchmax) {
+        bool         can_retry;
+        SocketDevice sd;
+        ErrorCodeT   err = s.accept(_rctx, sd, can_retry);
+
+        if (!err) {
+            _rsd_vec.emplace_back(std::move(sd));
+        } else if (can_retry) {
+            break;
+        } else {
+            //the accepted sockets go first, the error comes back on the next call
+            if (_rsd_vec.empty()) {
+                systemError(_rctx, err);
+                error(_rctx, error_listener_system);
+            }
+            break;
+        }
+    }
+}
+
+//Keeps waiting when there is nothing to accept - the readiness event can be spurious
+void Listener::doCompleteAcceptBatch(ReactorContext& _rctx)
+{
+    SocketDeviceVectorT sd_vec;
+
+    doAcceptBatch(_rctx, sd_vec);
+
+    if (!sd_vec.empty() || _rctx.error()) {
+        BatchFunctionT tmpf;
+        std::swap(tmpf, bf);
+        tmpf(_rctx, sd_vec);
+    }
+}
+
 void Listener::doClear(ReactorContext& _rctx)
 {
     SOLID_FUNCTION_CLEAR(f);
+    SOLID_FUNCTION_CLEAR(bf);
     remDevice(_rctx, s.device());
     f = &on_dummy;
 }
 
+ErrorCodeT prepare_sharded_accept(
+    std::vector<SocketDevice>& _rsd_vec, const size_t _count, ResolveIterator const& _rai,
+    SocketAddress& _rlocal_address, const size_t _listencnt)
+{
+    ErrorCodeT err;
+
+    _rsd_vec.clear();
+    _rsd_vec.resize(_count);
+
+    for (size_t i = 0; i < _count && !err; ++i) {
+        SocketDevice& rsd = _rsd_vec[i];
+
+        err = rsd.create(_rai);
+        if (!err) {
+            err = rsd.enableReusePort();
+        }
+        if (err) {
+        } else if (i == 0) {
+            err = rsd.prepareAccept(_rai, _listencnt);
+            if (!err) {
+                err = rsd.localAddress(_rlocal_address);
+            }
+        } else {
+            //bind to the address of the first socket so that a zero port is only resolved once
+            err = rsd.prepareAccept(_rlocal_address, _listencnt);
+        }
+    }
+
+    if (err) {
+        solid_dbg(logger, Error, "preparing sharded listener sockets: " << err.message());
+        _rsd_vec.clear();
+    }
+    return err;
+}
+
 } //namespace aio
 } //namespace frame
 } //namespace solid
@@ -11,7 +11,17 @@
 
 #include "solid/system/common.hpp"
 
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+
+#include <csignal>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#elif defined(SOLID_USE_EPOLL)
 
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
@@ -27,9 +37,11 @@
 #include <WinSock2.h>
 #endif
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <deque>
+#include <memory>
 #include <queue>
 #include <vector>
 
@@ -42,13 +54,15 @@
 #include <thread>
 
 #include "solid/utility/event.hpp"
+#include "solid/utility/mpscqueue.hpp"
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
 
 #include "solid/frame/common.hpp"
 #include "solid/frame/object.hpp"
+#include "solid/frame/schedulerbase.hpp"
 #include "solid/frame/service.hpp"
-#include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
 
 #include "solid/frame/aio/aiocompletion.hpp"
 #include "solid/frame/aio/aioobject.hpp"
@@ -79,6 +93,41 @@ inline size_t voidToIndex(const void* _ptr)
 {
     return reinterpret_cast<size_t>(_ptr);
 }
+#elif defined(SOLID_USE_IO_URING)
+//the poll requests are identified by the completion handler index
+//and a generation counter, so that completions of already removed
+//poll requests can be recognized and skipped
+//the recv/send/accept requests are identified by their IoStub index,
+//marked with io_data_flag
+//the completions of the requests with skip_data are ignored - poll remove,
+//cancel and provide buffers
+constexpr uint64_t skip_data    = static_cast<uint64_t>(-1);
+constexpr uint64_t io_data_flag = static_cast<uint64_t>(1) << 63;
+
+inline uint64_t indexToPollData(const size_t _idx, const uint32_t _gen)
+{
+    return (static_cast<uint64_t>(_gen & 0x7fffffff) << 32) | static_cast<uint32_t>(_idx);
+}
+
+inline size_t pollDataToIndex(const uint64_t _data)
+{
+    return static_cast<size_t>(_data & 0xffffffff);
+}
+
+inline uint64_t indexToIoData(const size_t _idx)
+{
+    return io_data_flag | static_cast<uint64_t>(_idx);
+}
+
+inline bool isIoData(const uint64_t _data)
+{
+    return (_data & io_data_flag) != 0;
+}
+
+inline size_t ioDataToIndex(const uint64_t _data)
+{
+    return static_cast<size_t>(_data & ~io_data_flag);
+}
 #endif
 } //namespace
 
@@ -236,27 +285,50 @@ public:
 
 //=============================================================================
 
-struct NewTaskStub {
+//Node of the cross-thread inbox - see Reactor::push and Reactor::raise
+struct InboxStub {
+    enum TypeE {
+        NewTaskE,
+        RaiseEventE,
+        MigrateRequestE,
+        MigrateTaskE,
+    };
+
+    InboxStub(const TypeE _type)
+        : next(nullptr)
+        , type(_type)
+    {
+    }
+
+    InboxStub* next;
+    TypeE      type;
+};
+
+//=============================================================================
+
+struct NewTaskStub : InboxStub {
     NewTaskStub(
         UniqueId const& _ruid, TaskT const& _robjptr, Service& _rsvc, Event&& _revent)
-        : uid(_ruid)
+        : InboxStub(NewTaskE)
+        , uid(_ruid)
         , objptr(_robjptr)
         , rsvc(_rsvc)
         , event(std::move(_revent))
     {
     }
 
-    NewTaskStub(const NewTaskStub&) = delete;
-
     NewTaskStub(
-        NewTaskStub&& _unts)
-        : uid(_unts.uid)
-        , objptr(std::move(_unts.objptr))
-        , rsvc(_unts.rsvc)
-        , event(std::move(_unts.event))
+        UniqueId const& _ruid, TaskT const& _robjptr, Service& _rsvc, Event const& _revent)
+        : InboxStub(NewTaskE)
+        , uid(_ruid)
+        , objptr(_robjptr)
+        , rsvc(_rsvc)
+        , event(_revent)
     {
     }
 
+    NewTaskStub(const NewTaskStub&) = delete;
+
     UniqueId uid;
     TaskT    objptr;
     Service& rsvc;
@@ -265,33 +337,52 @@ struct NewTaskStub {
 
 //=============================================================================
 
-struct RaiseEventStub {
+struct RaiseEventStub : InboxStub {
     RaiseEventStub(
         UniqueId const& _ruid, Event&& _revent)
-        : uid(_ruid)
+        : InboxStub(RaiseEventE)
+        , uid(_ruid)
         , event(std::move(_revent))
     {
     }
 
     RaiseEventStub(
         UniqueId const& _ruid, Event const& _revent)
-        : uid(_ruid)
+        : InboxStub(RaiseEventE)
+        , uid(_ruid)
         , event(_revent)
     {
     }
 
     RaiseEventStub(const RaiseEventStub&) = delete;
-    RaiseEventStub(
-        RaiseEventStub&& _uevs)
-        : uid(_uevs.uid)
-        , event(std::move(_uevs.event))
+
+    UniqueId uid;
+    Event    event;
+};
+
+//=============================================================================
+
+//Asks the reactor to move an object - or, with an invalid uid,
+//its most active objects - to another reactor
+struct MigrateRequestStub : InboxStub {
+    MigrateRequestStub(
+        UniqueId const& _ruid, const size_t _count, const size_t _reactor_index)
+        : InboxStub(MigrateRequestE)
+        , uid(_ruid)
+        , count(_count)
+        , reactor_index(_reactor_index)
     {
     }
 
+    MigrateRequestStub(const MigrateRequestStub&) = delete;
+
     UniqueId uid;
-    Event    event;
+    size_t   count;
+    size_t   reactor_index;
 };
 
+using MigrateRequestVectorT = std::vector<MigrateRequestStub*>;
+
 //=============================================================================
 
 struct CompletionHandlerStub {
@@ -301,6 +392,7 @@ struct CompletionHandlerStub {
         : pch(_pch)
         , objidx(_objidx)
         , unique(0)
+        , timeridx(InvalidIndex())
 #if defined(SOLID_USE_WSAPOLL)
         , connectidx(InvalidIndex())
 #endif
@@ -310,8 +402,23 @@ struct CompletionHandlerStub {
     CompletionHandler* pch;
     size_t             objidx;
     UniqueT            unique;
+    size_t             timeridx; //the timer in timestore, if any
 #if defined(SOLID_USE_WSAPOLL)
     size_t connectidx;
+#elif defined(SOLID_USE_EPOLL)
+    //the device is kept so that it can be moved to another reactor
+    Device::DescriptorT desc      = Device::invalidDescriptor();
+    uint32_t            pollevs   = 0;
+    uint32_t            wantevs   = 0;     //the events to register before the next wait
+    bool                modqueued = false; //on Reactor::Data::modvec
+#if defined(SOLID_USE_IO_URING)
+    uint32_t pollgen = 0;
+    size_t   rdioidx = InvalidIndex(); //the recv or accept request, in Reactor::Data::iodq
+    size_t   wrioidx = InvalidIndex(); //the send request
+    bool     iohold  = false;          //no new requests - the object is about to move
+    bool     rdwake  = false;          //notify ReactorEventRecv once the hold is over
+    bool     wrwake  = false;          //notify ReactorEventSend once the hold is over
+#endif
 #endif
 };
 
@@ -321,19 +428,38 @@ struct ObjectStub {
     ObjectStub()
         : unique(0)
         , psvc(nullptr)
+        , activitycnt(0)
+        , fwdreactoridx(InvalidIndex())
+        , execloop(0)
+        , execcnt(0)
+        , execflagged(false)
     {
     }
 
     UniqueT  unique;
     Service* psvc;
     TaskT    objptr;
+    size_t   activitycnt;   //completions since the last migration
+    size_t   fwdreactoridx; //the object was moved to fwdreactoridx as fwduid
+    UniqueId fwduid;
+    size_t   execloop;    //the exec loop execcnt refers to
+    size_t   execcnt;     //posted completions run in execloop
+    bool     execflagged; //the object exceeded its exec share - reported once
 };
 
 //=============================================================================
 
 enum {
     MinEventCapacity = 32,
-    MaxEventCapacity = 1024 * 64
+    MaxEventCapacity = 1024 * 64,
+#if defined(SOLID_USE_IO_URING)
+    IoUringSubmitCapacity      = 256,
+    IoUringCompleteCapacity    = 1024 * 4,
+    IoUringRecvBufferCapacity  = 1024 * 16,
+    IoUringRecvBufferBatch     = 64, //the recv buffers are provided to the kernel in batches
+    IoUringRecvBufferMaxCount  = 1024 * 64, //the buffer ids have 16 bits
+    IoUringSendBufferCapacity  = 1024 * 64,
+#endif
 };
 
 //=============================================================================
@@ -382,12 +508,466 @@ struct ExecStub {
     Event                   event;
 };
 
+//=============================================================================
+#if defined(SOLID_USE_IO_URING)
+//=============================================================================
+//  IoStub - a completion based recv, send or accept request
+//=============================================================================
+/*
+    The kernel uses the request's buffers until it posts the completion,
+    which can come after the completion handler or even its object are gone.
+    So the data goes through buffers owned by the reactor:
+    - recv: the kernel picks a buffer from the ones provided to it, only when
+        the data arrives - the idle connections do not hold buffers. The data
+        is copied to the caller's buffers and the buffer is given back to the
+        kernel once all of it was consumed.
+    - send: the data is copied to a reactor buffer (buf) and reported as sent,
+        like a kernel socket buffer would do. The next send waits for the
+        completion of the previous one, which reports its error, if any.
+    - accept: the backlog is drained with accept(2) and the request is only
+        armed when it is empty.
+    A completion handler has at most one recv or accept (rdioidx) and one
+    send (wrioidx) request.
+    An object is moved to another reactor only when none of its requests is
+    in flight - a completed one moves with its completion handler and the
+    received data not consumed yet is moved from the provided buffer to buf.
+*/
+struct IoStub {
+    enum TypeE {
+        RecvE,
+        SendE,
+        AcceptE,
+    };
+
+    void clear()
+    {
+        chidx     = InvalidIndex();
+        desc      = Device::invalidDescriptor();
+        done      = false;
+        res       = 0;
+        bufid     = -1;
+        offset    = 0;
+        size      = 0;
+        cancelled = false;
+        buf.reset();
+    }
+
+    TypeE                   type      = RecvE;
+    size_t                  chidx     = InvalidIndex(); //InvalidIndex when the completion handler is gone
+    Device::DescriptorT     desc      = Device::invalidDescriptor();
+    bool                    done      = false; //the completion was received
+    bool                    cancelled = false; //cancelled to move the object
+    int                     res       = 0;
+    int                     bufid     = -1; //recv: the provided buffer holding the data, if any
+    size_t                  offset    = 0;  //recv: the consumed bytes, send: the sent bytes
+    size_t                  size      = 0;  //recv: the requested bytes, send: the bytes in buf
+    std::unique_ptr<char[]> buf;            //send: the data, recv: the moved data - see above
+};
+
+using IoDequeT      = std::deque<IoStub>;
+using BufferVectorT = std::vector<std::unique_ptr<char[]>>;
+
+#endif
 //=============================================================================
 
-typedef std::vector<NewTaskStub>    NewTaskVectorT;
-typedef std::vector<RaiseEventStub> RaiseEventVectorT;
+//A completion handler in transit between reactors
+struct MigrateHandlerStub {
+    MigrateHandlerStub(
+        CompletionHandler* _pch, const size_t _chidx, const UniqueT _unique)
+        : pch(_pch)
+        , chidx(_chidx)
+        , unique(_unique)
+        , hastimer(false)
+#if defined(SOLID_USE_EPOLL)
+        , desc(Device::invalidDescriptor())
+        , pollevs(0)
+#endif
+    {
+    }
 
+    CompletionHandler* pch;
+    size_t             chidx; //index within the source reactor
+    UniqueT            unique;
+    bool               hastimer;
+    NanoTime           timertime;
 #if defined(SOLID_USE_EPOLL)
+    Device::DescriptorT desc;
+    uint32_t            pollevs;
+#endif
+#if defined(SOLID_USE_IO_URING)
+    IoStub rdio; //the completed recv or accept request, if done
+    IoStub wrio; //the failed send request, if done
+    bool   rdwake = false;
+    bool   wrwake = false;
+#endif
+};
+
+using MigrateHandlerVectorT = std::vector<MigrateHandlerStub>;
+using ExecVectorT           = std::vector<ExecStub>;
+
+//An object in transit between reactors - see Reactor::doMigrateObject.
+//Without an object it only releases the target reactor
+struct MigrateTaskStub : InboxStub {
+    MigrateTaskStub()
+        : InboxStub(MigrateTaskE)
+        , psvc(nullptr)
+    {
+    }
+
+    MigrateTaskStub(const MigrateTaskStub&) = delete;
+
+    UniqueId              uid;
+    TaskT                 objptr;
+    Service*              psvc;
+    MigrateHandlerVectorT chvec;
+    ExecVectorT           exevec;
+};
+
+//=============================================================================
+
+typedef MpscQueue<InboxStub> InboxQueueT;
+
+#if defined(SOLID_USE_IO_URING)
+
+typedef std::vector<io_uring_cqe> EventVectorT;
+
+//=============================================================================
+//  IoUring - the submission/completion rings
+//=============================================================================
+/*
+    Instead of calling epoll_ctl for every add/modify/remove device request,
+    the reactor queues multishot poll requests on the submission ring.
+    The plain socket recv/send and the accept calls are queued as completion
+    based requests - see IoStub.
+    All queued requests are submitted and the completions are waited for
+    with a single io_uring_enter call per reactor loop.
+*/
+class IoUring {
+public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring()
+    {
+        close();
+    }
+
+    bool init(const unsigned _sqcp, const unsigned _cqcp);
+    void close();
+
+    void pollAdd(const Device::DescriptorT _desc, const uint32_t _events, const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_POLL_ADD;
+        rsqe.fd            = _desc;
+        rsqe.poll32_events = _events;
+        rsqe.len           = IORING_POLL_ADD_MULTI;
+        rsqe.user_data     = _data;
+    }
+
+    void pollRemove(const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_POLL_REMOVE;
+        rsqe.fd            = -1;
+        rsqe.addr          = _data;
+        rsqe.user_data     = skip_data;
+    }
+
+    //the kernel picks the buffer from _bufgroup when the data arrives
+    void recv(const Device::DescriptorT _desc, const size_t _len, const uint16_t _bufgroup, const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_RECV;
+        rsqe.fd            = _desc;
+        rsqe.len           = static_cast<uint32_t>(_len);
+        rsqe.flags         = IOSQE_BUFFER_SELECT;
+        rsqe.buf_group     = _bufgroup;
+        rsqe.user_data     = _data;
+    }
+
+    void send(const Device::DescriptorT _desc, const char* _pb, const size_t _len, const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_SEND;
+        rsqe.fd            = _desc;
+        rsqe.addr          = reinterpret_cast<uint64_t>(_pb);
+        rsqe.len           = static_cast<uint32_t>(_len);
+        rsqe.msg_flags     = MSG_NOSIGNAL | MSG_WAITALL;
+        rsqe.user_data     = _data;
+    }
+
+    void accept(const Device::DescriptorT _desc, const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_ACCEPT;
+        rsqe.fd            = _desc;
+        rsqe.user_data     = _data;
+    }
+
+    void cancel(const uint64_t _data)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_ASYNC_CANCEL;
+        rsqe.fd            = -1;
+        rsqe.addr          = _data;
+        rsqe.user_data     = skip_data;
+    }
+
+    //_count buffers of _bufcp bytes starting at _pb, with ids starting from _bufid
+    void provideBuffers(char* _pb, const size_t _bufcp, const size_t _count, const uint16_t _bufgroup, const uint16_t _bufid)
+    {
+        io_uring_sqe& rsqe = sqe();
+        rsqe.opcode        = IORING_OP_PROVIDE_BUFFERS;
+        rsqe.fd            = static_cast<int>(_count);
+        rsqe.addr          = reinterpret_cast<uint64_t>(_pb);
+        rsqe.len           = static_cast<uint32_t>(_bufcp);
+        rsqe.off           = _bufid;
+        rsqe.buf_group     = _bufgroup;
+        rsqe.user_data     = skip_data;
+    }
+
+    //submit the queued requests without waiting
+    void submit();
+
+    //submit queued requests and wait for completions
+    //_waitnsec: -1 waits forever, 0 does not wait
+    int wait(const int64_t _waitnsec);
+
+    size_t reap(EventVectorT& _revec);
+
+private:
+    io_uring_sqe& sqe();
+    int           enter(const unsigned _tosubmit, const unsigned _mincomplete, unsigned _flags, const int64_t _waitnsec);
+
+private:
+    int           fd_ = -1;
+    void*         sq_ptr_ = nullptr;
+    size_t        sq_sz_ = 0;
+    void*         cq_ptr_ = nullptr;
+    size_t        cq_sz_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t        sqes_sz_ = 0;
+    unsigned*     sq_head_ = nullptr;
+    unsigned*     sq_tail_ = nullptr;
+    unsigned*     sq_flags_ = nullptr;
+    unsigned*     sq_array_ = nullptr;
+    unsigned      sq_mask_ = 0;
+    unsigned      sq_entries_ = 0;
+    unsigned      sq_local_tail_ = 0;
+    unsigned*     cq_head_ = nullptr;
+    unsigned*     cq_tail_ = nullptr;
+    unsigned      cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+//-----------------------------------------------------------------------------
+
+bool IoUring::init(const unsigned _sqcp, const unsigned _cqcp)
+{
+    io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+
+    params.flags      = IORING_SETUP_CQSIZE;
+    params.cq_entries = _cqcp;
+
+    fd_ = static_cast<int>(syscall(__NR_io_uring_setup, _sqcp, &params));
+
+    if (fd_ < 0) {
+        solid_dbg(logger, Error, "io_uring_setup: " << last_system_error().message());
+        return false;
+    }
+
+    if ((params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_NODROP) == 0) {
+        solid_dbg(logger, Error, "io_uring: kernel features not supported: " << params.features);
+        return false;
+    }
+
+    sq_sz_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_sz_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sq_sz_ = cq_sz_ = std::max(sq_sz_, cq_sz_);
+    }
+
+    sq_ptr_ = mmap(nullptr, sq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+
+    if (sq_ptr_ == MAP_FAILED) {
+        sq_ptr_ = nullptr;
+        solid_dbg(logger, Error, "io_uring mmap sq: " << last_system_error().message());
+        return false;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cq_ptr_ = sq_ptr_;
+    } else {
+        cq_ptr_ = mmap(nullptr, cq_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            cq_ptr_ = nullptr;
+            solid_dbg(logger, Error, "io_uring mmap cq: " << last_system_error().message());
+            return false;
+        }
+    }
+
+    sqes_sz_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_    = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_sz_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+
+    if (sqes_ == MAP_FAILED) {
+        sqes_ = nullptr;
+        solid_dbg(logger, Error, "io_uring mmap sqes: " << last_system_error().message());
+        return false;
+    }
+
+    char* psq = static_cast<char*>(sq_ptr_);
+    char* pcq = static_cast<char*>(cq_ptr_);
+
+    sq_head_       = reinterpret_cast<unsigned*>(psq + params.sq_off.head);
+    sq_tail_       = reinterpret_cast<unsigned*>(psq + params.sq_off.tail);
+    sq_flags_      = reinterpret_cast<unsigned*>(psq + params.sq_off.flags);
+    sq_array_      = reinterpret_cast<unsigned*>(psq + params.sq_off.array);
+    sq_mask_       = *reinterpret_cast<unsigned*>(psq + params.sq_off.ring_mask);
+    sq_entries_    = *reinterpret_cast<unsigned*>(psq + params.sq_off.ring_entries);
+    sq_local_tail_ = *sq_tail_;
+
+    cq_head_ = reinterpret_cast<unsigned*>(pcq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(pcq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(pcq + params.cq_off.ring_mask);
+    cqes_    = reinterpret_cast<io_uring_cqe*>(pcq + params.cq_off.cqes);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void IoUring::close()
+{
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqes_sz_);
+        sqes_ = nullptr;
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+        munmap(cq_ptr_, cq_sz_);
+    }
+    cq_ptr_ = nullptr;
+    if (sq_ptr_ != nullptr) {
+        munmap(sq_ptr_, sq_sz_);
+        sq_ptr_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+io_uring_sqe& IoUring::sqe()
+{
+    if ((sq_local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) >= sq_entries_) {
+        //the submission ring is full - submit without waiting
+        const unsigned tosubmit = sq_local_tail_ - *sq_tail_;
+        __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+        if (enter(tosubmit, 0, 0, 0) < 0) {
+            solid_dbg(logger, Error, "io_uring_enter: " << last_system_error().message());
+            SOLID_THROW("io_uring_enter");
+        }
+    }
+
+    const unsigned idx = sq_local_tail_ & sq_mask_;
+    io_uring_sqe&  rv  = sqes_[idx];
+
+    sq_array_[idx] = idx;
+    memset(&rv, 0, sizeof(rv));
+    ++sq_local_tail_;
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+int IoUring::enter(const unsigned _tosubmit, const unsigned _mincomplete, unsigned _flags, const int64_t _waitnsec)
+{
+    io_uring_getevents_arg arg;
+    __kernel_timespec      ts;
+
+    memset(&arg, 0, sizeof(arg));
+
+    if (_flags & IORING_ENTER_GETEVENTS) {
+        _flags |= IORING_ENTER_EXT_ARG;
+        arg.sigmask_sz = _NSIG / 8;
+        if (_waitnsec >= 0) {
+            ts.tv_sec  = _waitnsec / 1000000000;
+            ts.tv_nsec = _waitnsec % 1000000000;
+            arg.ts     = reinterpret_cast<uint64_t>(&ts);
+        }
+    }
+
+    const int rv = static_cast<int>(syscall(__NR_io_uring_enter, fd_, _tosubmit, _mincomplete, _flags, (_flags & IORING_ENTER_EXT_ARG) ? &arg : nullptr, sizeof(arg)));
+
+    if (rv < 0 && (errno == ETIME || errno == EINTR)) {
+        return 0;
+    }
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+void IoUring::submit()
+{
+    const unsigned tosubmit = sq_local_tail_ - *sq_tail_;
+
+    if (tosubmit != 0) {
+        __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+        if (enter(tosubmit, 0, 0, 0) < 0) {
+            solid_dbg(logger, Error, "io_uring_enter: " << last_system_error().message());
+            SOLID_THROW("io_uring_enter");
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+int IoUring::wait(const int64_t _waitnsec)
+{
+    const unsigned tosubmit = sq_local_tail_ - *sq_tail_;
+    unsigned       flags    = 0;
+    unsigned       mincmpl  = 0;
+
+    __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+
+    if (_waitnsec != 0) {
+        flags   = IORING_ENTER_GETEVENTS;
+        mincmpl = 1;
+    } else if (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) {
+        //flush the completions kept by the kernel on completion ring overflow
+        flags = IORING_ENTER_GETEVENTS;
+    }
+
+    if (tosubmit == 0 && flags == 0) {
+        return 0;
+    }
+    return enter(tosubmit, mincmpl, flags, _waitnsec);
+}
+
+//-----------------------------------------------------------------------------
+
+size_t IoUring::reap(EventVectorT& _revec)
+{
+    unsigned       head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    size_t         sz   = 0;
+
+    while (head != tail && sz < _revec.size()) {
+        _revec[sz] = cqes_[head & cq_mask_];
+        ++sz;
+        ++head;
+    }
+
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    return sz;
+}
+
+#elif defined(SOLID_USE_EPOLL)
 
 typedef std::vector<epoll_event> EventVectorT;
 
@@ -416,8 +996,9 @@ using UidVectorT              = std::vector<UniqueId>;
 using ObjectDequeT            = std::deque<ObjectStub>;
 using ExecQueueT              = Queue<ExecStub>;
 using SizeStackT              = Stack<size_t>;
-using TimeStoreT              = TimeStore<size_t>;
+using TimeStoreT              = TimeWheel<size_t>;
 using SizeTVectorT            = std::vector<size_t>;
+using MicrosecondsT           = std::chrono::microseconds;
 
 //=============================================================================
 //  Reactor::Data
@@ -428,17 +1009,54 @@ struct Reactor::Data {
         )
         : reactor_fd(-1)
         , running(0)
-        , crtpushtskvecidx(0)
-        , crtraisevecidx(0)
-        , crtpushvecsz(0)
-        , crtraisevecsz(0)
         , devcnt(0)
         , objcnt(0)
         , timestore(MinEventCapacity)
+        , execloop(0)
+#if defined(SOLID_USE_EPOLL_PWAIT2) && !defined(SOLID_USE_IO_URING)
+        , has_epoll_pwait2(true)
+#endif
+    {
+    }
+
+    ~Data()
+    {
+        InboxStub* pstub = inboxq.pop();
+        while (pstub != nullptr) {
+            InboxStub* pnext = pstub->next;
+            deleteInboxStub(pstub);
+            pstub = pnext;
+        }
+        for (MigrateRequestStub* preq : migratevec) {
+            delete preq;
+        }
+#if defined(SOLID_USE_IO_URING)
+        for (MigrateRequestStub* preq : migratependvec) {
+            delete preq;
+        }
+#endif
+    }
+
+    static void deleteInboxStub(InboxStub* _pstub)
     {
+        switch (_pstub->type) {
+        case InboxStub::NewTaskE:
+            delete static_cast<NewTaskStub*>(_pstub);
+            break;
+        case InboxStub::RaiseEventE:
+            delete static_cast<RaiseEventStub*>(_pstub);
+            break;
+        case InboxStub::MigrateRequestE:
+            delete static_cast<MigrateRequestStub*>(_pstub);
+            break;
+        case InboxStub::MigrateTaskE:
+            delete static_cast<MigrateTaskStub*>(_pstub);
+            break;
+        }
     }
 #if defined(SOLID_USE_EPOLL)
-    int computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
+    //-1 waits for ever, 0 does not wait
+    int64_t computeWaitTimeNanoseconds(NanoTime const& _rcrt) const
     {
 
         if (exeq.size()) {
@@ -447,16 +1065,16 @@ struct Reactor::Data {
 
             if (_rcrt < timestore.next()) {
 
-                const int64_t maxwait = 1000 * 60 * 10; //ten minutes
+                const int64_t maxwait = 1000LL * 1000 * 1000 * 60 * 10; //ten minutes
                 int64_t       diff    = 0;
                 const auto    crt_tp  = _rcrt.timePointCast<std::chrono::steady_clock::time_point>();
                 const auto    next_tp = timestore.next().timePointCast<std::chrono::steady_clock::time_point>();
-                diff                  = std::chrono::duration_cast<std::chrono::milliseconds>(next_tp - crt_tp).count();
+                diff                  = std::chrono::duration_cast<std::chrono::nanoseconds>(next_tp - crt_tp).count();
 
                 if (diff > maxwait) {
                     return maxwait;
                 } else {
-                    return static_cast<int>(diff);
+                    return diff;
                 }
 
             } else {
@@ -467,6 +1085,86 @@ struct Reactor::Data {
             return -1;
         }
     }
+
+    int pollWait(const int64_t _waitnsec)
+    {
+#if defined(SOLID_USE_IO_URING)
+        int rv = ring.wait(_waitnsec);
+        if (rv >= 0) {
+            rv = static_cast<int>(ring.reap(eventvec));
+        }
+        return rv;
+#else
+#if defined(SOLID_USE_EPOLL_PWAIT2)
+        if (has_epoll_pwait2) {
+            timespec ts;
+
+            ts.tv_sec  = _waitnsec / 1000000000;
+            ts.tv_nsec = _waitnsec % 1000000000;
+
+            const int rv = epoll_pwait2(reactor_fd, eventvec.data(), static_cast<int>(eventvec.size()), _waitnsec >= 0 ? &ts : nullptr, nullptr);
+
+            if (rv >= 0 || errno != ENOSYS) {
+                return rv;
+            }
+            //built with a glibc newer than the kernel (before 5.11)
+            has_epoll_pwait2 = false;
+        }
+#endif
+        //round up - a timer must not be polled for until it expires
+        const int waitmsec = _waitnsec > 0 ? static_cast<int>((_waitnsec + 999999) / 1000000) : static_cast<int>(_waitnsec);
+        return epoll_wait(reactor_fd, eventvec.data(), static_cast<int>(eventvec.size()), waitmsec);
+#endif
+    }
+
+    //Poll without blocking for up to spinwindow, then block for what is left of _waitnsec.
+    //The window grows when the reactor is woken within spin_max after blocking
+    //and shrinks when it sleeps longer.
+    int busyPollWait(const int64_t _waitnsec, bool& _rspin_hit)
+    {
+        using namespace std::chrono;
+
+        const auto start_tp = steady_clock::now();
+        auto       end_tp   = start_tp + spinwindow;
+        int        rv;
+
+        if (_waitnsec > 0 && (start_tp + nanoseconds(_waitnsec)) < end_tp) {
+            end_tp = start_tp + nanoseconds(_waitnsec);
+        }
+
+        do {
+            rv = pollWait(0);
+            if (rv != 0 || !inboxq.empty()) {
+                _rspin_hit = true;
+                return rv;
+            }
+        } while (steady_clock::now() < end_tp);
+
+        _rspin_hit = false;
+
+        const auto block_tp = steady_clock::now();
+        int64_t    waitnsec = _waitnsec;
+
+        if (waitnsec > 0) {
+            const int64_t spentnsec = duration_cast<nanoseconds>(block_tp - start_tp).count();
+            waitnsec                = spentnsec < waitnsec ? (waitnsec - spentnsec) : 0;
+        }
+
+        rv = pollWait(waitnsec);
+
+        if (rv > 0 && (steady_clock::now() - block_tp) <= busypollcfg.spin_max) {
+            spinwindow *= 2;
+            if (spinwindow > busypollcfg.spin_max) {
+                spinwindow = busypollcfg.spin_max;
+            }
+        } else {
+            spinwindow /= 2;
+            if (spinwindow < busypollcfg.spin_min) {
+                spinwindow = busypollcfg.spin_min;
+            }
+        }
+        return rv;
+    }
 #elif defined(SOLID_USE_KQUEUE)
     NanoTime computeWaitTimeMilliseconds(NanoTime const& _rcrt) const
     {
@@ -530,28 +1228,535 @@ struct Reactor::Data {
         const size_t idx = eventobj.dummyhandler.idxreactor;
         return UniqueId(idx, chdq[idx].unique);
     }
+#if defined(SOLID_USE_IO_URING)
+    size_t ioAllocate()
+    {
+        size_t idx;
+
+        if (iocache.size()) {
+            idx = iocache.top();
+            iocache.pop();
+        } else {
+            idx = iodq.size();
+            iodq.emplace_back();
+        }
+        return idx;
+    }
+
+    size_t ioCreate(const IoStub::TypeE _type, const size_t _chidx, const Device::DescriptorT _desc)
+    {
+        const size_t idx = ioAllocate();
+        IoStub&      rio = iodq[idx];
+
+        rio.type  = _type;
+        rio.chidx = _chidx;
+        rio.desc  = _desc;
+        ++iocount;
+        return idx;
+    }
+
+    void ioRelease(const size_t _idx)
+    {
+        IoStub& rio = iodq[_idx];
+
+        if (rio.bufid >= 0) {
+            ioReturnRecvBuffer(rio.bufid);
+        }
+        if (rio.type == IoStub::AcceptE && rio.done && rio.res >= 0) {
+            //accepted for a gone completion handler
+            ::close(rio.res);
+        }
+        if (rio.type == IoStub::SendE && rio.buf) {
+            sendbufcache.emplace_back(std::move(rio.buf));
+        }
+        rio.clear();
+        iocache.push(_idx);
+    }
+
+    char* recvBuffer(const int _bufid)
+    {
+        return recvbufvec[_bufid / IoUringRecvBufferBatch].get() + (_bufid % IoUringRecvBufferBatch) * IoUringRecvBufferCapacity;
+    }
+
+    bool ioGrowRecvBuffers()
+    {
+        const size_t count = recvbufvec.size() * IoUringRecvBufferBatch;
+
+        if (count >= IoUringRecvBufferMaxCount) {
+            return false;
+        }
+
+        recvbufvec.emplace_back(new char[IoUringRecvBufferCapacity * IoUringRecvBufferBatch]);
+        ring.provideBuffers(recvbufvec.back().get(), IoUringRecvBufferCapacity, IoUringRecvBufferBatch, 0, static_cast<uint16_t>(count));
+        return true;
+    }
+
+    void ioReturnRecvBuffer(const int _bufid)
+    {
+        ring.provideBuffers(recvBuffer(_bufid), IoUringRecvBufferCapacity, 1, 0, static_cast<uint16_t>(_bufid));
+    }
+
+    ssize_t ioRecv(const size_t _chidx, const Device::DescriptorT _desc, IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        CompletionHandlerStub& rch = chdq[_chidx];
+
+        _can_retry = true;
+
+        if (rch.rdioidx == InvalidIndex()) {
+            if (rch.iohold) {
+                rch.rdwake = true;
+                return -1;
+            }
+
+            size_t len = 0;
+
+            for (size_t i = 0; i < _iovcnt; ++i) {
+                len += _piov[i].iov_len;
+            }
+
+            if (recvbufvec.empty()) {
+                ioGrowRecvBuffers();
+            }
+
+            rch.rdioidx = ioCreate(IoStub::RecvE, _chidx, _desc);
+
+            IoStub& rio = iodq[rch.rdioidx];
+
+            rio.size = len < IoUringRecvBufferCapacity ? len : IoUringRecvBufferCapacity;
+            ring.recv(_desc, rio.size, 0, indexToIoData(rch.rdioidx));
+            return -1;
+        }
+
+        IoStub& rio = iodq[rch.rdioidx];
+
+        SOLID_ASSERT(rio.type == IoStub::RecvE);
+
+        if (!rio.done) {
+            return -1;
+        }
+
+        ssize_t rv = -1;
+
+        _can_retry = false;
+
+        if (rio.res > 0) {
+            const char* pb   = (rio.bufid >= 0 ? recvBuffer(rio.bufid) : rio.buf.get()) + rio.offset;
+            size_t      left = static_cast<size_t>(rio.res) - rio.offset;
+
+            rv = 0;
+            for (size_t i = 0; i < _iovcnt && left != 0; ++i) {
+                const size_t sz = _piov[i].iov_len < left ? _piov[i].iov_len : left;
+
+                memcpy(_piov[i].iov_base, pb, sz);
+                pb += sz;
+                left -= sz;
+                rv += sz;
+            }
+            rio.offset += rv;
+
+            if (left != 0) {
+                return rv; //the rest goes to the next call
+            }
+        } else if (rio.res == 0) {
+            rv = 0;
+        } else {
+            _rerr = ErrorCodeT(-rio.res, std::system_category());
+        }
+
+        ioRelease(rch.rdioidx);
+        rch.rdioidx = InvalidIndex();
+        return rv;
+    }
+
+    ssize_t ioSend(const size_t _chidx, const Device::DescriptorT _desc, const IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+    {
+        CompletionHandlerStub& rch = chdq[_chidx];
+
+        if (rch.wrioidx != InvalidIndex()) {
+            IoStub& rio = iodq[rch.wrioidx];
+
+            SOLID_ASSERT(rio.type == IoStub::SendE);
+
+            if (!rio.done) {
+                _can_retry = true;
+                return -1;
+            }
+            //only the failed sends wait to be reported
+            _can_retry = false;
+            _rerr      = ErrorCodeT(-rio.res, std::system_category());
+
+            ioRelease(rch.wrioidx);
+            rch.wrioidx = InvalidIndex();
+            return -1;
+        }
+
+        if (rch.iohold) {
+            rch.wrwake = true;
+            _can_retry = true;
+            return -1;
+        }
+
+        const size_t idx = ioCreate(IoStub::SendE, _chidx, _desc);
+        IoStub&      rio = iodq[idx];
+
+        if (sendbufcache.empty()) {
+            rio.buf.reset(new char[IoUringSendBufferCapacity]);
+        } else {
+            rio.buf = std::move(sendbufcache.back());
+            sendbufcache.pop_back();
+        }
+
+        for (size_t i = 0; i < _iovcnt && rio.size < IoUringSendBufferCapacity; ++i) {
+            const size_t left = IoUringSendBufferCapacity - rio.size;
+            const size_t sz   = _piov[i].iov_len < left ? _piov[i].iov_len : left;
+
+            memcpy(rio.buf.get() + rio.size, _piov[i].iov_base, sz);
+            rio.size += sz;
+        }
+
+        rch.wrioidx = idx;
+        ring.send(_desc, rio.buf.get(), rio.size, indexToIoData(idx));
+
+        _can_retry = false;
+        return static_cast<ssize_t>(rio.size);
+    }
+
+    ErrorCodeT ioAccept(const size_t _chidx, const Device::DescriptorT _desc, SocketDevice& _rsd, bool& _can_retry)
+    {
+        CompletionHandlerStub& rch = chdq[_chidx];
+
+        _can_retry = true;
+
+        if (rch.rdioidx == InvalidIndex()) {
+            if (rch.iohold) {
+                rch.rdwake = true;
+                return ErrorCodeT(EAGAIN, std::system_category());
+            }
+            //drain the backlog first, so a batch accept gets more than one socket
+            //per completion - the request is only armed to wait for the next one
+            const int rv = ::accept(_desc, nullptr, nullptr);
+
+            if (rv >= 0) {
+                _can_retry = false;
+                _rsd       = SocketDevice(rv);
+                return ErrorCodeT();
+            } else if (!is_accept_retry_error(errno) && errno != EWOULDBLOCK) {
+                _can_retry = false;
+                return ErrorCodeT(errno, std::system_category());
+            }
+
+            rch.rdioidx = ioCreate(IoStub::AcceptE, _chidx, _desc);
+            ring.accept(_desc, indexToIoData(rch.rdioidx));
+            return ErrorCodeT(EAGAIN, std::system_category());
+        }
+
+        IoStub& rio = iodq[rch.rdioidx];
+
+        SOLID_ASSERT(rio.type == IoStub::AcceptE);
+
+        if (!rio.done) {
+            return ErrorCodeT(EAGAIN, std::system_category());
+        }
+
+        ErrorCodeT err;
+
+        _can_retry = false;
+
+        if (rio.res >= 0) {
+            _rsd     = SocketDevice(rio.res);
+            rio.done = false; //the socket was taken
+        } else {
+            err = ErrorCodeT(-rio.res, std::system_category());
+        }
+
+        ioRelease(rch.rdioidx);
+        rch.rdioidx = InvalidIndex();
+        return err;
+    }
+
+    static bool is_accept_retry_error(const int _err)
+    {
+        return _err == EAGAIN || _err == ENETDOWN || _err == EPROTO || _err == ENOPROTOOPT || _err == EHOSTDOWN || _err == ENONET || _err == EHOSTUNREACH || _err == EOPNOTSUPP || _err == ENETUNREACH || _err == ECONNABORTED;
+    }
+
+    //Returns the completion handler to notify with _revent, if any
+    size_t ioComplete(io_uring_cqe const& _rcqe, ReactorEventsE& _revent)
+    {
+        const size_t idx  = ioDataToIndex(_rcqe.user_data);
+        IoStub&      rio  = iodq[idx];
+        const bool   live = rio.chidx != InvalidIndex();
+
+        if (_rcqe.res == -ECANCELED && live) {
+            //cancelled to move the object - see ioHold
+            CompletionHandlerStub& rch = chdq[rio.chidx];
+
+            rch.rdioidx = InvalidIndex();
+            rch.rdwake  = true;
+            --iocount;
+            ioRelease(idx);
+            return InvalidIndex();
+        }
+
+        switch (rio.type) {
+        case IoStub::RecvE:
+            if ((_rcqe.flags & IORING_CQE_F_BUFFER) != 0) {
+                rio.bufid = static_cast<int>(_rcqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            } else if (_rcqe.res == -ENOBUFS && live && ioGrowRecvBuffers()) {
+                ring.recv(rio.desc, rio.size, 0, _rcqe.user_data);
+                return InvalidIndex();
+            }
+            _revent = ReactorEventRecv;
+            break;
+        case IoStub::SendE:
+            if (_rcqe.res > 0) {
+                rio.offset += _rcqe.res;
+
+                if (rio.offset < rio.size && live) {
+                    ring.send(rio.desc, rio.buf.get() + rio.offset, rio.size - rio.offset, _rcqe.user_data);
+                    return InvalidIndex();
+                }
+            }
+            _revent = ReactorEventSend;
+            break;
+        case IoStub::AcceptE:
+            if (_rcqe.res < 0 && live && is_accept_retry_error(-_rcqe.res)) {
+                ring.accept(rio.desc, _rcqe.user_data);
+                return InvalidIndex();
+            }
+            _revent = ReactorEventRecv;
+            break;
+        }
+
+        rio.done = true;
+        rio.res  = _rcqe.res;
+        --iocount;
+
+        if (!live) {
+            ioRelease(idx);
+            return InvalidIndex();
+        }
+
+        const size_t chidx = rio.chidx;
+
+        if (rio.type == IoStub::SendE && rio.res >= 0) {
+            ioRelease(idx);
+            chdq[chidx].wrioidx = InvalidIndex();
+        }
+        return chidx;
+    }
+
+    //The completion handler's device is being removed - the completed
+    //requests are released and the others are left to finish on their own
+    void ioDetach(const size_t _chidx)
+    {
+        CompletionHandlerStub& rch      = chdq[_chidx];
+        bool                   inflight = false;
+
+        rch.iohold = false;
+        rch.rdwake = false;
+        rch.wrwake = false;
+
+        if (rch.rdioidx != InvalidIndex()) {
+            IoStub& rio = iodq[rch.rdioidx];
+
+            if (rio.done) {
+                ioRelease(rch.rdioidx);
+            } else {
+                rio.chidx = InvalidIndex();
+                ring.cancel(indexToIoData(rch.rdioidx));
+                inflight = true;
+            }
+            rch.rdioidx = InvalidIndex();
+        }
+
+        if (rch.wrioidx != InvalidIndex()) {
+            IoStub& rio = iodq[rch.wrioidx];
+
+            if (rio.done) {
+                ioRelease(rch.wrioidx);
+            } else {
+                //the data was reported as sent - let it go
+                rio.chidx = InvalidIndex();
+                inflight  = true;
+            }
+            rch.wrioidx = InvalidIndex();
+        }
+
+        if (inflight) {
+            //the requests must reach the kernel before the descriptor is closed and maybe reused
+            ring.submit();
+        }
+    }
+
+    //Holds the new requests of the object's completion handlers and cancels
+    //the recv and accept ones in flight.
+    //Returns true if none is in flight - the object can be moved
+    bool ioHold(CompletionHandler* _pch)
+    {
+        bool rv = true;
+
+        for (; _pch != nullptr; _pch = _pch->pnext) {
+            if (!_pch->isActive()) {
+                continue;
+            }
+            CompletionHandlerStub& rch = chdq[_pch->idxreactor];
+
+            rch.iohold = true;
+
+            if (rch.rdioidx != InvalidIndex() && !iodq[rch.rdioidx].done) {
+                IoStub& rio = iodq[rch.rdioidx];
+
+                if (!rio.cancelled) {
+                    rio.cancelled = true;
+                    ring.cancel(indexToIoData(rch.rdioidx));
+                }
+                rv = false;
+            }
+            if (rch.wrioidx != InvalidIndex()) {
+                //a completed send is only kept if it failed
+                rv = rv && iodq[rch.wrioidx].done;
+            }
+        }
+        return rv;
+    }
+
+    void ioMoveOut(const size_t _chidx, MigrateHandlerStub& _rmh)
+    {
+        CompletionHandlerStub& rch = chdq[_chidx];
+
+        if (rch.rdioidx != InvalidIndex()) {
+            IoStub& rio = iodq[rch.rdioidx];
+
+            SOLID_ASSERT(rio.done);
+
+            if (rio.bufid >= 0) {
+                //the provided buffers belong to this reactor's ring
+                const size_t sz = static_cast<size_t>(rio.res) - rio.offset;
+
+                rio.buf.reset(new char[sz]);
+                memcpy(rio.buf.get(), recvBuffer(rio.bufid) + rio.offset, sz);
+                ioReturnRecvBuffer(rio.bufid);
+
+                rio.bufid  = -1;
+                rio.res    = static_cast<int>(sz);
+                rio.offset = 0;
+            }
+            _rmh.rdio = std::move(rio);
+            rio.clear();
+            iocache.push(rch.rdioidx);
+            rch.rdioidx = InvalidIndex();
+        }
+
+        if (rch.wrioidx != InvalidIndex()) {
+            IoStub& rio = iodq[rch.wrioidx];
+
+            _rmh.wrio = std::move(rio);
+            rio.clear();
+            iocache.push(rch.wrioidx);
+            rch.wrioidx = InvalidIndex();
+        }
+
+        //the completion handler is notified by the target reactor
+        _rmh.rdwake = rch.rdwake || _rmh.rdio.done;
+        _rmh.wrwake = rch.wrwake || _rmh.wrio.done;
+        rch.iohold  = false;
+        rch.rdwake  = false;
+        rch.wrwake  = false;
+    }
+
+    void ioMoveIn(const size_t _chidx, MigrateHandlerStub& _rmh)
+    {
+        CompletionHandlerStub& rch = chdq[_chidx];
+
+        if (_rmh.rdio.done) {
+            rch.rdioidx = ioAllocate();
+
+            IoStub& rio = iodq[rch.rdioidx];
+
+            rio       = std::move(_rmh.rdio);
+            rio.chidx = _chidx;
+            rio.desc  = rch.desc;
+        }
+
+        if (_rmh.wrio.done) {
+            rch.wrioidx = ioAllocate();
+
+            IoStub& rio = iodq[rch.wrioidx];
+
+            rio       = std::move(_rmh.wrio);
+            rio.chidx = _chidx;
+            rio.desc  = rch.desc;
+        }
+        rch.rdwake = _rmh.rdwake;
+        rch.wrwake = _rmh.wrwake;
+    }
+
+    //Called on exit - cancels the requests in flight and waits a while for their completion
+    void ioDrain()
+    {
+        for (size_t i = 0; i < iodq.size(); ++i) {
+            if (iodq[i].desc != Device::invalidDescriptor() && !iodq[i].done) {
+                iodq[i].chidx = InvalidIndex();
+                ring.cancel(indexToIoData(i));
+            }
+        }
+
+        for (size_t i = 0; i < 10 && iocount != 0; ++i) {
+            const int rv = ring.wait(1000LL * 1000 * 100);
+
+            if (rv < 0) {
+                break;
+            }
+
+            const size_t sz = ring.reap(eventvec);
+
+            for (size_t j = 0; j < sz; ++j) {
+                ReactorEventsE revent;
+
+                if (eventvec[j].user_data != skip_data && isIoData(eventvec[j].user_data)) {
+                    ioComplete(eventvec[j], revent);
+                }
+            }
+        }
+    }
+#endif
 
     int                     reactor_fd;
     AtomicBoolT             running;
-    size_t                  crtpushtskvecidx;
-    size_t                  crtraisevecidx;
-    AtomicSizeT             crtpushvecsz;
-    AtomicSizeT             crtraisevecsz;
     size_t                  devcnt;
     size_t                  objcnt;
     TimeStoreT              timestore;
-    mutex                   mtx;
+    mutex                   mtx; //guards the uid stack
     EventVectorT            eventvec;
-    NewTaskVectorT          pushtskvec[2];
-    RaiseEventVectorT       raisevec[2];
+    InboxQueueT             inboxq;
+    BusyPollConfiguration   busypollcfg;
+    MicrosecondsT           spinwindow;
+    ExecBudgetConfiguration execbudgetcfg;
+    size_t                  execloop;
     EventObject             eventobj;
     CompletionHandlerDequeT chdq;
     UidVectorT              freeuidvec;
     ObjectDequeT            objdq;
     ExecQueueT              exeq;
+    ExecQueueT              exedeferq; //calls of the objects over their exec share
     SizeStackT              chposcache;
+    MigrateRequestVectorT   migratevec;
+    UidVectorT              fwduidvec; //slots of the moved objects
 #if defined(SOLID_USE_WSAPOLL)
     SizeTVectorT connectvec;
+#elif defined(SOLID_USE_EPOLL)
+    SizeTVectorT modvec; //completion handlers with pending poll events changes
+#if defined(SOLID_USE_IO_URING)
+    IoDequeT              iodq;
+    SizeStackT            iocache;
+    size_t                iocount = 0; //the requests in flight
+    BufferVectorT         recvbufvec;  //IoUringRecvBufferBatch buffers each
+    BufferVectorT         sendbufcache;
+    MigrateRequestVectorT migratependvec; //retried once the object's requests complete
+    IoUring               ring;           //closed before the buffers are released
+#elif defined(SOLID_USE_EPOLL_PWAIT2)
+    bool has_epoll_pwait2;
+#endif
 #endif
 };
 //-----------------------------------------------------------------------------
@@ -608,7 +1813,11 @@ bool Reactor::start()
 
     doStoreSpecific();
 
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+    if (!impl_->ring.init(IoUringSubmitCapacity, IoUringCompleteCapacity)) {
+        return false;
+    }
+#elif defined(SOLID_USE_EPOLL)
     impl_->reactor_fd = epoll_create(MinEventCapacity);
     if (impl_->reactor_fd < 0) {
         solid_dbg(logger, Error, "reactor create: " << last_system_error().message());
@@ -637,6 +1846,11 @@ bool Reactor::start()
     impl_->eventvec.resize(impl_->eventvec.capacity());
     impl_->running = true;
 
+    impl_->busypollcfg   = busyPollConfiguration();
+    impl_->spinwindow    = impl_->busypollcfg.spin_min;
+    impl_->execbudgetcfg = execBudgetConfiguration();
+    timecompletions      = timeCompletionsConfiguration();
+
     return true;
 }
 
@@ -645,16 +1859,9 @@ bool Reactor::start()
 /*virtual*/ bool Reactor::raise(UniqueId const& _robjuid, Event&& _uevent)
 {
     solid_dbg(logger, Verbose, (void*)this << " uid = " << _robjuid.index << ',' << _robjuid.unique << " event = " << _uevent);
-    bool   rv         = true;
-    size_t raisevecsz = 0;
-    {
-        lock_guard<std::mutex> lock(impl_->mtx);
+    bool rv = true;
 
-        impl_->raisevec[impl_->crtraisevecidx].emplace_back(_robjuid, std::move(_uevent));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
-        impl_->crtraisevecsz = raisevecsz;
-    }
-    if (raisevecsz == 1) {
+    if (impl_->inboxq.push(new RaiseEventStub(_robjuid, std::move(_uevent)))) {
         impl_->eventobj.eventhandler.write(*this);
     }
     return rv;
@@ -665,16 +1872,9 @@ bool Reactor::start()
 /*virtual*/ bool Reactor::raise(UniqueId const& _robjuid, const Event& _revent)
 {
     solid_dbg(logger, Verbose, (void*)this << " uid = " << _robjuid.index << ',' << _robjuid.unique << " event = " << _revent);
-    bool   rv         = true;
-    size_t raisevecsz = 0;
-    {
-        lock_guard<std::mutex> lock(impl_->mtx);
+    bool rv = true;
 
-        impl_->raisevec[impl_->crtraisevecidx].push_back(RaiseEventStub(_robjuid, _revent));
-        raisevecsz           = impl_->raisevec[impl_->crtraisevecidx].size();
-        impl_->crtraisevecsz = raisevecsz;
-    }
-    if (raisevecsz == 1) {
+    if (impl_->inboxq.push(new RaiseEventStub(_robjuid, _revent))) {
         impl_->eventobj.eventhandler.write(*this);
     }
     return rv;
@@ -695,23 +1895,58 @@ bool Reactor::start()
 bool Reactor::push(TaskT& _robj, Service& _rsvc, Event&& _uevent)
 {
     solid_dbg(logger, Verbose, (void*)this);
-    bool   rv        = true;
-    size_t pushvecsz = 0;
+    bool     rv = true;
+    UniqueId uid;
     {
         lock_guard<std::mutex> lock(impl_->mtx);
-        const UniqueId         uid = this->popUid(*_robj);
+        uid = this->popUid(*_robj);
+    }
 
-        solid_dbg(logger, Verbose, (void*)this << " uid = " << uid.index << ',' << uid.unique << " event = " << _uevent);
+    solid_dbg(logger, Verbose, (void*)this << " uid = " << uid.index << ',' << uid.unique << " event = " << _uevent);
 
-        impl_->pushtskvec[impl_->crtpushtskvecidx].push_back(NewTaskStub(uid, _robj, _rsvc, std::move(_uevent)));
-        pushvecsz           = impl_->pushtskvec[impl_->crtpushtskvecidx].size();
-        impl_->crtpushvecsz = pushvecsz;
+    //only the producer finding the inbox empty wakes the reactor
+    if (impl_->inboxq.push(new NewTaskStub(uid, _robj, _rsvc, std::move(_uevent)))) {
+        impl_->eventobj.eventhandler.write(*this);
     }
+    return rv;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Reactor::push(TaskT* const* _ptasks, const size_t _count, Service& _rsvc, Event const& _revent)
+{
+    solid_dbg(logger, Verbose, (void*)this << " count = " << _count << " event = " << _revent);
 
-    if (pushvecsz == 1) {
+    if (_count == 0) {
+        return true;
+    }
+
+    NewTaskStub* pnewest = nullptr;
+    NewTaskStub* poldest = nullptr;
+
+    //allocate outside the lock, chained newest first like in the inbox
+    for (size_t i = 0; i < _count; ++i) {
+        NewTaskStub* pstub = new NewTaskStub(UniqueId(), *_ptasks[i], _rsvc, _revent);
+
+        pstub->next = pnewest;
+        pnewest     = pstub;
+        if (poldest == nullptr) {
+            poldest = pstub;
+        }
+    }
+    {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        for (InboxStub* pstub = pnewest; pstub != nullptr; pstub = pstub->next) {
+            NewTaskStub& rstub = *static_cast<NewTaskStub*>(pstub);
+            rstub.uid          = this->popUid(*rstub.objptr);
+        }
+    }
+
+    if (impl_->inboxq.push(pnewest, poldest)) {
         impl_->eventobj.eventhandler.write(*this);
     }
-    return rv;
+    return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -735,18 +1970,33 @@ void Reactor::run()
     bool     running = true;
     NanoTime crttime;
     int      waitmsec;
+    int64_t  waitnsec;
     NanoTime waittime;
+    auto     wake_tp = std::chrono::steady_clock::now();
 
     while (running) {
-        crttime = std::chrono::steady_clock::now();
+        const auto busy_end_tp = std::chrono::steady_clock::now();
+
+        addCount(statcnt.iteration_count, 1);
+        addCount(statcnt.busy_nsec, static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(busy_end_tp - wake_tp).count()));
 
+        crttime = busy_end_tp;
         crtload = impl_->objcnt + impl_->devcnt + impl_->exeq.size();
 #if defined(SOLID_USE_EPOLL)
-        waitmsec = impl_->computeWaitTimeMilliseconds(crttime);
+        if (!impl_->modvec.empty()) {
+            doUpdatePollEvents();
+        }
+        waitnsec = impl_->computeWaitTimeNanoseconds(crttime);
 
-        solid_dbg(logger, Verbose, "epoll_wait msec = " << waitmsec);
+        solid_dbg(logger, Verbose, "wait nsec = " << waitnsec);
 
-        selcnt = epoll_wait(impl_->reactor_fd, impl_->eventvec.data(), static_cast<int>(impl_->eventvec.size()), waitmsec);
+        if (waitnsec != 0 && impl_->busypollcfg.enabled()) {
+            bool spin_hit;
+            selcnt = impl_->busyPollWait(waitnsec, spin_hit);
+            addCount(spin_hit ? statcnt.spin_hit_count : statcnt.spin_miss_count, 1);
+        } else {
+            selcnt = impl_->pollWait(waitnsec);
+        }
 #elif defined(SOLID_USE_KQUEUE)
         waittime = impl_->computeWaitTimeMilliseconds(crttime);
 
@@ -758,7 +2008,10 @@ void Reactor::run()
         solid_dbg(logger, Verbose, "wsapoll wait msec = " << waitmsec);
         selcnt = WSAPoll(impl_->eventvec.data(), impl_->eventvec.size(), waitmsec);
 #endif
-        crttime = std::chrono::steady_clock::now();
+        wake_tp = std::chrono::steady_clock::now();
+        crttime = wake_tp;
+
+        addCount(statcnt.wait_nsec, static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wake_tp - busy_end_tp).count()));
 
 #if defined(SOLID_USE_WSAPOLL)
         if (selcnt > 0 || impl_->connectvec.size()) {
@@ -766,6 +2019,9 @@ void Reactor::run()
         if (selcnt > 0) {
 #endif
             crtload += selcnt;
+            addCount(statcnt.wakeup_count, 1);
+            addCount(statcnt.event_count, selcnt);
+            maxCount(statcnt.event_max, selcnt);
             doCompleteIo(crttime, selcnt);
         } else if (selcnt < 0 && errno != EINTR) {
             solid_dbg(logger, Error, "epoll_wait errno  = " << last_system_error().message());
@@ -781,13 +2037,24 @@ void Reactor::run()
         doCompleteEvents(crttime); //See NOTE above
         doCompleteExec(crttime);
 
-        running = impl_->running || (impl_->objcnt != 0) || !impl_->exeq.empty();
+        if (!impl_->migratevec.empty()) {
+            doCompleteMigrate(crttime);
+        }
+
+        statcnt.timer_count.store(impl_->timestore.size(), std::memory_order_relaxed);
+
+        //incomingcnt keeps the reactor alive for the objects moved onto it
+        running = impl_->running || (impl_->objcnt != 0) || !impl_->exeq.empty() || incomingcnt.load() != 0;
     }
 
     impl_->eventobj.stop();
+#if defined(SOLID_USE_IO_URING)
+    impl_->ioDrain();
+#endif
     doClearSpecific();
     solid_dbg(logger, Info, "<exit>");
     (void)waitmsec;
+    (void)waitnsec;
     (void)waittime;
 } // namespace aio
 
@@ -817,6 +2084,7 @@ inline ReactorEventsE systemEventsToReactorEvents(const uint32_t _events)
         retval = ReactorEventError;
         break;
     case EPOLLHUP:
+    case EPOLLHUP | EPOLLERR:
     case EPOLLHUP | EPOLLOUT:
     case EPOLLHUP | EPOLLIN:
     case EPOLLHUP | EPOLLERR | EPOLLIN | EPOLLOUT:
@@ -895,7 +2163,30 @@ inline ReactorEventsE systemEventsToReactorEvents(const uint32_t _events, declty
 #endif
 
 //-----------------------------------------------------------------------------
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+//NOTE: multishot poll requests are triggered by device wakeups
+//so we do not need EPOLLET here
+inline uint32_t reactorRequestsToSystemEvents(const ReactorWaitRequestsE _requests)
+{
+    uint32_t evs = 0;
+    switch (_requests) {
+    case ReactorWaitNone:
+        break;
+    case ReactorWaitRead:
+        evs = EPOLLIN;
+        break;
+    case ReactorWaitWrite:
+        evs = EPOLLOUT;
+        break;
+    case ReactorWaitReadOrWrite:
+        evs = EPOLLIN | EPOLLOUT;
+        break;
+    default:
+        SOLID_ASSERT(false);
+    }
+    return evs;
+}
+#elif defined(SOLID_USE_EPOLL)
 inline uint32_t reactorRequestsToSystemEvents(const ReactorWaitRequestsE _requests)
 {
     uint32_t evs = 0;
@@ -1043,7 +2334,47 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
 
     solid_dbg(logger, Verbose, "selcnt = " << _sz);
 
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+    for (size_t i = 0; i < _sz; ++i) {
+        io_uring_cqe& rev = impl_->eventvec[i];
+        size_t        chidx;
+
+        if (rev.user_data == skip_data) {
+            continue;
+        } else if (isIoData(rev.user_data)) {
+            //a recv, send or accept request - see IoStub
+            chidx = impl_->ioComplete(rev, ctx.reactor_event_);
+
+            if (chidx == InvalidIndex()) {
+                continue;
+            }
+        } else {
+            chidx = pollDataToIndex(rev.user_data);
+
+            CompletionHandlerStub& rch = impl_->chdq[chidx];
+
+            if (indexToPollData(chidx, rch.pollgen) != rev.user_data || rev.res == -ECANCELED) {
+                continue; //completion for an already removed/modified device
+            }
+
+            if ((rev.flags & IORING_CQE_F_MORE) == 0 && rev.res >= 0 && rch.desc != Device::invalidDescriptor()) {
+                //the kernel has terminated the multishot poll request - rearm it
+                impl_->ring.pollAdd(rch.desc, rch.pollevs, rev.user_data);
+            }
+
+            if (rev.res < 0) {
+                ctx.reactor_event_ = ReactorEventError;
+            } else if ((rev.res & (EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0) {
+                ctx.reactor_event_ = systemEventsToReactorEvents(rev.res & (EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP | EPOLLRDHUP));
+            } else {
+                continue;
+            }
+        }
+
+        CompletionHandlerStub& rch = impl_->chdq[chidx];
+
+        ctx.channel_index_ = chidx;
+#elif defined(SOLID_USE_EPOLL)
     for (size_t i = 0; i < _sz; ++i) {
         epoll_event&           rev = impl_->eventvec[i];
         CompletionHandlerStub& rch = impl_->chdq[rev.data.u64];
@@ -1078,212 +2409,716 @@ void Reactor::doCompleteIo(NanoTime const& _rcrttime, const size_t _sz)
         }
 #endif
         ctx.object_index_ = rch.objidx;
+        ++impl_->objdq[rch.objidx].activitycnt;
+
+        complete([&rch, &ctx]() { rch.pch->handleCompletion(ctx); });
+        ctx.clearError();
+    }
+#if defined(SOLID_USE_WSAPOLL)
+    for (size_t j = 0; j < impl_->connectvec.size();) {
+        const size_t           i   = impl_->connectvec[j];
+        WSAPOLLFD&             rev = impl_->eventvec[i];
+        CompletionHandlerStub& rch = impl_->chdq[i];
+
+        if (SocketDevice::error(rev.fd)) {
+
+            ctx.reactor_event_ = systemEventsToReactorEvents(POLLERR, rev.events);
+            ctx.channel_index_ = i;
+            ctx.object_index_  = rch.objidx;
+
+            remConnect(ctx);
+
+            rch.pch->handleCompletion(ctx);
+            ctx.clearError();
+        } else {
+            ++j;
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+#if defined(SOLID_USE_WSAPOLL)
+void Reactor::addConnect(ReactorContext& _rctx)
+{
+    CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
+    rch.connectidx             = impl_->connectvec.size();
+    impl_->connectvec.emplace_back(_rctx.channel_index_);
+}
+
+void Reactor::remConnect(ReactorContext& _rctx)
+{
+    CompletionHandlerStub& rch                       = impl_->chdq[_rctx.channel_index_];
+    impl_->connectvec[rch.connectidx]                = impl_->connectvec.back();
+    impl_->chdq[impl_->connectvec.back()].connectidx = rch.connectidx;
+    rch.connectidx                                   = InvalidIndex();
+    impl_->connectvec.pop_back();
+}
+#endif
+//-----------------------------------------------------------------------------
+
+struct ChangeTimerIndexCallback {
+    Reactor& r;
+    ChangeTimerIndexCallback(Reactor& _r)
+        : r(_r)
+    {
+    }
+
+    void operator()(const size_t _chidx, const size_t _newidx, const size_t _oldidx) const
+    {
+        r.doUpdateTimerIndex(_chidx, _newidx, _oldidx);
+    }
+};
+
+struct TimerCallback {
+    Reactor&        r;
+    ReactorContext& rctx;
+    TimerCallback(Reactor& _r, ReactorContext& _rctx)
+        : r(_r)
+        , rctx(_rctx)
+    {
+    }
+
+    void operator()(const size_t _tidx, const size_t _chidx) const
+    {
+        r.onTimer(rctx, _tidx, _chidx);
+    }
+};
+
+void Reactor::onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx)
+{
+    CompletionHandlerStub& rch = impl_->chdq[_chidx];
+
+    rch.timeridx = InvalidIndex(); //popped from timestore
+
+    _rctx.reactor_event_ = ReactorEventTimer;
+    _rctx.channel_index_ = _chidx;
+    _rctx.object_index_  = rch.objidx;
+    ++impl_->objdq[rch.objidx].activitycnt;
+    addCount(statcnt.timer_fired_count, 1);
+
+    complete([&rch, &_rctx]() { rch.pch->handleCompletion(_rctx); });
+    _rctx.clearError();
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doCompleteTimer(NanoTime const& _rcrttime)
+{
+    ReactorContext ctx(*this, _rcrttime);
+    TimerCallback  tcbk(*this, ctx);
+    impl_->timestore.pop(_rcrttime, tcbk, ChangeTimerIndexCallback(*this));
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doCompleteExec(NanoTime const& _rcrttime)
+{
+    ReactorContext ctx(*this, _rcrttime);
+    size_t         sz = impl_->exeq.size();
+
+    maxCount(statcnt.exec_queue_max, sz);
+
+    if (impl_->execbudgetcfg.enabled()) {
+        doCompleteExecBudget(ctx, sz);
+        return;
+    }
+
+    while (sz--) {
+
+        solid_dbg(logger, Verbose, sz << " qsz = " << impl_->exeq.size());
+
+        ExecStub&              rexe(impl_->exeq.front());
+        ObjectStub&            ros(impl_->objdq[static_cast<size_t>(rexe.objuid.index)]);
+        CompletionHandlerStub& rcs(impl_->chdq[static_cast<size_t>(rexe.chnuid.index)]);
+
+        if (ros.unique == rexe.objuid.unique && rcs.unique == rexe.chnuid.unique) {
+            ctx.clearError();
+            ctx.channel_index_ = static_cast<size_t>(rexe.chnuid.index);
+            ctx.object_index_  = static_cast<size_t>(rexe.objuid.index);
+            ++ros.activitycnt;
+            complete([&rexe, &ctx]() { rexe.exefnc(ctx, std::move(rexe.event)); });
+        }
+        impl_->exeq.pop();
+    }
+}
+
+//-----------------------------------------------------------------------------
+/*
+    Same as above but stops after execbudgetcfg.max_count calls or after
+    execbudgetcfg.max_time. The calls of an object past its
+    execbudgetcfg.object_max_count share are set aside and put back in
+    front of the queue, so the calls of every object keep their order.
+*/
+void Reactor::doCompleteExecBudget(ReactorContext& _rctx, size_t _sz)
+{
+    ExecBudgetConfiguration const& rcfg     = impl_->execbudgetcfg;
+    const auto                     start_tp = std::chrono::steady_clock::now();
+    const size_t                   loop     = ++impl_->execloop;
+    size_t                         execcnt  = 0;
+
+    while (_sz) {
+        if (
+            (rcfg.max_count != 0 && execcnt >= rcfg.max_count) || (rcfg.max_time.count() != 0 && execcnt != 0 && (std::chrono::steady_clock::now() - start_tp) >= rcfg.max_time)) {
+            break;
+        }
+        --_sz;
+
+        ExecStub&              rexe(impl_->exeq.front());
+        ObjectStub&            ros(impl_->objdq[static_cast<size_t>(rexe.objuid.index)]);
+        CompletionHandlerStub& rcs(impl_->chdq[static_cast<size_t>(rexe.chnuid.index)]);
+
+        if (ros.unique == rexe.objuid.unique && rcs.unique == rexe.chnuid.unique) {
+            if (ros.execloop != loop) {
+                ros.execloop = loop;
+                ros.execcnt  = 0;
+            }
+
+            if (rcfg.object_max_count != 0 && ros.execcnt >= rcfg.object_max_count) {
+                if (!ros.execflagged) {
+                    ros.execflagged = true;
+                    solid_log(logger, Warning, "object " << rexe.objuid << " exceeded its exec share of " << rcfg.object_max_count << " calls per loop");
+                }
+                addCount(statcnt.exec_over_share_count, 1);
+                impl_->exedeferq.push(std::move(rexe));
+                impl_->exeq.pop();
+                continue;
+            }
+
+            ++ros.execcnt;
+            ++execcnt;
+            _rctx.clearError();
+            _rctx.channel_index_ = static_cast<size_t>(rexe.chnuid.index);
+            _rctx.object_index_  = static_cast<size_t>(rexe.objuid.index);
+            ++ros.activitycnt;
+            complete([&rexe, &_rctx]() { rexe.exefnc(_rctx, std::move(rexe.event)); });
+        }
+        impl_->exeq.pop();
+    }
+
+    addCount(statcnt.exec_deferred_count, _sz + impl_->exedeferq.size());
+
+    if (!impl_->exedeferq.empty()) {
+        while (!impl_->exeq.empty()) {
+            impl_->exedeferq.push(std::move(impl_->exeq.front()));
+            impl_->exeq.pop();
+        }
+        std::swap(impl_->exeq, impl_->exedeferq);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doCompleteEvents(NanoTime const& _rcrttime)
+{
+    ReactorContext ctx(*this, _rcrttime);
+    doCompleteEvents(ctx);
+}
+
+//-----------------------------------------------------------------------------
+
+void Reactor::doCompleteEvents(ReactorContext const& _rctx)
+{
+    solid_dbg(logger, Verbose, "");
+
+    if (!impl_->freeuidvec.empty()) {
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        for (auto it = impl_->freeuidvec.begin(); it != impl_->freeuidvec.end(); ++it) {
+            this->pushUid(*it);
+        }
+        impl_->freeuidvec.clear();
+    }
+
+    if (!impl_->inboxq.empty()) {
+        //new tasks and raised events share the inbox so that an event
+        //raised right after a push is never seen before the object
+        InboxStub*     pstub = impl_->inboxq.pop();
+        ReactorContext ctx(_rctx);
+        size_t         cnt   = 0;
+
+        solid_dbg(logger, Verbose, impl_->exeq.size());
+
+        while (pstub != nullptr) {
+            InboxStub* pnext = pstub->next;
+
+            switch (pstub->type) {
+            case InboxStub::NewTaskE: {
+                NewTaskStub& rnewobj(*static_cast<NewTaskStub*>(pstub));
+
+                ++impl_->objcnt;
+
+                if (rnewobj.uid.index >= impl_->objdq.size()) {
+                    impl_->objdq.resize(static_cast<size_t>(rnewobj.uid.index + 1));
+                }
+                ObjectStub& ros = impl_->objdq[static_cast<size_t>(rnewobj.uid.index)];
+
+                SOLID_ASSERT(ros.unique == rnewobj.uid.unique);
+
+                {
+                    //NOTE: we must lock the mutex of the object
+                    //in order to ensure that object is fully registered onto the manager
+
+                    lock_guard<std::mutex> lock(rnewobj.rsvc.mutex(*rnewobj.objptr));
+                }
+
+                ros.objptr      = std::move(rnewobj.objptr);
+                ros.psvc        = &rnewobj.rsvc;
+                ros.execflagged = false;
+
+                ctx.clearError();
+                ctx.channel_index_ = InvalidIndex();
+                ctx.object_index_  = static_cast<size_t>(rnewobj.uid.index);
+
+                ros.objptr->registerCompletionHandlers();
+
+                impl_->exeq.push(ExecStub(rnewobj.uid, &call_object_on_event, impl_->dummyCompletionHandlerUid(), std::move(rnewobj.event)));
+            } break;
+            case InboxStub::RaiseEventE: {
+                RaiseEventStub& revent(*static_cast<RaiseEventStub*>(pstub));
+                ObjectStub&     ros = impl_->objdq[static_cast<size_t>(revent.uid.index)];
+
+                if (ros.fwdreactoridx != InvalidIndex() && ros.unique == revent.uid.unique) {
+                    //raised before the object was moved to another reactor
+                    raiseOnReactor(ros.fwdreactoridx, ros.fwduid, std::move(revent.event));
+                } else {
+                    impl_->exeq.push(ExecStub(revent.uid, &call_object_on_event, impl_->dummyCompletionHandlerUid(), std::move(revent.event)));
+                }
+            } break;
+            case InboxStub::MigrateRequestE:
+                //handled by doCompleteMigrate, after the pending calls
+                impl_->migratevec.push_back(static_cast<MigrateRequestStub*>(pstub));
+                break;
+            case InboxStub::MigrateTaskE:
+                doAttachObject(ctx, *static_cast<MigrateTaskStub*>(pstub));
+                break;
+            }
+
+            if (pstub->type != InboxStub::MigrateRequestE) {
+                Data::deleteInboxStub(pstub);
+            }
+            pstub = pnext;
+            ++cnt;
+        }
+
+        addCount(statcnt.inbox_count, cnt);
+        maxCount(statcnt.inbox_max, cnt);
+
+        solid_dbg(logger, Verbose, impl_->exeq.size());
+    }
+
+    if (!impl_->fwduidvec.empty()) {
+        //all the events raised on the old uids were forwarded
+        for (UniqueId const& ruid : impl_->fwduidvec) {
+            ObjectStub& ros = impl_->objdq[static_cast<size_t>(ruid.index)];
+
+            ros.fwdreactoridx = InvalidIndex();
+            ++ros.unique;
+            impl_->freeuidvec.push_back(UniqueId(ruid.index, ros.unique));
+        }
+        impl_->fwduidvec.clear();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/*virtual*/ bool Reactor::migrateObject(UniqueId const& _robjuid, const size_t _reactor_index)
+{
+#if defined(SOLID_USE_EPOLL)
+    solid_dbg(logger, Verbose, (void*)this << " uid = " << _robjuid.index << ',' << _robjuid.unique << " reactor_index = " << _reactor_index);
+
+    if (impl_->inboxq.push(new MigrateRequestStub(_robjuid, 1, _reactor_index))) {
+        impl_->eventobj.eventhandler.write(*this);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
 
-        rch.pch->handleCompletion(ctx);
-        ctx.clearError();
+//-----------------------------------------------------------------------------
+
+/*virtual*/ bool Reactor::migrateBusiestObjects(const size_t _count, const size_t _reactor_index)
+{
+#if defined(SOLID_USE_EPOLL)
+    solid_dbg(logger, Verbose, (void*)this << " count = " << _count << " reactor_index = " << _reactor_index);
+
+    if (impl_->inboxq.push(new MigrateRequestStub(UniqueId::invalid(), _count, _reactor_index))) {
+        impl_->eventobj.eventhandler.write(*this);
     }
-#if defined(SOLID_USE_WSAPOLL)
-    for (size_t j = 0; j < impl_->connectvec.size();) {
-        const size_t           i   = impl_->connectvec[j];
-        WSAPOLLFD&             rev = impl_->eventvec[i];
-        CompletionHandlerStub& rch = impl_->chdq[i];
+    return true;
+#else
+    return false;
+#endif
+}
 
-        if (SocketDevice::error(rev.fd)) {
+//-----------------------------------------------------------------------------
 
-            ctx.reactor_event_ = systemEventsToReactorEvents(POLLERR, rev.events);
-            ctx.channel_index_ = i;
-            ctx.object_index_  = rch.objidx;
+void Reactor::doCompleteMigrate(NanoTime const& _rcrttime)
+{
+    ReactorContext ctx(*this, _rcrttime);
+    SizeTVectorT   idxvec;
 
-            remConnect(ctx);
+    for (MigrateRequestStub* preq : impl_->migratevec) {
+        if (preq->reactor_index == idInScheduler()) {
+            //already there
+        } else if (preq->uid.isValid()) {
+            const size_t objidx = static_cast<size_t>(preq->uid.index);
 
-            rch.pch->handleCompletion(ctx);
-            ctx.clearError();
+            if (objidx < impl_->objdq.size() && impl_->objdq[objidx].unique == preq->uid.unique && !impl_->objdq[objidx].objptr.empty()) {
+                doMigrateObject(ctx, objidx, preq->reactor_index);
+            }
         } else {
-            ++j;
+            //the most active objects since the last request
+            idxvec.clear();
+            for (size_t i = 1; i < impl_->objdq.size(); ++i) {
+                ObjectStub& ros = impl_->objdq[i];
+
+                if (!ros.objptr.empty() && ros.activitycnt != 0) {
+                    idxvec.push_back(i);
+                }
+            }
+
+            const size_t count = preq->count < idxvec.size() ? preq->count : idxvec.size();
+
+            std::partial_sort(
+                idxvec.begin(), idxvec.begin() + count, idxvec.end(),
+                [this](const size_t _i1, const size_t _i2) {
+                    return impl_->objdq[_i1].activitycnt > impl_->objdq[_i2].activitycnt;
+                });
+
+            for (ObjectStub& ros : impl_->objdq) {
+                ros.activitycnt = 0;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                doMigrateObject(ctx, idxvec[i], preq->reactor_index);
+            }
         }
+        delete preq;
     }
+    impl_->migratevec.clear();
+#if defined(SOLID_USE_IO_URING)
+    impl_->migratevec.swap(impl_->migratependvec);
 #endif
 }
 
 //-----------------------------------------------------------------------------
-#if defined(SOLID_USE_WSAPOLL)
-void Reactor::addConnect(ReactorContext& _rctx)
-{
-    CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
-    rch.connectidx             = impl_->connectvec.size();
-    impl_->connectvec.emplace_back(_rctx.channel_index_);
-}
 
-void Reactor::remConnect(ReactorContext& _rctx)
+/*NOTE:
+    The object is detached from this reactor and pushed to the target reactor
+    with the object's mutex locked, so that the target always receives the object
+    before any event raised on its new uid.
+    Events already raised on the old uid are forwarded by doCompleteEvents.
+*/
+void Reactor::doMigrateObject(ReactorContext& _rctx, const size_t _objidx, const size_t _reactor_index)
 {
-    CompletionHandlerStub& rch                       = impl_->chdq[_rctx.channel_index_];
-    impl_->connectvec[rch.connectidx]                = impl_->connectvec.back();
-    impl_->chdq[impl_->connectvec.back()].connectidx = rch.connectidx;
-    rch.connectidx                                   = InvalidIndex();
-    impl_->connectvec.pop_back();
-}
+#if defined(SOLID_USE_IO_URING)
+    //the requests in flight use this reactor's ring and buffers - see IoStub
+    if (!impl_->ioHold(impl_->objdq[_objidx].objptr->pnext)) {
+        impl_->migratependvec.push_back(new MigrateRequestStub(UniqueId(_objidx, impl_->objdq[_objidx].unique), 1, _reactor_index));
+        return;
+    }
 #endif
-//-----------------------------------------------------------------------------
+    ReactorBase* ptarget = acquireReactor(_reactor_index);
 
-struct ChangeTimerIndexCallback {
-    Reactor& r;
-    ChangeTimerIndexCallback(Reactor& _r)
-        : r(_r)
-    {
+    if (ptarget == nullptr) {
+#if defined(SOLID_USE_IO_URING)
+        doWakeIo(_objidx);
+#endif
+        return;
     }
 
-    void operator()(const size_t _chidx, const size_t _newidx, const size_t _oldidx) const
-    {
-        r.doUpdateTimerIndex(_chidx, _newidx, _oldidx);
-    }
-};
+    Reactor&         rtarget = *static_cast<Reactor*>(ptarget);
+    ObjectStub&      ros     = impl_->objdq[_objidx];
+    Object&          robj    = *ros.objptr;
+    MigrateTaskStub* ptask   = new MigrateTaskStub;
+    bool             pushed  = false;
 
-struct TimerCallback {
-    Reactor&        r;
-    ReactorContext& rctx;
-    TimerCallback(Reactor& _r, ReactorContext& _rctx)
-        : r(_r)
-        , rctx(_rctx)
-    {
-    }
+    _rctx.clearError();
+    _rctx.channel_index_ = InvalidIndex();
+    _rctx.object_index_  = _objidx;
 
-    void operator()(const size_t _tidx, const size_t _chidx) const
-    {
-        r.onTimer(rctx, _tidx, _chidx);
-    }
-};
+    const auto do_move = [this, &_rctx, &rtarget, &ros, &robj, ptask, &pushed, _objidx, _reactor_index]() {
+        doDetachObject(_rctx, *ptask);
 
-void Reactor::onTimer(ReactorContext& _rctx, const size_t _tidx, const size_t _chidx)
-{
-    CompletionHandlerStub& rch = impl_->chdq[_chidx];
+        {
+            lock_guard<std::mutex> lock(rtarget.impl_->mtx);
+            ptask->uid = rtarget.popUid(robj);
+        }
 
-    _rctx.reactor_event_ = ReactorEventTimer;
-    _rctx.channel_index_ = _chidx;
-    _rctx.object_index_  = rch.objidx;
+        ros.fwdreactoridx = _reactor_index;
+        ros.fwduid        = ptask->uid;
+        impl_->fwduidvec.push_back(UniqueId(_objidx, ros.unique));
 
-    rch.pch->handleCompletion(_rctx);
-    _rctx.clearError();
-}
+        solid_dbg(logger, Verbose, (void*)this << " object " << _objidx << " moved to " << (void*)&rtarget << " uid = " << ptask->uid.index << ',' << ptask->uid.unique);
 
-//-----------------------------------------------------------------------------
+        pushed = true;
+        if (rtarget.impl_->inboxq.push(ptask)) {
+            rtarget.impl_->eventobj.eventhandler.write(rtarget);
+        }
+        return true;
+    };
 
-void Reactor::doCompleteTimer(NanoTime const& _rcrttime)
-{
-    ReactorContext ctx(*this, _rcrttime);
-    TimerCallback  tcbk(*this, ctx);
-    impl_->timestore.pop(_rcrttime, tcbk, ChangeTimerIndexCallback(*this));
+    ScheduleFunctionT fct([&do_move](ReactorBase&) { return do_move(); });
+
+    moveObject(robj, ros.psvc->manager(), rtarget, fct);
+
+    if (!pushed) {
+        //only release the target reactor
+        if (rtarget.impl_->inboxq.push(ptask)) {
+            rtarget.impl_->eventobj.eventhandler.write(rtarget);
+        }
+#if defined(SOLID_USE_IO_URING)
+        doWakeIo(_objidx);
+#endif
+    }
 }
 
 //-----------------------------------------------------------------------------
 
-void Reactor::doCompleteExec(NanoTime const& _rcrttime)
+void Reactor::doDetachObject(ReactorContext& _rctx, MigrateTaskStub& _rtask)
 {
-    ReactorContext ctx(*this, _rcrttime);
-    size_t         sz = impl_->exeq.size();
+    ObjectStub&        ros  = impl_->objdq[_rctx.object_index_];
+    const UniqueId     uid  = objectUid(_rctx);
+    const UniqueId     duid = impl_->dummyCompletionHandlerUid();
+    CompletionHandler* pch  = ros.objptr->pnext;
+
+    while (pch != nullptr) {
+        if (pch->isActive()) {
+            const size_t           chidx = pch->idxreactor;
+            CompletionHandlerStub& rcs   = impl_->chdq[chidx];
+
+            _rtask.chvec.emplace_back(pch, chidx, rcs.unique);
+
+            MigrateHandlerStub& rmh = _rtask.chvec.back();
+
+            if (rcs.desc != Device::invalidDescriptor()) {
+                //the target reactor registers the pending events, if any
+                rmh.desc      = rcs.desc;
+                rmh.pollevs   = rcs.wantevs;
+                rcs.modqueued = false;
+#if defined(SOLID_USE_IO_URING)
+                impl_->ring.pollRemove(indexToPollData(chidx, rcs.pollgen));
+                ++rcs.pollgen;
+#else
+                epoll_event ev;
 
-    while (sz--) {
+                if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_DEL, rcs.desc, &ev)) {
+                    solid_dbg(logger, Error, "epoll_ctl: " << last_system_error().message());
+                    SOLID_THROW("epoll_ctl");
+                }
+#endif
+                rcs.desc    = Device::invalidDescriptor();
+                rcs.pollevs = 0;
+                --impl_->devcnt;
+            }
 
-        solid_dbg(logger, Verbose, sz << " qsz = " << impl_->exeq.size());
+#if defined(SOLID_USE_IO_URING)
+            impl_->ioMoveOut(chidx, rmh);
+#endif
+            if (rcs.timeridx != InvalidIndex()) {
+                rmh.hastimer  = true;
+                rmh.timertime = impl_->timestore.time(rcs.timeridx);
+                impl_->timestore.pop(rcs.timeridx, ChangeTimerIndexCallback(*this));
+                rcs.timeridx = InvalidIndex();
+            }
 
-        ExecStub&              rexe(impl_->exeq.front());
-        ObjectStub&            ros(impl_->objdq[static_cast<size_t>(rexe.objuid.index)]);
-        CompletionHandlerStub& rcs(impl_->chdq[static_cast<size_t>(rexe.chnuid.index)]);
+            impl_->chposcache.push(chidx);
+            rcs.pch    = &impl_->eventobj.dummyhandler;
+            rcs.objidx = 0;
+            ++rcs.unique;
 
-        if (ros.unique == rexe.objuid.unique && rcs.unique == rexe.chnuid.unique) {
-            ctx.clearError();
-            ctx.channel_index_ = static_cast<size_t>(rexe.chnuid.index);
-            ctx.object_index_  = static_cast<size_t>(rexe.objuid.index);
-            rexe.exefnc(ctx, std::move(rexe.event));
+            pch->idxreactor = InvalidIndex();
+        }
+        pch = pch->pnext;
+    }
+
+    //take the object's pending calls, keeping the order of the others
+    size_t sz = impl_->exeq.size();
+
+    while (sz--) {
+        ExecStub& rexe = impl_->exeq.front();
+
+        if (rexe.objuid != uid) {
+            impl_->exeq.push(std::move(rexe));
+        } else if (rexe.chnuid == duid) {
+            rexe.chnuid = UniqueId::invalid();
+            _rtask.exevec.emplace_back(std::move(rexe));
+        } else {
+            for (size_t i = 0; i < _rtask.chvec.size(); ++i) {
+                MigrateHandlerStub const& rmh = _rtask.chvec[i];
+
+                if (rmh.chidx == rexe.chnuid.index && rmh.unique == rexe.chnuid.unique) {
+                    rexe.chnuid = UniqueId(i, 0);
+                    _rtask.exevec.emplace_back(std::move(rexe));
+                    break;
+                }
+            }
+            //else: a call for an unregistered completion handler - dropped
         }
         impl_->exeq.pop();
     }
+
+    _rtask.objptr = std::move(ros.objptr);
+    _rtask.psvc   = ros.psvc;
+    ros.psvc      = nullptr;
+    --impl_->objcnt;
 }
 
 //-----------------------------------------------------------------------------
 
-void Reactor::doCompleteEvents(NanoTime const& _rcrttime)
+void Reactor::doAttachObject(ReactorContext& _rctx, MigrateTaskStub& _rtask)
 {
-    ReactorContext ctx(*this, _rcrttime);
-    doCompleteEvents(ctx);
-}
+    --incomingcnt;
 
-//-----------------------------------------------------------------------------
+    if (!_rtask.objptr) {
+        return;
+    }
 
-void Reactor::doCompleteEvents(ReactorContext const& _rctx)
-{
-    solid_dbg(logger, Verbose, "");
+    ++impl_->objcnt;
 
-    if (impl_->crtpushvecsz || impl_->crtraisevecsz) {
-        size_t crtpushvecidx;
-        size_t crtraisevecidx;
-        {
-            lock_guard<std::mutex> lock(impl_->mtx);
+    if (_rtask.uid.index >= impl_->objdq.size()) {
+        impl_->objdq.resize(static_cast<size_t>(_rtask.uid.index + 1));
+    }
 
-            crtpushvecidx  = impl_->crtpushtskvecidx;
-            crtraisevecidx = impl_->crtraisevecidx;
+    const size_t objidx = static_cast<size_t>(_rtask.uid.index);
+    ObjectStub&  ros    = impl_->objdq[objidx];
 
-            impl_->crtpushtskvecidx = ((crtpushvecidx + 1) & 1);
-            impl_->crtraisevecidx   = ((crtraisevecidx + 1) & 1);
+    SOLID_ASSERT(ros.unique == _rtask.uid.unique);
+    {
+        //wait for the manager to switch the object onto this reactor
+        lock_guard<std::mutex> lock(_rtask.psvc->mutex(*_rtask.objptr));
+    }
 
-            for (auto it = impl_->freeuidvec.begin(); it != impl_->freeuidvec.end(); ++it) {
-                this->pushUid(*it);
-            }
-            impl_->freeuidvec.clear();
+    ros.objptr      = std::move(_rtask.objptr);
+    ros.psvc        = _rtask.psvc;
+    ros.execflagged = false;
 
-            impl_->crtpushvecsz = impl_->crtraisevecsz = 0;
-        }
+    _rctx.clearError();
+    _rctx.channel_index_ = InvalidIndex();
+    _rctx.object_index_  = objidx;
 
-        NewTaskVectorT&    crtpushvec  = impl_->pushtskvec[crtpushvecidx];
-        RaiseEventVectorT& crtraisevec = impl_->raisevec[crtraisevecidx];
+    SizeTVectorT chidxvec;
 
-        ReactorContext ctx(_rctx);
+    chidxvec.reserve(_rtask.chvec.size());
 
-        impl_->objcnt += crtpushvec.size();
+    for (MigrateHandlerStub& rmh : _rtask.chvec) {
+        size_t idx;
 
-        solid_dbg(logger, Verbose, impl_->exeq.size());
+        if (impl_->chposcache.size()) {
+            idx = impl_->chposcache.top();
+            impl_->chposcache.pop();
+        } else {
+            idx = impl_->chdq.size();
+            impl_->chdq.push_back(CompletionHandlerStub());
+        }
+        chidxvec.push_back(idx);
+
+        CompletionHandlerStub& rcs = impl_->chdq[idx];
+
+        rcs.objidx          = objidx;
+        rcs.pch             = rmh.pch;
+        rmh.pch->idxreactor = idx;
+
+        if (rmh.desc != Device::invalidDescriptor()) {
+            rcs.desc      = rmh.desc;
+            rcs.pollevs   = rmh.pollevs;
+            rcs.wantevs   = rmh.pollevs;
+            rcs.modqueued = false;
+#if defined(SOLID_USE_IO_URING)
+            ++rcs.pollgen;
+            impl_->ring.pollAdd(rcs.desc, rcs.pollevs, indexToPollData(idx, rcs.pollgen));
+#else
+            epoll_event ev;
 
-        for (auto it = crtpushvec.begin(); it != crtpushvec.end(); ++it) {
+            ev.data.u64 = idx;
+            ev.events   = rcs.pollevs;
 
-            NewTaskStub& rnewobj(*it);
-            if (rnewobj.uid.index >= impl_->objdq.size()) {
-                impl_->objdq.resize(static_cast<size_t>(rnewobj.uid.index + 1));
+            if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_ADD, rcs.desc, &ev)) {
+                solid_dbg(logger, Error, "epoll_ctl: " << last_system_error().message());
+                SOLID_THROW("epoll_ctl");
+            }
+#endif
+            ++impl_->devcnt;
+            if (impl_->devcnt == (impl_->eventvec.size() + 1)) {
+                impl_->eventobj.post(_rctx, &Reactor::increase_event_vector_size);
             }
-            ObjectStub& ros = impl_->objdq[static_cast<size_t>(rnewobj.uid.index)];
+        }
 
-            SOLID_ASSERT(ros.unique == rnewobj.uid.unique);
+        if (rmh.hastimer) {
+            rcs.timeridx = impl_->timestore.push(rmh.timertime, idx);
 
-            {
-                //NOTE: we must lock the mutex of the object
-                //in order to ensure that object is fully registered onto the manager
+            static_cast<SteadyTimer*>(rmh.pch)->storeidx = rcs.timeridx;
+        }
+#if defined(SOLID_USE_IO_URING)
+        impl_->ioMoveIn(idx, rmh);
+#endif
+    }
 
-                lock_guard<std::mutex> lock(rnewobj.rsvc.mutex(*rnewobj.objptr));
-            }
+    for (ExecStub& rexe : _rtask.exevec) {
+        rexe.objuid = _rtask.uid;
+        if (rexe.chnuid.isInvalid()) {
+            rexe.chnuid = impl_->dummyCompletionHandlerUid();
+        } else {
+            const size_t idx = chidxvec[static_cast<size_t>(rexe.chnuid.index)];
+            rexe.chnuid      = UniqueId(idx, impl_->chdq[idx].unique);
+        }
+        impl_->exeq.push(std::move(rexe));
+    }
+#if defined(SOLID_USE_IO_URING)
+    doWakeIo(objidx);
+#endif
+}
 
-            ros.objptr = std::move(rnewobj.objptr);
-            ros.psvc   = &rnewobj.rsvc;
+#if defined(SOLID_USE_IO_URING)
+//-----------------------------------------------------------------------------
+/*
+    The object stays on or was moved to this reactor - the calls refused while
+    it was on hold and the requests cancelled for the move are notified as
+    readiness events, so the completion handlers try again.
+*/
+void Reactor::doWakeIo(const size_t _objidx)
+{
+    const UniqueId objuid(_objidx, impl_->objdq[_objidx].unique);
 
-            ctx.clearError();
-            ctx.channel_index_ = InvalidIndex();
-            ctx.object_index_  = static_cast<size_t>(rnewobj.uid.index);
+    for (CompletionHandler* pch = impl_->objdq[_objidx].objptr->pnext; pch != nullptr; pch = pch->pnext) {
+        if (!pch->isActive()) {
+            continue;
+        }
+        const size_t           chidx = pch->idxreactor;
+        CompletionHandlerStub& rcs   = impl_->chdq[chidx];
+        const UniqueId         chnuid(chidx, rcs.unique);
 
-            ros.objptr->registerCompletionHandlers();
+        rcs.iohold = false;
 
-            impl_->exeq.push(ExecStub(rnewobj.uid, &call_object_on_event, impl_->dummyCompletionHandlerUid(), std::move(rnewobj.event)));
+        if (rcs.rdwake) {
+            rcs.rdwake = false;
+            impl_->exeq.push(ExecStub(objuid, &Reactor::wake_io_recv, chnuid));
         }
+        if (rcs.wrwake) {
+            rcs.wrwake = false;
+            impl_->exeq.push(ExecStub(objuid, &Reactor::wake_io_send, chnuid));
+        }
+    }
+}
 
-        solid_dbg(logger, Verbose, impl_->exeq.size());
-        crtpushvec.clear();
+//-----------------------------------------------------------------------------
 
-        for (auto it = crtraisevec.begin(); it != crtraisevec.end(); ++it) {
-            RaiseEventStub& revent = *it;
-            impl_->exeq.push(ExecStub(revent.uid, &call_object_on_event, impl_->dummyCompletionHandlerUid(), std::move(revent.event)));
-        }
+/*static*/ void Reactor::wake_io_recv(ReactorContext& _rctx, Event&&)
+{
+    _rctx.reactor_event_ = ReactorEventRecv;
+    _rctx.reactor().completionHandler(_rctx)->handleCompletion(_rctx);
+}
 
-        solid_dbg(logger, Verbose, impl_->exeq.size());
+//-----------------------------------------------------------------------------
 
-        crtraisevec.clear();
-    }
+/*static*/ void Reactor::wake_io_send(ReactorContext& _rctx, Event&&)
+{
+    _rctx.reactor_event_ = ReactorEventSend;
+    _rctx.reactor().completionHandler(_rctx)->handleCompletion(_rctx);
 }
+#endif
 
 //-----------------------------------------------------------------------------
 
@@ -1314,7 +3149,22 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 
     //SOLID_ASSERT(_rctx.channel_index_ == _rch.idxreactor);
 
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+    CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
+
+    rch.desc      = _rsd.Device::descriptor();
+    rch.pollevs   = reactorRequestsToSystemEvents(_req);
+    rch.wantevs   = rch.pollevs;
+    rch.modqueued = false;
+    ++rch.pollgen;
+
+    impl_->ring.pollAdd(rch.desc, rch.pollevs, indexToPollData(_rctx.channel_index_, rch.pollgen));
+
+    ++impl_->devcnt;
+    if (impl_->devcnt == (impl_->eventvec.size() + 1)) {
+        impl_->eventobj.post(_rctx, &Reactor::increase_event_vector_size);
+    }
+#elif defined(SOLID_USE_EPOLL)
     epoll_event ev;
     ev.data.u64 = _rctx.channel_index_;
     ev.events   = reactorRequestsToSystemEvents(_req);
@@ -1324,6 +3174,13 @@ bool Reactor::addDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
         SOLID_THROW("epoll_ctl");
         return false;
     } else {
+        CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
+
+        rch.desc      = _rsd.Device::descriptor();
+        rch.pollevs   = ev.events;
+        rch.wantevs   = ev.events;
+        rch.modqueued = false;
+
         ++impl_->devcnt;
         if (impl_->devcnt == (impl_->eventvec.size() + 1)) {
             impl_->eventobj.post(_rctx, &Reactor::increase_event_vector_size);
@@ -1399,15 +3256,18 @@ bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 {
     solid_dbg(logger, Info, _rsd.descriptor());
 #if defined(SOLID_USE_EPOLL)
-    epoll_event ev;
+    //the change is applied by doUpdatePollEvents, right before the next wait
+    CompletionHandlerStub& rch = impl_->chdq[_rctx.channel_index_];
 
-    ev.data.u64 = _rctx.channel_index_;
-    ev.events   = reactorRequestsToSystemEvents(_req);
+    SOLID_ASSERT(rch.desc == _rsd.Device::descriptor());
 
-    if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_MOD, _rsd.Device::descriptor(), &ev)) {
-        solid_dbg(logger, Error, "epoll_ctl: " << last_system_error().message());
-        SOLID_THROW("epoll_ctl");
-        return false;
+    addCount(statcnt.poll_mod_request_count, 1);
+
+    rch.wantevs = reactorRequestsToSystemEvents(_req);
+
+    if (!rch.modqueued && rch.wantevs != rch.pollevs) {
+        rch.modqueued = true;
+        impl_->modvec.push_back(_rctx.channel_index_);
     }
 #elif defined(SOLID_USE_KQUEUE)
     int read_flags = 0;
@@ -1481,7 +3341,23 @@ bool Reactor::modDevice(ReactorContext& _rctx, Device const& _rsd, const Reactor
 bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
 {
     solid_dbg(logger, Info, _rsd.descriptor());
-#if defined(SOLID_USE_EPOLL)
+#if defined(SOLID_USE_IO_URING)
+    if (!_rsd) {
+        return false;
+    }
+
+    CompletionHandlerStub& rch = impl_->chdq[_rch.idxreactor];
+
+    impl_->ioDetach(_rch.idxreactor);
+    impl_->ring.pollRemove(indexToPollData(_rch.idxreactor, rch.pollgen));
+
+    rch.desc      = Device::invalidDescriptor();
+    rch.pollevs   = 0;
+    rch.modqueued = false;
+    ++rch.pollgen;
+
+    --impl_->devcnt;
+#elif defined(SOLID_USE_EPOLL)
     epoll_event ev;
 
     if (!_rsd) {
@@ -1493,6 +3369,11 @@ bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
         SOLID_THROW("epoll_ctl");
         return false;
     } else {
+        CompletionHandlerStub& rch = impl_->chdq[_rch.idxreactor];
+
+        rch.desc      = Device::invalidDescriptor();
+        rch.pollevs   = 0;
+        rch.modqueued = false;
         --impl_->devcnt;
     }
 #elif defined(SOLID_USE_KQUEUE)
@@ -1527,6 +3408,76 @@ bool Reactor::remDevice(CompletionHandler const& _rch, Device const& _rsd)
     return true;
 }
 
+//-----------------------------------------------------------------------------
+#if defined(SOLID_USE_IO_URING)
+
+ssize_t Reactor::recv(ReactorContext& _rctx, SocketDevice const& _rsd, IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_rctx.channel_index_ < impl_->chdq.size());
+    return impl_->ioRecv(_rctx.channel_index_, _rsd.descriptor(), _piov, _iovcnt, _can_retry, _rerr);
+}
+
+//-----------------------------------------------------------------------------
+
+ssize_t Reactor::send(ReactorContext& _rctx, SocketDevice const& _rsd, const IoVecT* _piov, const size_t _iovcnt, bool& _can_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_rctx.channel_index_ < impl_->chdq.size());
+    return impl_->ioSend(_rctx.channel_index_, _rsd.descriptor(), _piov, _iovcnt, _can_retry, _rerr);
+}
+
+//-----------------------------------------------------------------------------
+
+ErrorCodeT Reactor::accept(ReactorContext& _rctx, SocketDevice const& _rsd, SocketDevice& _rnewsd, bool& _can_retry)
+{
+    SOLID_ASSERT(_rctx.channel_index_ < impl_->chdq.size());
+    return impl_->ioAccept(_rctx.channel_index_, _rsd.descriptor(), _rnewsd, _can_retry);
+}
+
+#endif
+//-----------------------------------------------------------------------------
+#if defined(SOLID_USE_EPOLL)
+/*
+    One poll update per completion handler whose events changed since the
+    last wait - the intermediate changes within a loop are never applied.
+*/
+void Reactor::doUpdatePollEvents()
+{
+    for (const size_t chidx : impl_->modvec) {
+        CompletionHandlerStub& rch = impl_->chdq[chidx];
+
+        if (!rch.modqueued) {
+            continue; //the device was removed
+        }
+        rch.modqueued = false;
+
+        if (rch.wantevs == rch.pollevs) {
+            continue;
+        }
+
+#if defined(SOLID_USE_IO_URING)
+        impl_->ring.pollRemove(indexToPollData(chidx, rch.pollgen));
+
+        rch.pollevs = rch.wantevs;
+        ++rch.pollgen;
+
+        impl_->ring.pollAdd(rch.desc, rch.pollevs, indexToPollData(chidx, rch.pollgen));
+#else
+        epoll_event ev;
+
+        ev.data.u64 = chidx;
+        ev.events   = rch.wantevs;
+
+        if (epoll_ctl(impl_->reactor_fd, EPOLL_CTL_MOD, rch.desc, &ev)) {
+            solid_dbg(logger, Error, "epoll_ctl: " << last_system_error().message());
+            SOLID_THROW("epoll_ctl");
+        }
+        rch.pollevs = rch.wantevs;
+#endif
+        addCount(statcnt.poll_mod_count, 1);
+    }
+    impl_->modvec.clear();
+}
+#endif
 //-----------------------------------------------------------------------------
 
 bool Reactor::addTimer(CompletionHandler const& _rch, NanoTime const& _rt, size_t& _rstoreidx)
@@ -1536,6 +3487,8 @@ bool Reactor::addTimer(CompletionHandler const& _rch, NanoTime const& _rt, size_
         SOLID_ASSERT(idx == _rch.idxreactor);
     } else {
         _rstoreidx = impl_->timestore.push(_rt, _rch.idxreactor);
+
+        impl_->chdq[_rch.idxreactor].timeridx = _rstoreidx;
     }
     return true;
 }
@@ -1547,6 +3500,7 @@ void Reactor::doUpdateTimerIndex(const size_t _chidx, const size_t _newidx, cons
     CompletionHandlerStub& rch = impl_->chdq[_chidx];
     SOLID_ASSERT(static_cast<SteadyTimer*>(rch.pch)->storeidx == _oldidx);
     static_cast<SteadyTimer*>(rch.pch)->storeidx = _newidx;
+    rch.timeridx                                 = _newidx;
 }
 
 //-----------------------------------------------------------------------------
@@ -1555,6 +3509,7 @@ bool Reactor::remTimer(CompletionHandler const& _rch, size_t const& _rstoreidx)
 {
     if (_rstoreidx != InvalidIndex()) {
         impl_->timestore.pop(_rstoreidx, ChangeTimerIndexCallback(*this));
+        impl_->chdq[_rch.idxreactor].timeridx = InvalidIndex();
     }
     return true;
 }
@@ -1612,6 +3567,9 @@ void Reactor::unregisterCompletionHandler(CompletionHandler& _rch)
 
         _rch.handleCompletion(ctx);
     }
+#if defined(SOLID_USE_IO_URING)
+    impl_->ioDetach(_rch.idxreactor);
+#endif
 
     impl_->chposcache.push(_rch.idxreactor);
     rcs.pch    = &impl_->eventobj.dummyhandler;
@@ -1682,6 +3640,13 @@ UniqueId ReactorContext::objectUid() const
 
 //-----------------------------------------------------------------------------
 
+size_t ReactorContext::reactorIndex() const
+{
+    return reactor().idInScheduler();
+}
+
+//-----------------------------------------------------------------------------
+
 CompletionHandler* ReactorContext::completionHandler() const
 {
     return reactor().completionHandler(*this);
@@ -9,10 +9,14 @@
 //
 
 #include "solid/frame/aio/aioresolver.hpp"
+#include "solid/system/cassert.hpp"
 #include "solid/utility/dynamicpointer.hpp"
 #include "solid/utility/workpool.hpp"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace solid {
 namespace frame {
@@ -35,16 +39,253 @@ struct WorkPoolController : solid::WorkPoolController {
     }
 };
 
+namespace {
+
+using DirectResolvePointerT = DynamicPointer<DirectResolve>;
+using TimePointT            = std::chrono::steady_clock::time_point;
+
+class ResolveCache;
+
+//Completes a request from a cache entry, without calling getaddrinfo
+struct CachedResolve : ResolveBase {
+    DirectResolvePointerT reqptr;
+    ResolveData           data;
+
+    CachedResolve(DirectResolvePointerT const& _rreqptr, ResolveData const& _rdata)
+        : ResolveBase(0)
+        , reqptr(_rreqptr)
+        , data(_rdata)
+    {
+    }
+
+    /*virtual*/ void run(bool _fail)
+    {
+        if (!_fail) {
+            reqptr->complete(data);
+        } else {
+            reqptr->run(true);
+        }
+    }
+};
+
+//The one lookup of a cache entry - completes the requests waiting for it
+struct CacheLookup : ResolveBase {
+    ResolveCache& rcache;
+    std::string   key;
+    std::string   host;
+    std::string   srvc;
+    int           family;
+    int           type;
+    int           proto;
+
+    CacheLookup(ResolveCache& _rcache, std::string const& _rkey, DirectResolve const& _rreq)
+        : ResolveBase(_rreq.flags)
+        , rcache(_rcache)
+        , key(_rkey)
+        , host(_rreq.host)
+        , srvc(_rreq.srvc)
+        , family(_rreq.family)
+        , type(_rreq.type)
+        , proto(_rreq.proto)
+    {
+    }
+
+    /*virtual*/ void run(bool _fail);
+};
+
+class ResolveCache {
+    struct Entry {
+        Entry()
+            : resolved(false)
+            , pending(false)
+        {
+        }
+
+        ResolveData                        data;
+        TimePointT                         expire_time;
+        TimePointT                         stale_time;
+        bool                               resolved;
+        bool                               pending;
+        std::vector<DirectResolvePointerT> waitvec;
+    };
+
+    using EntryMapT = std::unordered_map<std::string, Entry>;
+
+public:
+    void configure(ResolverCacheConfiguration const& _rcfg)
+    {
+        config_ = _rcfg;
+    }
+
+    bool enabled() const
+    {
+        return config_.enabled();
+    }
+
+    //Returns the jobs to be pushed on the work pool
+    void schedule(DirectResolvePointerT const& _rreqptr, ResolverPointerT& _rjobptr, ResolverPointerT& _rrefreshptr)
+    {
+        const std::string           key = makeKey(*_rreqptr);
+        const TimePointT            now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(mtx_);
+        EntryMapT::iterator         it = entry_map_.find(key);
+
+        if (it == entry_map_.end()) {
+            if (entry_map_.size() >= config_.max_entry_count) {
+                evict(now);
+            }
+            if (entry_map_.size() >= config_.max_entry_count) {
+                _rjobptr = _rreqptr;
+                return;
+            }
+            it = entry_map_.emplace(key, Entry()).first;
+        }
+
+        Entry& rentry = it->second;
+
+        if (rentry.resolved && now < rentry.expire_time) {
+            ++stat_.hit_count;
+            if (rentry.data.empty()) {
+                ++stat_.negative_hit_count;
+            }
+            _rjobptr = new CachedResolve(_rreqptr, rentry.data);
+        } else if (rentry.resolved && now < rentry.stale_time) {
+            ++stat_.stale_hit_count;
+            _rjobptr = new CachedResolve(_rreqptr, rentry.data);
+            if (!rentry.pending) {
+                rentry.pending = true;
+                ++stat_.lookup_count;
+                _rrefreshptr = new CacheLookup(*this, key, *_rreqptr);
+            }
+        } else {
+            rentry.waitvec.emplace_back(_rreqptr);
+            if (!rentry.pending) {
+                rentry.pending = true;
+                ++stat_.lookup_count;
+                _rjobptr = new CacheLookup(*this, key, *_rreqptr);
+            } else {
+                ++stat_.coalesced_count;
+            }
+        }
+    }
+
+    void complete(std::string const& _rkey, ResolveData& _rrd, const bool _fail)
+    {
+        std::vector<DirectResolvePointerT> waitvec;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            EntryMapT::iterator         it = entry_map_.find(_rkey);
+
+            SOLID_ASSERT(it != entry_map_.end());
+
+            Entry& rentry = it->second;
+
+            rentry.pending = false;
+            waitvec.swap(rentry.waitvec);
+
+            if (!_fail) {
+                const TimePointT now = std::chrono::steady_clock::now();
+
+                rentry.resolved = true;
+                rentry.data     = _rrd;
+                if (!_rrd.empty()) {
+                    rentry.expire_time = now + config_.ttl;
+                    rentry.stale_time  = rentry.expire_time + config_.stale_ttl;
+                } else {
+                    rentry.expire_time = now + config_.negative_ttl;
+                    rentry.stale_time  = rentry.expire_time;
+                }
+            } else {
+                entry_map_.erase(it);
+            }
+        }
+        for (auto& reqptr : waitvec) {
+            if (!_fail) {
+                reqptr->complete(_rrd);
+            } else {
+                reqptr->run(true);
+            }
+        }
+    }
+
+    void statistic(ResolverCacheStatistic& _rstat) const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        _rstat             = stat_;
+        _rstat.entry_count = entry_map_.size();
+    }
+
+private:
+    static std::string makeKey(DirectResolve const& _rreq)
+    {
+        std::string key;
+
+        key.reserve(_rreq.host.size() + _rreq.srvc.size() + 32);
+        key += _rreq.host;
+        key += '\0';
+        key += _rreq.srvc;
+        key += '\0';
+        key += std::to_string(_rreq.flags);
+        key += ',';
+        key += std::to_string(_rreq.family);
+        key += ',';
+        key += std::to_string(_rreq.type);
+        key += ',';
+        key += std::to_string(_rreq.proto);
+        return key;
+    }
+
+    void evict(const TimePointT& _rnow)
+    {
+        for (auto it = entry_map_.begin(); it != entry_map_.end();) {
+            if (!it->second.pending && _rnow >= it->second.stale_time) {
+                it = entry_map_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    ResolverCacheConfiguration config_;
+    mutable std::mutex         mtx_;
+    EntryMapT                  entry_map_;
+    ResolverCacheStatistic     stat_;
+};
+
+/*virtual*/ void CacheLookup::run(bool _fail)
+{
+    ResolveData rd;
+
+    if (!_fail) {
+        rd = synchronous_resolve(host.c_str(), srvc.c_str(), flags, family, type, proto);
+    }
+    rcache.complete(key, rd, _fail);
+}
+
+} //namespace
+
 struct Resolver::Data {
     Data(const size_t _max_thr_cnt, const size_t _max_job_cnt)
         : wp(_max_thr_cnt, _max_job_cnt)
     {
     }
 
-    WorkPoolT wp;
-    size_t    thrcnt;
+    WorkPoolT    wp;
+    size_t       thrcnt;
+    ResolveCache cache;
 };
 
+ResolverCacheStatistic::ResolverCacheStatistic()
+    : lookup_count(0)
+    , hit_count(0)
+    , negative_hit_count(0)
+    , stale_hit_count(0)
+    , coalesced_count(0)
+    , entry_count(0)
+{
+}
+
 /*virtual*/ ResolveBase::~ResolveBase()
 {
 }
@@ -58,6 +299,11 @@ Resolver::~Resolver()
 {
 }
 
+void Resolver::cache(ResolverCacheConfiguration const& _rcfg)
+{
+    impl_->cache.configure(_rcfg);
+}
+
 ErrorConditionT Resolver::start(ushort _thrcnt)
 {
     impl_->wp.start(_thrcnt);
@@ -70,12 +316,38 @@ void Resolver::stop()
     impl_->wp.stop();
 }
 
+void Resolver::cacheStatistic(ResolverCacheStatistic& _rstat) const
+{
+    impl_->cache.statistic(_rstat);
+}
+
 void Resolver::doSchedule(ResolveBase* _pb)
 {
     ResolverPointerT ptr(_pb);
     impl_->wp.push(ptr);
 }
 
+void Resolver::doSchedule(DirectResolve* _pb)
+{
+    if (!impl_->cache.enabled()) {
+        doSchedule(static_cast<ResolveBase*>(_pb));
+        return;
+    }
+
+    DirectResolvePointerT reqptr(_pb);
+    ResolverPointerT      jobptr;
+    ResolverPointerT      refreshptr;
+
+    impl_->cache.schedule(reqptr, jobptr, refreshptr);
+
+    if (!jobptr.empty()) {
+        impl_->wp.push(jobptr);
+    }
+    if (!refreshptr.empty()) {
+        impl_->wp.push(refreshptr);
+    }
+}
+
 //---------------------------------------------------------------
 ResolveData DirectResolve::doRun()
 {
@@ -0,0 +1,226 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             started_count = 0;
+size_t             batch_count   = 0;
+size_t             batch_max     = 0;
+bool               failed        = false;
+vector<size_t>     start_count_vec;
+AioSchedulerT*     psch = nullptr;
+
+const size_t batch_size = 32;
+
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd)
+        : sd(std::move(_usd))
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            lock_guard<mutex> lock(mtx);
+            ++start_count_vec[_rctx.reactorIndex()];
+            ++started_count;
+            cnd.notify_one();
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+private:
+    SocketDevice sd;
+};
+
+//Accepts the connections in batches and starts them with one startObjects call
+class Listener final : public Dynamic<Listener, frame::aio::Object> {
+public:
+    Listener(SocketDevice&& _usd)
+        : sock(this->proxy(), std::move(_usd))
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postAccept(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postAccept(frame::aio::ReactorContext& _rctx)
+    {
+        sock.postAcceptBatch(
+            _rctx, batch_size,
+            [this](frame::aio::ReactorContext& _rctx, frame::aio::Listener::SocketDeviceVectorT& _rsd_vec) { onAccept(_rctx, _rsd_vec); });
+    }
+
+    void onAccept(frame::aio::ReactorContext& _rctx, frame::aio::Listener::SocketDeviceVectorT& _rsd_vec)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+
+        vector<AioSchedulerT::ObjectPointerT> objvec;
+        vector<frame::ObjectIdT>              objuid_vec;
+        solid::ErrorConditionT                err;
+
+        for (auto& rsd : _rsd_vec) {
+            objvec.emplace_back(new Connection(std::move(rsd)));
+        }
+
+        const size_t count = psch->startObjects(objvec.begin(), objvec.end(), _rctx.service(), make_event(GenericEvents::Start), objuid_vec, err);
+        {
+            lock_guard<mutex> lock(mtx);
+            if (err || count != objvec.size()) {
+                cout << "Error starting objects: " << err.message() << endl;
+                failed = true;
+            }
+            if (objuid_vec.size() != objvec.size() || std::any_of(objuid_vec.begin(), objuid_vec.end(), [](const frame::ObjectIdT& _ruid) { return _ruid.isInvalid(); })) {
+                cout << "Wrong object ids" << endl;
+                failed = true;
+            }
+            ++batch_count;
+            if (objvec.size() > batch_max) {
+                batch_max = objvec.size();
+            }
+        }
+        postAccept(_rctx);
+    }
+
+private:
+    frame::aio::Listener sock;
+};
+
+} //namespace
+
+int test_accept_batch(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t connection_count = 100;
+    if (argc > 1) {
+        connection_count = atoi(argv[1]);
+    }
+
+    const size_t reactor_count = 2;
+
+    cout << "Test accept batch with connection_count = " << connection_count << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(reactor_count)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    psch = &sch;
+    start_count_vec.resize(reactor_count, 0);
+
+    ResolveData          rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice         listen_sd;
+    SocketAddress        local_address;
+    vector<SocketDevice> client_sd_vec(connection_count);
+
+    if (listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin(), SocketInfo::max_listen_backlog_size()) || listen_sd.localAddress(local_address)) {
+        cout << "Error creating the listener socket" << endl;
+        return -1;
+    }
+
+    //the storm - all the connections wait in the listen queue before the listener starts
+    for (auto& rsd : client_sd_vec) {
+        if (rsd.create(rd.begin()) || rsd.connect(local_address)) {
+            cout << "Error connecting" << endl;
+            return -1;
+        }
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Listener(std::move(listen_sd)));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(10), [connection_count]() { return started_count == connection_count; })) {
+            cout << "Connections not started: " << started_count << " != " << connection_count << endl;
+            return -1;
+        }
+    }
+
+    frame::ReactorStatisticVectorT stat_vec;
+
+    sch.statistics(stat_vec);
+
+    client_sd_vec.clear();
+    mgr.stop();
+
+    cout << "Batches = " << batch_count << " max = " << batch_max << " started per reactor =";
+    for (size_t i = 0; i < reactor_count; ++i) {
+        cout << ' ' << start_count_vec[i] << " (inbox max " << stat_vec[i].inbox_max << ')';
+    }
+    cout << endl;
+
+    if (failed) {
+        return -1;
+    }
+
+    if (connection_count > batch_size && batch_max != batch_size) {
+        cout << "Connections not accepted in batches" << endl;
+        return -1;
+    }
+
+    for (size_t i = 0; i < reactor_count; ++i) {
+        //a batch is spread on the reactors and every share lands in an inbox at once
+        if (connection_count >= batch_size && (start_count_vec[i] == 0 || stat_vec[i].inbox_max < 8)) {
+            cout << "Batch not spread on reactor " << i << endl;
+            return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiocoroutine.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+atomic<thread::id> reactor_thread_id;
+atomic<size_t>     echo_count(0);
+atomic<bool>       resolved(false);
+atomic<bool>       waited(false);
+atomic<bool>       failed(false);
+
+//Resolves localhost, waits on a timer, then echoes - all from one coroutine
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd, frame::aio::Resolver& _rresolver)
+        : sock(this->proxy(), std::move(_usd))
+        , timer(this->proxy())
+        , rresolver(_rresolver)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            reactor_thread_id = this_thread::get_id();
+            task              = run(_rctx);
+        } else if (frame::aio::resume_coroutine(_rctx, _revent)) {
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    frame::aio::Task run(frame::aio::ReactorContext& _rctx)
+    {
+        frame::aio::CoroutineContext ctx(_rctx);
+
+        frame::aio::ResolveResult result = co_await frame::aio::co_resolve(ctx, rresolver, "localhost", "0", 0, -1, SocketInfo::Stream);
+
+        if (result.error || result.data.empty() || !checkThread()) {
+            cout << "Error resolving localhost: " << result.error.message() << endl;
+            failed = true;
+            postStop(*ctx);
+            co_return;
+        }
+        resolved = true;
+
+        co_await frame::aio::co_wait_for(ctx, timer, std::chrono::milliseconds(10));
+
+        if (ctx->error() || !checkThread()) {
+            failed = true;
+            postStop(*ctx);
+            co_return;
+        }
+        waited = true;
+
+        while (true) {
+            const size_t sz = co_await frame::aio::co_recv_some(ctx, sock, buf, sizeof(buf));
+
+            if (ctx->error()) {
+                break;
+            }
+
+            co_await frame::aio::co_send_all(ctx, sock, buf, sz);
+
+            if (ctx->error() || !checkThread()) {
+                cout << "Send error: " << ctx->error().message() << endl;
+                failed = true;
+                break;
+            }
+            ++echo_count;
+        }
+        postStop(*ctx);
+    }
+
+    //the coroutine must always be resumed on the reactor of the object
+    static bool checkThread()
+    {
+        return reactor_thread_id.load() == this_thread::get_id();
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT           sock;
+    frame::aio::SteadyTimer timer;
+    frame::aio::Resolver&   rresolver;
+    char                    buf[1024];
+    frame::aio::Task        task;
+};
+
+bool echo(SocketDevice& _rsd, const size_t _round)
+{
+    char       buf[256];
+    const char c = static_cast<char>('a' + _round % 26);
+
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = c;
+    }
+
+    bool       can_retry;
+    ErrorCodeT err;
+
+    if (_rsd.send(buf, sizeof(buf), can_retry, err) != sizeof(buf)) {
+        cout << "Error sending: " << err.message() << endl;
+        return false;
+    }
+
+    size_t recv_size = 0;
+    while (recv_size < sizeof(buf)) {
+        const ssize_t rv = _rsd.recv(buf, sizeof(buf) - recv_size, can_retry, err);
+
+        if (rv <= 0) {
+            cout << "Error receiving: " << err.message() << endl;
+            return false;
+        }
+        for (ssize_t i = 0; i < rv; ++i) {
+            if (buf[i] != c) {
+                cout << "Received data differs" << endl;
+                return false;
+            }
+        }
+        recv_size += rv;
+    }
+    return true;
+}
+
+} //namespace
+
+int test_coroutine_echo(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t round_count = 1000;
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+    }
+
+    cout << "Test coroutine echo with round_count = " << round_count << endl;
+
+    AioSchedulerT        sch;
+    frame::Manager       mgr;
+    frame::ServiceT      svc{mgr};
+    frame::aio::Resolver resolver;
+
+    if (sch.start(1) || resolver.start(1)) {
+        cout << "Error starting scheduler or resolver" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd) || client_sd.makeBlocking(5000)) {
+        cout << "Error creating the connection" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd), resolver));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < round_count; ++i) {
+        if (!echo(client_sd, i)) {
+            return -1;
+        }
+    }
+
+    //the coroutine ends when the peer closes the connection
+    client_sd.close();
+
+    mgr.stop();
+
+    if (failed || !resolved || !waited) {
+        return -1;
+    }
+    if (echo_count != round_count) {
+        cout << "Echo count differs: " << echo_count << " != " << round_count << endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiodatagram.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+enum {
+    SlotCount    = 16,
+    SlotCapacity = 64 * 1024,
+    SegmentSize  = 512,
+    SegmentCount = 4,
+};
+
+atomic<size_t> recv_datagram_count(0);
+atomic<bool>   coalesced_seen(false);
+atomic<bool>   server_error(false);
+
+size_t datagram_size(const size_t _seq)
+{
+    return 100 + (_seq * 37) % 1200;
+}
+
+char datagram_char(const size_t _seq)
+{
+    return static_cast<char>('a' + _seq % 26);
+}
+
+//Echoes back every batch of datagrams, keeping the segment size of the coalesced ones
+class Talker final : public Dynamic<Talker, frame::aio::Object> {
+public:
+    Talker(SocketDevice&& _usd)
+        : sock(this->proxy(), std::move(_usd))
+        , buf(SlotCount * SlotCapacity)
+    {
+        for (size_t i = 0; i < SlotCount; ++i) {
+            slots[i] = DatagramSlot(buf.data() + i * SlotCapacity, SlotCapacity);
+        }
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postRecv(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecv(frame::aio::ReactorContext& _rctx)
+    {
+        sock.postRecvFrom(
+            _rctx, slots, SlotCount,
+            [this](frame::aio::ReactorContext& _rctx, size_t _cnt) { onRecv(_rctx, _cnt); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _cnt)
+    {
+        size_t repeatcnt = 16;
+
+        do {
+            if (_rctx.error()) {
+                cout << "Recv error: " << _rctx.error().message() << " " << _rctx.systemError().message() << endl;
+                server_error = true;
+                postStop(_rctx);
+                return;
+            }
+
+            for (size_t i = 0; i < _cnt; ++i) {
+                if (slots[i].segment_size != 0) {
+                    recv_datagram_count += (slots[i].len + slots[i].segment_size - 1) / slots[i].segment_size;
+                    coalesced_seen = true;
+                } else {
+                    ++recv_datagram_count;
+                }
+            }
+
+            if (!sock.sendTo(
+                    _rctx, slots, _cnt,
+                    [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                return;
+            }
+            if (_rctx.error()) {
+                break;
+            }
+        } while (
+            --repeatcnt && sock.recvFrom(
+                               _rctx, slots, SlotCount,
+                               [this](frame::aio::ReactorContext& _rctx, size_t _cnt) { onRecv(_rctx, _cnt); }, _cnt));
+
+        if (_rctx.error()) {
+            onSend(_rctx);
+        } else if (repeatcnt == 0) {
+            postRecv(_rctx);
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (!_rctx.error()) {
+            postRecv(_rctx);
+        } else {
+            cout << "Send error: " << _rctx.error().message() << " " << _rctx.systemError().message() << endl;
+            server_error = true;
+            postStop(_rctx);
+        }
+    }
+
+private:
+    using DatagramSocketT = frame::aio::Datagram<frame::aio::Socket>;
+
+    DatagramSocketT sock;
+    vector<char>    buf;
+    DatagramSlot    slots[SlotCount];
+};
+
+} //namespace
+
+int test_datagram_batch(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t round_count = 1000;
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+    }
+
+    //g - the last slot of every round is split by the kernel (GSO)
+    //r - the server receives the split datagrams coalesced (GRO)
+    bool segment   = false;
+    bool coalesced = false;
+    for (int i = 2; i < argc; ++i) {
+        if (*argv[i] == 'g') {
+            segment = true;
+        } else if (*argv[i] == 'r') {
+            coalesced = true;
+        }
+    }
+
+    const size_t batch_size = 8;
+
+    cout << "Test datagram batch with round_count = " << round_count << " segment = " << segment << " coalesced = " << coalesced << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, SocketInfo::Inet4, SocketInfo::Datagram);
+    SocketDevice  server_sd;
+    SocketDevice  client_sd;
+    SocketAddress server_address;
+
+    if (server_sd.create(rd.begin()) || server_sd.bind(rd.begin()) || server_sd.localAddress(server_address) || client_sd.create(rd.begin()) || client_sd.makeBlocking(2000)) {
+        cout << "Error creating the sockets" << endl;
+        return -1;
+    }
+
+    if (coalesced && server_sd.enableReceiveOffload()) {
+        cout << "Error enabling receive offload" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Talker(std::move(server_sd)));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    vector<char>   send_buf(batch_size * SlotCapacity);
+    DatagramSlot   send_slots[batch_size];
+    vector<size_t> expect_sizes;
+    size_t         seq          = 0;
+    size_t         recv_seq     = 0;
+    bool           data_differs = false;
+    char           recv_buf[SlotCapacity];
+
+    for (size_t round = 0; round < round_count && !data_differs; ++round) {
+        expect_sizes.clear();
+
+        for (size_t i = 0; i < batch_size; ++i) {
+            DatagramSlot& rslot = send_slots[i];
+
+            rslot      = DatagramSlot(send_buf.data() + i * SlotCapacity, SlotCapacity);
+            rslot.addr = server_address;
+
+            if (segment && i == (batch_size - 1)) {
+                rslot.segment_size = SegmentSize;
+                for (size_t j = 0; j < SegmentCount; ++j, ++seq) {
+                    memset(rslot.buf + rslot.len, datagram_char(seq), SegmentSize);
+                    rslot.len += SegmentSize;
+                    expect_sizes.push_back(SegmentSize);
+                }
+            } else {
+                rslot.len = datagram_size(seq);
+                memset(rslot.buf, datagram_char(seq), rslot.len);
+                expect_sizes.push_back(rslot.len);
+                ++seq;
+            }
+        }
+
+        size_t sent_cnt = 0;
+        while (sent_cnt < batch_size) {
+            bool       can_retry;
+            ErrorCodeT err;
+            ssize_t    rv = client_sd.send(send_slots + sent_cnt, batch_size - sent_cnt, can_retry, err);
+
+            if (rv <= 0) {
+                cout << "Error sending: " << err.message() << endl;
+                return -1;
+            }
+            sent_cnt += rv;
+        }
+
+        for (const size_t expect_size : expect_sizes) {
+            bool          can_retry;
+            ErrorCodeT    err;
+            SocketAddress addr;
+            ssize_t       rv = client_sd.recv(recv_buf, SlotCapacity, addr, can_retry, err);
+
+            if (rv <= 0) {
+                cout << "Error receiving: " << err.message() << endl;
+                return -1;
+            }
+            if (static_cast<size_t>(rv) != expect_size) {
+                data_differs = true;
+            }
+            for (ssize_t i = 0; i < rv; ++i) {
+                if (recv_buf[i] != datagram_char(recv_seq)) {
+                    data_differs = true;
+                }
+            }
+            ++recv_seq;
+        }
+    }
+
+    mgr.stop();
+
+    if (server_error) {
+        return -1;
+    }
+    if (data_differs || recv_seq != seq || recv_datagram_count != seq) {
+        cout << "Received datagrams differ: " << recv_seq << " " << recv_datagram_count << " != " << seq << endl;
+        return -1;
+    }
+    if (coalesced && segment && !coalesced_seen) {
+        cout << "No coalesced datagram received" << endl;
+        return -1;
+    }
+    return 0;
+}
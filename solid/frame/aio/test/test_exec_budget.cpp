@@ -0,0 +1,213 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+bool               done = false;
+atomic<bool>       failed(false);
+atomic<bool>       flooding(true);
+atomic<size_t>     flood_count(0);
+atomic<size_t>     tick_count(0);
+
+void busy_wait(const std::chrono::microseconds _dur)
+{
+    const auto end_tp = std::chrono::steady_clock::now() + _dur;
+    while (std::chrono::steady_clock::now() < end_tp) {
+    }
+}
+
+//Keeps thousands of posts queued - every post reposts itself
+class Flooder final : public Dynamic<Flooder, frame::aio::Object> {
+public:
+    Flooder(const size_t _queue_size)
+        : queue_size(_queue_size)
+        , post_seq(0)
+        , exec_seq(0)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            for (size_t i = 0; i < queue_size; ++i) {
+                doPost(_rctx);
+            }
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doPost(frame::aio::ReactorContext& _rctx)
+    {
+        const size_t seq = post_seq++;
+        post(_rctx, [this, seq](frame::aio::ReactorContext& _rctx, Event&& /*_revent*/) { onPost(_rctx, seq); });
+    }
+
+    void onPost(frame::aio::ReactorContext& _rctx, const size_t _seq)
+    {
+        //the budget must not reorder the posts of an object
+        if (_seq != exec_seq++) {
+            cout << "Post out of order: " << _seq << " != " << (exec_seq - 1) << endl;
+            failed = true;
+        }
+        ++flood_count;
+        busy_wait(std::chrono::microseconds(10));
+
+        if (flooding) {
+            doPost(_rctx);
+        }
+    }
+
+private:
+    const size_t queue_size;
+    size_t       post_seq;
+    size_t       exec_seq;
+};
+
+//A 1ms timer that must keep firing while the Flooder runs
+class Ticker final : public Dynamic<Ticker, frame::aio::Object> {
+public:
+    Ticker(const size_t _count)
+        : timer(this->proxy())
+        , count(_count)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postWait(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postWait(frame::aio::ReactorContext& _rctx)
+    {
+        timer.waitFor(
+            _rctx, std::chrono::milliseconds(1),
+            [this](frame::aio::ReactorContext& _rctx) { onTimer(_rctx); });
+    }
+
+    void onTimer(frame::aio::ReactorContext& _rctx)
+    {
+        ++tick_count;
+        if (--count != 0) {
+            postWait(_rctx);
+        } else {
+            flooding = false;
+            lock_guard<mutex> lock(mtx);
+            done = true;
+            cnd.notify_one();
+        }
+    }
+
+private:
+    frame::aio::SteadyTimer timer;
+    size_t                  count;
+};
+
+} //namespace
+
+int test_exec_budget(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t tick_count_limit = 100;
+    if (argc > 1) {
+        tick_count_limit = atoi(argv[1]);
+    }
+
+    cout << "Test exec budget with tick_count = " << tick_count_limit << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    //without a budget a loop would take about 10000 * 10us = 100ms
+    sch.execBudget(frame::ExecBudgetConfiguration(256, std::chrono::microseconds(2000), 64));
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    const auto start_tp = std::chrono::steady_clock::now();
+    {
+        DynamicPointer<frame::aio::Object> flooder_ptr(new Flooder(10000));
+        DynamicPointer<frame::aio::Object> ticker_ptr(new Ticker(tick_count_limit));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(flooder_ptr, svc, make_event(GenericEvents::Start), err);
+
+        if (!err) {
+            sch.startObject(ticker_ptr, svc, make_event(GenericEvents::Start), err);
+        }
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(30), []() { return done; })) {
+            cout << "Ticker starved: " << tick_count << " ticks" << endl;
+            return -1;
+        }
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_tp);
+
+    frame::ReactorStatisticVectorT stat_vec;
+
+    sch.statistics(stat_vec);
+    mgr.stop();
+
+    cout << "Ticks = " << tick_count << " in " << duration.count() << "ms flood posts = " << flood_count;
+    cout << " deferred = " << stat_vec.front().exec_deferred_count << " over share = " << stat_vec.front().exec_over_share_count << endl;
+
+    if (failed) {
+        return -1;
+    }
+
+    //a tick per loop of about 2ms, generous for loaded machines - without a budget it is one per 100ms
+    if (duration > std::chrono::milliseconds(tick_count_limit * 10)) {
+        cout << "Ticker delayed by the flooder" << endl;
+        return -1;
+    }
+
+    if (stat_vec.front().exec_deferred_count == 0 || stat_vec.front().exec_over_share_count == 0) {
+        cout << "Exec budget not applied" << endl;
+        return -1;
+    }
+    return 0;
+}
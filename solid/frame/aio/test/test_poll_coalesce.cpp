@@ -0,0 +1,231 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+atomic<size_t> echo_count(0);
+atomic<bool>   failed(false);
+
+const size_t toggle_count = 10;
+
+//Can change the reactor events it waits for - like frame::aio::openssl::Socket does
+class ToggleSocket : public frame::aio::Socket {
+public:
+    ToggleSocket(SocketDevice&& _rsd)
+        : frame::aio::Socket(std::move(_rsd))
+    {
+    }
+
+    void wait(frame::aio::ReactorContext& _rctx, const frame::aio::ReactorWaitRequestsE _req)
+    {
+        modifyReactorRequestEvents(_rctx, _req);
+    }
+};
+
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd)
+        : sock(this->proxy(), std::move(_usd))
+        , round(0)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postRecv(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecv(frame::aio::ReactorContext& _rctx)
+    {
+        sock.postRecvSome(
+            _rctx, buf, sizeof(buf),
+            [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, const size_t _sz)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+
+        if (round == 0) {
+            //a real change - applied before the next wait
+            sock.socket().wait(_rctx, frame::aio::ReactorWaitRead);
+        } else if (round == 1) {
+            //back to the events the stream registered with
+            sock.socket().wait(_rctx, frame::aio::ReactorWaitReadOrWrite);
+        } else {
+            //changes that cancel each other within the loop - never reach the kernel
+            for (size_t i = 0; i < toggle_count; ++i) {
+                sock.socket().wait(_rctx, (i & 1) != 0 ? frame::aio::ReactorWaitWrite : frame::aio::ReactorWaitRead);
+            }
+            sock.socket().wait(_rctx, frame::aio::ReactorWaitReadOrWrite);
+        }
+        ++round;
+
+        sock.postSendAll(
+            _rctx, buf, _sz,
+            [this](frame::aio::ReactorContext& _rctx) {
+                if (_rctx.error()) {
+                    failed = true;
+                    postStop(_rctx);
+                    return;
+                }
+                ++echo_count;
+                postRecv(_rctx);
+            });
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<ToggleSocket>;
+
+    StreamSocketT sock;
+    size_t        round;
+    char          buf[1024];
+};
+
+bool echo(SocketDevice& _rsd, const size_t _round)
+{
+    char       buf[256];
+    const char c = static_cast<char>('a' + _round % 26);
+
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = c;
+    }
+
+    bool       can_retry;
+    ErrorCodeT err;
+
+    if (_rsd.send(buf, sizeof(buf), can_retry, err) != sizeof(buf)) {
+        cout << "Error sending: " << err.message() << endl;
+        return false;
+    }
+
+    size_t recv_size = 0;
+    while (recv_size < sizeof(buf)) {
+        const ssize_t rv = _rsd.recv(buf, sizeof(buf) - recv_size, can_retry, err);
+
+        if (rv <= 0) {
+            cout << "Error receiving: " << err.message() << endl;
+            return false;
+        }
+        for (ssize_t i = 0; i < rv; ++i) {
+            if (buf[i] != c) {
+                cout << "Received data differs" << endl;
+                return false;
+            }
+        }
+        recv_size += rv;
+    }
+    return true;
+}
+
+} //namespace
+
+int test_poll_coalesce(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t round_count = 1000;
+    if (argc > 1) {
+        round_count = atoi(argv[1]);
+    }
+
+    cout << "Test poll coalesce with round_count = " << round_count << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd) || client_sd.makeBlocking(5000)) {
+        cout << "Error creating the connection" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd)));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    for (size_t i = 0; i < round_count; ++i) {
+        if (!echo(client_sd, i)) {
+            return -1;
+        }
+    }
+
+    frame::ReactorStatisticVectorT stat_vec;
+
+    sch.statistics(stat_vec);
+
+    client_sd.close();
+    mgr.stop();
+
+    cout << "Interest changes requested = " << stat_vec.front().poll_mod_request_count << " applied = " << stat_vec.front().poll_mod_count << endl;
+
+    if (failed || echo_count != round_count) {
+        cout << "Echo failed: " << echo_count << " != " << round_count << endl;
+        return -1;
+    }
+
+    if (round_count > 2 && stat_vec.front().poll_mod_request_count != (2 + (round_count - 2) * (toggle_count + 1))) {
+        cout << "Interest changes not counted" << endl;
+        return -1;
+    }
+
+#if defined(SOLID_USE_EPOLL)
+    //only the changes from the first two rounds reach epoll or io_uring
+    if (round_count > 2 && stat_vec.front().poll_mod_count != 2) {
+        cout << "Interest changes not coalesced" << endl;
+        return -1;
+    }
+#endif
+    return 0;
+}
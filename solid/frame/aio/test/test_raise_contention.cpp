@@ -0,0 +1,220 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             started_count = 0;
+size_t             done_count    = 0;
+atomic<bool>       failed(false);
+
+//Receives the events of a single producer and checks their order
+class Receiver final : public Dynamic<Receiver, frame::aio::Object> {
+public:
+    Receiver(const size_t _event_count)
+        : event_count_(_event_count)
+        , crt_count_(0)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_message == _revent) {
+            const size_t* pvalue = _revent.any().cast<size_t>();
+
+            if (pvalue == nullptr || *pvalue != crt_count_) {
+                failed = true;
+            }
+
+            ++crt_count_;
+
+            if (crt_count_ == event_count_) {
+                lock_guard<mutex> lock(mtx);
+                ++done_count;
+                cnd.notify_one();
+            }
+        } else if (generic_event_start == _revent) {
+            lock_guard<mutex> lock(mtx);
+            ++started_count;
+            cnd.notify_one();
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+private:
+    const size_t event_count_;
+    size_t       crt_count_;
+};
+
+} //namespace
+
+int test_raise_contention(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t producer_count = 1;
+    if (argc > 1) {
+        producer_count = atoi(argv[1]);
+        if (producer_count == 0) {
+            producer_count = 1;
+        }
+    }
+
+    size_t event_count = 100000;
+    if (argc > 2) {
+        event_count = atoi(argv[2]);
+    }
+
+    //non zero enables the reactor busy polling
+    size_t spin_max_usec = 0;
+    if (argc > 3) {
+        spin_max_usec = atoi(argv[3]);
+    }
+
+    cout << "Test raise contention with producer_count = " << producer_count << " event_count = " << event_count << " spin_max_usec = " << spin_max_usec << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    sch.busyPoll(frame::BusyPollConfiguration(std::chrono::microseconds(spin_max_usec)));
+    sch.timeCompletions(true);
+
+    //a single reactor, so that all producers contend on the same inbox
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    vector<frame::ObjectIdT> objuid_vec;
+
+    for (size_t i = 0; i < producer_count; ++i) {
+        DynamicPointer<frame::aio::Object> objptr(new Receiver(event_count));
+        solid::ErrorConditionT             err;
+
+        objuid_vec.push_back(sch.startObject(objptr, svc, make_event(GenericEvents::Start), err));
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        cnd.wait(lock, [producer_count]() { return started_count == producer_count; });
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    vector<thread> thread_vec;
+
+    for (size_t i = 0; i < producer_count; ++i) {
+        thread_vec.emplace_back(
+            [&mgr, &objuid_vec, event_count, i]() {
+                for (size_t j = 0; j < event_count; ++j) {
+                    if (!mgr.notify(objuid_vec[i], make_event(GenericEvents::Message, j))) {
+                        failed = true;
+                    }
+                }
+            });
+    }
+
+    for (auto& t : thread_vec) {
+        t.join();
+    }
+
+    const auto push_duration = std::chrono::steady_clock::now() - start_time;
+
+    bool timedout = false;
+    {
+        unique_lock<mutex> lock(mtx);
+
+        timedout = !cnd.wait_for(lock, std::chrono::seconds(120), [producer_count]() { return done_count == producer_count; });
+    }
+
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+
+    cout << "Push duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(push_duration).count() << "ms" << endl;
+    cout << "Duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << "ms" << endl;
+
+    frame::ReactorStatisticVectorT reactor_stat_vec;
+    sch.statistics(reactor_stat_vec);
+
+    if (spin_max_usec != 0) {
+        for (const auto& stat : reactor_stat_vec) {
+            cout << "Spin hit count = " << stat.spin_hit_count << " miss count = " << stat.spin_miss_count << endl;
+        }
+    }
+
+    mgr.stop();
+
+    if (reactor_stat_vec.size() != 1) {
+        cout << "No reactor statistics" << endl;
+        return -1;
+    }
+    {
+        const frame::ReactorStatistic& rstat       = reactor_stat_vec.front();
+        size_t                         timed_count = 0;
+
+        for (const auto cnt : rstat.completion_time_histogram) {
+            timed_count += cnt;
+        }
+
+        cout << "Iterations = " << rstat.iteration_count << " wait = " << rstat.wait_nsec / 1000000 << "ms busy = " << rstat.busy_nsec / 1000000 << "ms" << endl;
+        cout << "Events per wakeup = " << rstat.eventsPerWakeup() << " max = " << rstat.event_max << " exec queue max = " << rstat.exec_queue_max << endl;
+        cout << "Inbox count = " << rstat.inbox_count << " max = " << rstat.inbox_max << " completions = " << rstat.completion_count << " timed = " << timed_count << endl;
+
+        //every start and every event went through the inbox
+        if (rstat.inbox_count < producer_count * (event_count + 1) || rstat.iteration_count == 0 || timed_count == 0 || timed_count > rstat.completion_count) {
+            cout << "Wrong reactor statistics" << endl;
+            return -1;
+        }
+
+        const size_t spin_count = rstat.spin_hit_count + rstat.spin_miss_count;
+#if defined(SOLID_USE_EPOLL)
+        if ((spin_max_usec != 0) != (spin_count != 0)) {
+#else
+        if (spin_count != 0) {
+#endif
+            cout << "Wrong spin statistics" << endl;
+            return -1;
+        }
+    }
+
+    if (timedout) {
+        cout << "Timeout waiting for the events" << endl;
+        return -1;
+    }
+    if (failed) {
+        cout << "Events lost or out of order" << endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,275 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+//the object starts on reactor 0 - reactor 1 is any other thread
+atomic<thread::id> start_thread_id;
+atomic<thread::id> echo_thread_id;
+atomic<thread::id> timer_thread_id;
+atomic<size_t>     tick_count(0);
+atomic<size_t>     notify_count(0);
+atomic<bool>       echo_failed(false);
+
+bool runs_on(atomic<thread::id> const& _rthread_id, const size_t _reactor_index)
+{
+    return (_rthread_id.load() == start_thread_id.load()) == (_reactor_index == 0);
+}
+
+//Echoes the received data while a timer ticks - both must keep working after a move
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd)
+        : sock(this->proxy(), std::move(_usd))
+        , timer(this->proxy())
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            start_thread_id = this_thread::get_id();
+            echo_thread_id  = this_thread::get_id();
+            timer_thread_id = this_thread::get_id();
+            postRecv(_rctx);
+            postTick(_rctx);
+        } else if (generic_event_message == _revent) {
+            ++notify_count;
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecv(frame::aio::ReactorContext& _rctx)
+    {
+        sock.postRecvSome(
+            _rctx, buf, sizeof(buf),
+            [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        echo_thread_id = this_thread::get_id();
+
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+        if (sock.sendAll(
+                _rctx, buf, _sz,
+                [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+            onSend(_rctx);
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            cout << "Send error: " << _rctx.error().message() << endl;
+            echo_failed = true;
+            postStop(_rctx);
+        } else {
+            postRecv(_rctx);
+        }
+    }
+
+    void postTick(frame::aio::ReactorContext& _rctx)
+    {
+        timer.waitFor(
+            _rctx, std::chrono::milliseconds(5),
+            [this](frame::aio::ReactorContext& _rctx) { onTick(_rctx); });
+    }
+
+    void onTick(frame::aio::ReactorContext& _rctx)
+    {
+        timer_thread_id = this_thread::get_id();
+        ++tick_count;
+        postTick(_rctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT           sock;
+    frame::aio::SteadyTimer timer;
+    char                    buf[1024];
+};
+
+bool echo(SocketDevice& _rsd, const size_t _round)
+{
+    char       buf[256];
+    const char c = static_cast<char>('a' + _round % 26);
+
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = c;
+    }
+
+    bool       can_retry;
+    ErrorCodeT err;
+
+    if (_rsd.send(buf, sizeof(buf), can_retry, err) != sizeof(buf)) {
+        cout << "Error sending: " << err.message() << endl;
+        return false;
+    }
+
+    size_t recv_size = 0;
+    while (recv_size < sizeof(buf)) {
+        const ssize_t rv = _rsd.recv(buf, sizeof(buf) - recv_size, can_retry, err);
+
+        if (rv <= 0) {
+            cout << "Error receiving: " << err.message() << endl;
+            return false;
+        }
+        for (ssize_t i = 0; i < rv; ++i) {
+            if (buf[i] != c) {
+                cout << "Received data differs" << endl;
+                return false;
+            }
+        }
+        recv_size += rv;
+    }
+    return true;
+}
+
+} //namespace
+
+int test_reactor_migrate(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t migrate_count = 10;
+    if (argc > 1) {
+        migrate_count = atoi(argv[1]);
+    }
+
+    //r - let the scheduler move the object on its own
+    bool rebalance = false;
+    for (int i = 2; i < argc; ++i) {
+        if (*argv[i] == 'r') {
+            rebalance = true;
+        }
+    }
+
+    cout << "Test reactor migrate with migrate_count = " << migrate_count << " rebalance = " << rebalance << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (rebalance) {
+        //any busy time difference moves the object
+        sch.rebalance(frame::RebalanceConfiguration(std::chrono::milliseconds(10), 0, 0));
+    }
+
+    if (sch.start(2)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd) || client_sd.makeBlocking(5000)) {
+        cout << "Error creating the connection" << endl;
+        return -1;
+    }
+
+    frame::ObjectIdT objuid;
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd)));
+        solid::ErrorConditionT             err;
+
+        objuid = sch.startObject(objptr, svc, 0, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    size_t round       = 0;
+    size_t notify_sent = 0;
+
+    for (size_t i = 0; i < migrate_count; ++i) {
+        const size_t reactor_index = (i + 1) % 2;
+
+        if (!rebalance && !sch.migrateObject(mgr, objuid, reactor_index)) {
+            cout << "Error migrating object" << endl;
+            return -1;
+        }
+
+        const auto end_tp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        do {
+            if (!echo(client_sd, round++)) {
+                return -1;
+            }
+            if (mgr.notify(objuid, make_event(GenericEvents::Message))) {
+                ++notify_sent;
+            }
+            if (std::chrono::steady_clock::now() > end_tp) {
+                cout << "The object was not moved to reactor " << reactor_index << endl;
+                return -1;
+            }
+        } while (!runs_on(echo_thread_id, reactor_index) || !runs_on(timer_thread_id, reactor_index));
+
+        //the timer keeps ticking on the new reactor
+        const size_t ticks = tick_count;
+
+        this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        if (tick_count == ticks) {
+            cout << "The timer stopped after the move" << endl;
+            return -1;
+        }
+    }
+
+    //every notification reaches the object - the ones raised during a move are forwarded
+    const auto end_tp = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (notify_count != notify_sent && std::chrono::steady_clock::now() < end_tp) {
+        this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    mgr.stop();
+
+    if (echo_failed) {
+        return -1;
+    }
+    if (notify_count != notify_sent) {
+        cout << "Notifications lost: " << notify_count << " != " << notify_sent << endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/system/socketaddress.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             done_count = 0;
+atomic<size_t>     empty_count(0);
+
+struct ResolveF {
+    void operator()(ResolveData& _rrd, ErrorCodeT const& _rerr)
+    {
+        if (_rerr || _rrd.empty()) {
+            ++empty_count;
+        }
+        lock_guard<mutex> lock(mtx);
+        ++done_count;
+        cnd.notify_one();
+    }
+};
+
+bool wait_done(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+    return cnd.wait_for(lock, std::chrono::seconds(10), [_count]() { return done_count >= _count; }) || done_count >= _count;
+}
+
+//the names are from /etc/hosts or numeric - no DNS traffic
+void request(frame::aio::Resolver& _rresolver, const char* _host, const int _flags = 0)
+{
+    _rresolver.requestResolve(ResolveF(), _host, "0", _flags, SocketInfo::Inet4, SocketInfo::Stream);
+}
+
+} //namespace
+
+int test_resolver_cache(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t request_count = 1000;
+    if (argc > 1) {
+        request_count = atoi(argv[1]);
+    }
+
+    cout << "Test resolver cache with request_count = " << request_count << endl;
+
+    frame::aio::Resolver resolver;
+
+    resolver.cache(frame::aio::ResolverCacheConfiguration(
+        std::chrono::milliseconds(200), std::chrono::milliseconds(200), std::chrono::milliseconds(2000)));
+
+    if (resolver.start(4)) {
+        cout << "Error starting resolver" << endl;
+        return -1;
+    }
+
+    frame::aio::ResolverCacheStatistic stat;
+    size_t                             expect_done = 0;
+
+    //a burst for the same name - one lookup, the rest wait for it or hit the cache
+    for (size_t i = 0; i < request_count; ++i) {
+        request(resolver, "localhost");
+    }
+    expect_done += request_count;
+
+    if (!wait_done(expect_done) || empty_count != 0) {
+        cout << "Error resolving localhost: " << done_count << " " << empty_count << endl;
+        return -1;
+    }
+
+    resolver.cacheStatistic(stat);
+
+    if (stat.lookup_count != 1 || (stat.hit_count + stat.coalesced_count) != (request_count - 1)) {
+        cout << "Lookups not coalesced: " << stat.lookup_count << " " << stat.hit_count << " " << stat.coalesced_count << endl;
+        return -1;
+    }
+
+    //a name that cannot be resolved is cached too
+    for (size_t i = 0; i < 10; ++i) {
+        request(resolver, "not.a.numeric.host", DirectResoveInfo::NumericHost);
+        ++expect_done;
+        if (!wait_done(expect_done)) {
+            return -1;
+        }
+    }
+
+    resolver.cacheStatistic(stat);
+
+    if (empty_count != 10 || stat.lookup_count != 2 || stat.negative_hit_count != 9) {
+        cout << "Negative result not cached: " << empty_count << " " << stat.lookup_count << " " << stat.negative_hit_count << endl;
+        return -1;
+    }
+
+    //past ttl the old result is served while the entry is refreshed in background
+    this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    request(resolver, "localhost");
+    ++expect_done;
+
+    if (!wait_done(expect_done) || empty_count != 10) {
+        return -1;
+    }
+
+    resolver.cacheStatistic(stat);
+
+    if (stat.stale_hit_count != 1 || stat.lookup_count != 3) {
+        cout << "Stale entry not refreshed: " << stat.stale_hit_count << " " << stat.lookup_count << endl;
+        return -1;
+    }
+
+    //the refreshed entry is fresh again
+    const size_t hit_count = stat.hit_count;
+    const auto   end_tp    = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    do {
+        this_thread::sleep_for(std::chrono::milliseconds(10));
+        request(resolver, "localhost");
+        ++expect_done;
+
+        if (!wait_done(expect_done) || empty_count != 10) {
+            return -1;
+        }
+        resolver.cacheStatistic(stat);
+    } while (stat.hit_count == hit_count && std::chrono::steady_clock::now() < end_tp);
+
+    if (stat.hit_count == hit_count || stat.lookup_count != 3 || stat.entry_count != 2) {
+        cout << "Refresh failed: " << stat.lookup_count << " " << stat.entry_count << endl;
+        return -1;
+    }
+
+    resolver.stop();
+    return 0;
+}
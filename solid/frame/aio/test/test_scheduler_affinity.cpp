@@ -0,0 +1,142 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+
+#include "solid/system/thread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#if defined(SOLID_ON_LINUX)
+#include <sched.h>
+#endif
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             started_count = 0;
+atomic<bool>       failed(false);
+
+//Checks that it runs on the expected cpu
+class Checker final : public Dynamic<Checker, frame::aio::Object> {
+public:
+    Checker(const int _cpu)
+        : cpu_(_cpu)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+#if defined(SOLID_ON_LINUX)
+            if (sched_getcpu() != cpu_) {
+                cout << "Running on cpu " << sched_getcpu() << " instead of " << cpu_ << endl;
+                failed = true;
+            }
+#endif
+            lock_guard<mutex> lock(mtx);
+            ++started_count;
+            cnd.notify_one();
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    const int cpu_;
+};
+
+} //namespace
+
+int test_scheduler_affinity(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t reactor_count = 2;
+    if (argc > 1) {
+        reactor_count = atoi(argv[1]);
+    }
+
+    cout << "Test scheduler affinity with reactor_count = " << reactor_count << endl;
+
+    {
+        //a cpu that does not exist must make the start fail
+        AioSchedulerT sch;
+
+        sch.affinity(frame::AffinityConfiguration(std::vector<CpuSetT>{CpuSetT{1023}}));
+
+        if (!sch.start(reactor_count)) {
+            cout << "Scheduler started on an invalid cpu" << endl;
+            return -1;
+        }
+    }
+#if defined(SOLID_ON_LINUX)
+    {
+        //all the reactors on cpu 0, which always exists
+        AioSchedulerT   sch;
+        frame::Manager  mgr;
+        frame::ServiceT svc{mgr};
+
+        sch.affinity(frame::AffinityConfiguration(std::vector<CpuSetT>{CpuSetT{0}}));
+
+        if (sch.start(reactor_count)) {
+            cout << "Error starting scheduler" << endl;
+            return -1;
+        }
+
+        for (size_t i = 0; i < reactor_count; ++i) {
+            DynamicPointer<frame::aio::Object> objptr(new Checker(0));
+            solid::ErrorConditionT             err;
+
+            sch.startObject(objptr, svc, i, make_event(GenericEvents::Start), err);
+
+            if (err) {
+                cout << "Error starting object: " << err.message() << endl;
+                return -1;
+            }
+        }
+
+        {
+            unique_lock<mutex> lock(mtx);
+            while (started_count != reactor_count) {
+                cnd.wait(lock);
+            }
+        }
+        mgr.stop();
+    }
+    {
+        //all the reactors on the cpus of NUMA node 0
+        CpuSetT cpu_set;
+        if (numa_node_cpu_set(0, cpu_set)) {
+            cout << "No NUMA node 0 - skip" << endl;
+            return failed ? -1 : 0;
+        }
+
+        AioSchedulerT sch;
+
+        sch.affinity(frame::AffinityConfiguration::numaNode(0));
+
+        if (sch.start(reactor_count)) {
+            cout << "Error starting scheduler on NUMA node 0" << endl;
+            return -1;
+        }
+    }
+#endif
+    return failed ? -1 : 0;
+}
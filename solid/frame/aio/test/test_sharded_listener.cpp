@@ -0,0 +1,189 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aiolistener.hpp"
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             started_count  = 0;
+size_t             accepted_count = 0;
+bool               wrong_reactor  = false;
+vector<size_t>     accept_count_vec;
+
+//Counts the connections accepted on every reactor
+class Listener final : public Dynamic<Listener, frame::aio::Object> {
+public:
+    Listener(SocketDevice& _rsd)
+        : sock(this->proxy(), std::move(_rsd))
+        , reactor_index_(InvalidIndex())
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            reactor_index_ = _rctx.reactorIndex();
+            {
+                lock_guard<mutex> lock(mtx);
+                ++started_count;
+                cnd.notify_one();
+            }
+            sock.postAccept(
+                _rctx,
+                [this](frame::aio::ReactorContext& _rctx, SocketDevice& _rsd) { onAccept(_rctx, _rsd); });
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void onAccept(frame::aio::ReactorContext& _rctx, SocketDevice& _rsd)
+    {
+        do {
+            if (_rctx.error()) {
+                postStop(_rctx);
+                return;
+            }
+            _rsd.close();
+
+            lock_guard<mutex> lock(mtx);
+            if (_rctx.reactorIndex() != reactor_index_) {
+                wrong_reactor = true;
+            }
+            ++accept_count_vec[reactor_index_];
+            ++accepted_count;
+            cnd.notify_one();
+        } while (sock.accept(
+            _rctx, [this](frame::aio::ReactorContext& _rctx, SocketDevice& _rsd) { onAccept(_rctx, _rsd); }, _rsd));
+    }
+
+private:
+    frame::aio::Listener sock;
+    size_t               reactor_index_;
+};
+
+} //namespace
+
+int test_sharded_listener(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t reactor_count = 4;
+    if (argc > 1) {
+        reactor_count = atoi(argv[1]);
+        if (reactor_count == 0) {
+            reactor_count = 1;
+        }
+    }
+
+    size_t connection_count = 200;
+    if (argc > 2) {
+        connection_count = atoi(argv[2]);
+    }
+
+    cout << "Test sharded listener with reactor_count = " << reactor_count << " connection_count = " << connection_count << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(reactor_count)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    if (sch.reactorCount() != reactor_count) {
+        cout << "Wrong reactor count" << endl;
+        return -1;
+    }
+
+    accept_count_vec.resize(reactor_count, 0);
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketAddress local_address;
+    ErrorCodeT    sys_err;
+
+    ErrorConditionT err = frame::aio::start_sharded_listeners(
+        sch, svc, rd.begin(),
+        [](SocketDevice& _rsd) { return DynamicPointer<frame::aio::Object>(new Listener(_rsd)); },
+        local_address, sys_err);
+
+    if (err) {
+        cout << "Error starting listeners: " << err.message() << " " << sys_err.message() << endl;
+        return -1;
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        cnd.wait(lock, [reactor_count]() { return started_count == reactor_count; });
+    }
+
+    cout << "Listening on port " << local_address.port() << endl;
+
+    vector<SocketDevice> sd_vec(connection_count);
+
+    for (auto& sd : sd_vec) {
+        if (sd.create(rd.begin()) || sd.connect(local_address)) {
+            cout << "Error connecting" << endl;
+            return -1;
+        }
+    }
+
+    bool timedout = false;
+    {
+        unique_lock<mutex> lock(mtx);
+
+        timedout = !cnd.wait_for(lock, std::chrono::seconds(60), [connection_count]() { return accepted_count == connection_count; });
+    }
+
+    size_t used_reactor_count = 0;
+    for (size_t i = 0; i < reactor_count; ++i) {
+        cout << "Reactor " << i << " accepted " << accept_count_vec[i] << endl;
+        if (accept_count_vec[i] != 0) {
+            ++used_reactor_count;
+        }
+    }
+
+    mgr.stop();
+
+    if (timedout) {
+        cout << "Timeout waiting for the connections" << endl;
+        return -1;
+    }
+    if (wrong_reactor) {
+        cout << "Connection accepted on a different reactor" << endl;
+        return -1;
+    }
+    //the kernel hashes the connections over the sockets - with enough connections all should not land on one reactor
+    if (reactor_count > 1 && connection_count >= 100 && used_reactor_count < 2) {
+        cout << "Connections were not distributed among the reactors" << endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+//Echo connection using only scatter reads and gather writes
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd)
+        : sock(this->proxy(), std::move(_usd))
+        , send_iov_cnt(0)
+    {
+        //odd sized buffers so that the data is split at every possible offset
+        recv_iov[0].iov_base = buf;
+        recv_iov[0].iov_len  = 7;
+        recv_iov[1].iov_base = buf + 7;
+        recv_iov[1].iov_len  = 0;
+        recv_iov[2].iov_base = buf + 7;
+        recv_iov[2].iov_len  = 1000;
+        recv_iov[3].iov_base = buf + 1007;
+        recv_iov[3].iov_len  = BufferCapacity - 1007;
+    }
+
+private:
+    enum {
+        BufferCapacity = 1024 * 64,
+        SendChunkSize  = 331,
+        SendIovCount   = BufferCapacity / SendChunkSize + 1,
+    };
+
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postRecvSome(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecvSome(frame::aio::ReactorContext& _rctx)
+    {
+        sock.postRecvSome(
+            _rctx, recv_iov, 4,
+            [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+
+        send_iov_cnt = 0;
+        for (size_t off = 0; off < _sz; off += SendChunkSize) {
+            send_iov[send_iov_cnt].iov_base = buf + off;
+            send_iov[send_iov_cnt].iov_len  = (_sz - off) < SendChunkSize ? (_sz - off) : SendChunkSize;
+            ++send_iov_cnt;
+        }
+
+        if (sock.sendAll(
+                _rctx, send_iov, send_iov_cnt,
+                [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+            onSend(_rctx);
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            postStop(_rctx);
+            return;
+        }
+        postRecvSome(_rctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT sock;
+    char          buf[BufferCapacity];
+    IoVecT        recv_iov[4];
+    IoVecT        send_iov[SendIovCount];
+    size_t        send_iov_cnt;
+};
+
+} //namespace
+
+int test_stream_iov(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t data_size = 8 * 1024 * 1024;
+    if (argc > 1) {
+        data_size = atoi(argv[1]);
+    }
+
+    cout << "Test stream scatter/gather with data_size = " << data_size << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd)) {
+        cout << "Error creating the connection" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd)));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    string send_data;
+    send_data.reserve(data_size);
+    for (size_t i = 0; i < data_size; ++i) {
+        send_data += static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    bool send_failed = false;
+
+    //the client gathers the data from three buffers per call
+    thread send_thread(
+        [&client_sd, &send_data, &send_failed]() {
+            size_t off = 0;
+            while (off < send_data.size()) {
+                const size_t left = send_data.size() - off;
+                IoVecT       iov[3];
+
+                iov[0].iov_base = const_cast<char*>(send_data.data()) + off;
+                iov[0].iov_len  = left < 13 ? left : 13;
+                iov[1].iov_base = static_cast<char*>(iov[0].iov_base) + iov[0].iov_len;
+                iov[1].iov_len  = (left - iov[0].iov_len) < 4096 ? (left - iov[0].iov_len) : 4096;
+                iov[2].iov_base = static_cast<char*>(iov[1].iov_base) + iov[1].iov_len;
+                iov[2].iov_len  = left - iov[0].iov_len - iov[1].iov_len;
+
+                bool       can_retry;
+                ErrorCodeT err;
+                ssize_t    rv = client_sd.send(iov, 3, can_retry, err);
+
+                if (rv <= 0) {
+                    send_failed = true;
+                    break;
+                }
+                off += rv;
+            }
+        });
+
+    string recv_data;
+    char   buf[4096];
+
+    while (recv_data.size() < data_size) {
+        IoVecT iov[2];
+
+        iov[0].iov_base = buf;
+        iov[0].iov_len  = 100;
+        iov[1].iov_base = buf + 100;
+        iov[1].iov_len  = sizeof(buf) - 100;
+
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = client_sd.recv(iov, 2, can_retry, err);
+
+        if (rv <= 0) {
+            break;
+        }
+        recv_data.append(buf, rv);
+    }
+
+    send_thread.join();
+
+    mgr.stop();
+
+    if (send_failed) {
+        cout << "Error sending data" << endl;
+        return -1;
+    }
+    if (recv_data != send_data) {
+        cout << "Received data differs: " << recv_data.size() << " != " << send_data.size() << endl;
+        return -1;
+    }
+    return 0;
+}
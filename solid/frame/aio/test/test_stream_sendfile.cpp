@@ -0,0 +1,196 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/filedevice.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+atomic<bool> file_end_error(false);
+atomic<bool> other_error(false);
+
+//Sends [offset, offset + length) of a file then closes the connection
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd, FileDevice&& _ufd, const int64_t _offset, const size_t _length)
+        : sock(this->proxy(), std::move(_usd))
+        , fd(std::move(_ufd))
+        , offset(_offset)
+        , length(_length)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            if (sock.sendFile(
+                    _rctx, fd, offset, length,
+                    [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                onSend(_rctx);
+            }
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error() == frame::aio::error_stream_file_end) {
+            file_end_error = true;
+        } else if (_rctx.error()) {
+            other_error = true;
+        }
+        postStop(_rctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT sock;
+    FileDevice    fd;
+    const int64_t offset;
+    const size_t  length;
+};
+
+//Returns the data received until the peer closes the connection
+bool transfer(AioSchedulerT& _rsch, frame::ServiceT& _rsvc, const char* _fname, const int64_t _offset, const size_t _length, string& _rrecv_data)
+{
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+    FileDevice    fd;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd)) {
+        cout << "Error creating the connection" << endl;
+        return false;
+    }
+
+    if (!fd.open(_fname, FileDevice::ReadOnlyE)) {
+        cout << "Error opening file" << endl;
+        return false;
+    }
+
+    {
+        //the pointer must not outlive the start - the connection is closed when the object gets destroyed
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd), std::move(fd), _offset, _length));
+        solid::ErrorConditionT             err;
+
+        _rsch.startObject(objptr, _rsvc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return false;
+        }
+    }
+
+    char buf[4096];
+
+    _rrecv_data.clear();
+    while (true) {
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = client_sd.recv(buf, sizeof(buf), can_retry, err);
+
+        if (rv <= 0) {
+            break;
+        }
+        _rrecv_data.append(buf, rv);
+    }
+    return true;
+}
+
+} //namespace
+
+int test_stream_sendfile(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t file_size = 8 * 1024 * 1024 + 123;
+    if (argc > 1) {
+        file_size = atoi(argv[1]);
+    }
+
+    cout << "Test stream sendFile with file_size = " << file_size << endl;
+
+    const char* fname = "test_stream_sendfile.data";
+    string      file_data;
+
+    file_data.reserve(file_size);
+    for (size_t i = 0; i < file_size; ++i) {
+        file_data += static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    {
+        FileDevice fd;
+        if (!fd.create(fname, FileDevice::WriteOnlyE) || fd.write(file_data.data(), file_data.size()) != static_cast<ssize_t>(file_data.size())) {
+            cout << "Error creating the file" << endl;
+            return -1;
+        }
+    }
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+    int             rv = 0;
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    string recv_data;
+
+    //the whole file
+    if (!transfer(sch, svc, fname, 0, file_size, recv_data) || recv_data != file_data || file_end_error || other_error) {
+        cout << "Whole file transfer failed: " << recv_data.size() << " != " << file_data.size() << endl;
+        rv = -1;
+    }
+
+    //a range in the middle of the file
+    const int64_t offset = file_size / 3;
+    const size_t  length = file_size / 3;
+
+    if (rv == 0 && (!transfer(sch, svc, fname, offset, length, recv_data) || recv_data != file_data.substr(offset, length) || file_end_error || other_error)) {
+        cout << "Range transfer failed: " << recv_data.size() << " != " << length << endl;
+        rv = -1;
+    }
+
+    //more than the file has - the data is sent then the completion gets error_stream_file_end
+    if (rv == 0 && (!transfer(sch, svc, fname, offset, file_size, recv_data) || recv_data != file_data.substr(offset) || !file_end_error || other_error)) {
+        cout << "Past end transfer failed: " << recv_data.size() << " != " << (file_size - offset) << " file_end_error = " << file_end_error << endl;
+        rv = -1;
+    }
+
+    mgr.stop();
+
+    remove(fname);
+
+    return rv;
+}
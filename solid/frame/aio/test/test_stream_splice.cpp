@@ -0,0 +1,245 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/pipedevice.hpp"
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+atomic<bool> shutdown_seen(false);
+atomic<bool> other_error(false);
+
+//Forwards everything received on sock1 to sock2 through a kernel pipe, until sock1 is closed
+class Forwarder final : public Dynamic<Forwarder, frame::aio::Object> {
+public:
+    Forwarder(SocketDevice&& _usd1, SocketDevice&& _usd2, const size_t _pipe_capacity)
+        : sock1(this->proxy(), std::move(_usd1))
+        , sock2(this->proxy(), std::move(_usd2))
+        , pipe_capacity(_pipe_capacity)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            if (pipe.create(pipe_capacity)) {
+                other_error = true;
+                postStop(_rctx);
+                return;
+            }
+            postRecv(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postRecv(frame::aio::ReactorContext& _rctx)
+    {
+        sock1.postRecvSome(
+            _rctx, pipe,
+            [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); });
+    }
+
+    void onRecv(frame::aio::ReactorContext& _rctx, size_t _sz)
+    {
+        if (!_rctx.error()) {
+            if (sock2.sendAll(
+                    _rctx, pipe,
+                    [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                onSend(_rctx);
+            }
+            return;
+        }
+        done(_rctx);
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        size_t repeatcnt = 16;
+        size_t sz;
+
+        //the pipe is drained - forward a few more chunks synchronously before going through the reactor
+        while (!_rctx.error() && repeatcnt--) {
+            if (!sock1.recvSome(
+                    _rctx, pipe,
+                    [this](frame::aio::ReactorContext& _rctx, size_t _sz) { onRecv(_rctx, _sz); }, sz)) {
+                return;
+            }
+            if (_rctx.error()) {
+                break;
+            }
+            if (!sock2.sendAll(
+                    _rctx, pipe,
+                    [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                return;
+            }
+        }
+
+        if (_rctx.error()) {
+            done(_rctx);
+        } else {
+            postRecv(_rctx);
+        }
+    }
+
+    void done(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error() == frame::aio::error_stream_shutdown) {
+            shutdown_seen = true;
+        } else {
+            cout << "Forward error: " << _rctx.error().message() << " " << _rctx.systemError().message() << endl;
+            other_error = true;
+        }
+        postStop(_rctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT sock1;
+    StreamSocketT sock2;
+    PipeDevice    pipe;
+    const size_t  pipe_capacity;
+};
+
+bool connect_pair(const ResolveData& _rrd, SocketDevice& _rclient_sd, SocketDevice& _rserver_sd)
+{
+    SocketDevice  listen_sd;
+    SocketAddress local_address;
+
+    return !(listen_sd.create(_rrd.begin()) || listen_sd.prepareAccept(_rrd.begin()) || listen_sd.localAddress(local_address) || _rclient_sd.create(_rrd.begin()) || _rclient_sd.connect(local_address) || listen_sd.accept(_rserver_sd));
+}
+
+} //namespace
+
+int test_stream_splice(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t data_size = 8 * 1024 * 1024 + 123;
+    if (argc > 1) {
+        data_size = atoi(argv[1]);
+    }
+
+    //a small pipe makes the backpressure path run often
+    size_t pipe_capacity = 4096;
+    if (argc > 2) {
+        pipe_capacity = atoi(argv[2]);
+    }
+
+    cout << "Test stream splice with data_size = " << data_size << " pipe_capacity = " << pipe_capacity << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData  rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice in_client_sd;
+    SocketDevice in_server_sd;
+    SocketDevice out_client_sd;
+    SocketDevice out_server_sd;
+
+    if (!connect_pair(rd, in_client_sd, in_server_sd) || !connect_pair(rd, out_client_sd, out_server_sd)) {
+        cout << "Error creating the connections" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Forwarder(std::move(in_server_sd), std::move(out_server_sd), pipe_capacity));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    string send_data;
+    send_data.reserve(data_size);
+    for (size_t i = 0; i < data_size; ++i) {
+        send_data += static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    bool send_failed = false;
+
+    thread send_thread(
+        [&in_client_sd, &send_data, &send_failed]() {
+            size_t off = 0;
+            while (off < send_data.size()) {
+                bool       can_retry;
+                ErrorCodeT err;
+                ssize_t    rv = in_client_sd.send(send_data.data() + off, send_data.size() - off, can_retry, err);
+
+                if (rv <= 0) {
+                    send_failed = true;
+                    break;
+                }
+                off += rv;
+            }
+            //the forwarder sees the end of the stream and closes the outgoing connection
+            in_client_sd.shutdownWrite();
+        });
+
+    string recv_data;
+    char   buf[4096];
+
+    while (true) {
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = out_client_sd.recv(buf, sizeof(buf), can_retry, err);
+
+        if (rv <= 0) {
+            break;
+        }
+        recv_data.append(buf, rv);
+    }
+
+    send_thread.join();
+
+    mgr.stop();
+
+    if (send_failed) {
+        cout << "Error sending data" << endl;
+        return -1;
+    }
+    if (recv_data != send_data) {
+        cout << "Received data differs: " << recv_data.size() << " != " << send_data.size() << endl;
+        return -1;
+    }
+    if (!shutdown_seen || other_error) {
+        cout << "The forwarder did not end with the peer shutdown" << endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiosocket.hpp"
+#include "solid/frame/aio/aiostream.hpp"
+
+#include "solid/system/socketaddress.hpp"
+#include "solid/system/socketdevice.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+atomic<bool> enable_failed(false);
+atomic<bool> send_failed(false);
+
+char data_at(const size_t _off)
+{
+    return static_cast<char>('a' + (_off * 7) % 26);
+}
+
+//Sends all the data reusing a single chunk buffer - the next chunk is only written after the send completion
+class Connection final : public Dynamic<Connection, frame::aio::Object> {
+public:
+    Connection(SocketDevice&& _usd, const size_t _data_size, const size_t _chunk_size)
+        : sock(this->proxy(), std::move(_usd))
+        , data_size(_data_size)
+        , data_off(0)
+        , chunk(_chunk_size)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            ErrorCodeT err = sock.enableZeroCopy(16 * 1024);
+            if (err) {
+                cout << "Error enabling zero copy: " << err.message() << endl;
+                enable_failed = true;
+                postStop(_rctx);
+                return;
+            }
+            doSendNext(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void doSendNext(frame::aio::ReactorContext& _rctx)
+    {
+        while (data_off < data_size) {
+            const size_t sz = (data_size - data_off) < chunk.size() ? (data_size - data_off) : chunk.size();
+
+            for (size_t i = 0; i < sz; ++i) {
+                chunk[i] = data_at(data_off + i);
+            }
+            data_off += sz;
+
+            if (!sock.sendAll(
+                    _rctx, chunk.data(), sz,
+                    [this](frame::aio::ReactorContext& _rctx) { onSend(_rctx); })) {
+                return;
+            }
+            if (_rctx.error()) {
+                break;
+            }
+        }
+        done(_rctx);
+    }
+
+    void onSend(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            done(_rctx);
+        } else {
+            doSendNext(_rctx);
+        }
+    }
+
+    void done(frame::aio::ReactorContext& _rctx)
+    {
+        if (_rctx.error()) {
+            cout << "Send error: " << _rctx.error().message() << " " << _rctx.systemError().message() << endl;
+            send_failed = true;
+        }
+        postStop(_rctx);
+    }
+
+private:
+    using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
+
+    StreamSocketT sock;
+    const size_t  data_size;
+    size_t        data_off;
+    vector<char>  chunk;
+};
+
+} //namespace
+
+int test_stream_zerocopy(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t data_size = 32 * 1024 * 1024;
+    if (argc > 1) {
+        data_size = atoi(argv[1]);
+    }
+
+    size_t chunk_size = 256 * 1024;
+    if (argc > 2) {
+        chunk_size = atoi(argv[2]);
+    }
+
+    cout << "Test stream zero copy with data_size = " << data_size << " chunk_size = " << chunk_size << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    ResolveData   rd = synchronous_resolve("127.0.0.1", "0", 0, -1, SocketInfo::Stream);
+    SocketDevice  listen_sd;
+    SocketDevice  client_sd;
+    SocketDevice  server_sd;
+    SocketAddress local_address;
+
+    if (
+        listen_sd.create(rd.begin()) || listen_sd.prepareAccept(rd.begin()) || listen_sd.localAddress(local_address) || client_sd.create(rd.begin()) || client_sd.connect(local_address) || listen_sd.accept(server_sd)) {
+        cout << "Error creating the connection" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Connection(std::move(server_sd), data_size, chunk_size));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    //a slow reader keeps the sent pages pinned while the sender waits for the notifications
+    size_t recv_size    = 0;
+    bool   data_differs = false;
+    char   buf[1024];
+
+    while (true) {
+        bool       can_retry;
+        ErrorCodeT err;
+        ssize_t    rv = client_sd.recv(buf, sizeof(buf), can_retry, err);
+
+        if (rv <= 0) {
+            break;
+        }
+        for (ssize_t i = 0; i < rv; ++i) {
+            if (buf[i] != data_at(recv_size + i)) {
+                data_differs = true;
+            }
+        }
+        recv_size += rv;
+    }
+
+    mgr.stop();
+
+    if (enable_failed || send_failed) {
+        return -1;
+    }
+    if (recv_size != data_size || data_differs) {
+        cout << "Received data differs: " << recv_size << " != " << data_size << endl;
+        return -1;
+    }
+    return 0;
+}
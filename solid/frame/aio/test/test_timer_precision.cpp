@@ -0,0 +1,167 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+using TimePointT = std::chrono::steady_clock::time_point;
+
+mutex              mtx;
+condition_variable cnd;
+bool               done = false;
+atomic<bool>       failed(false);
+atomic<int64_t>    late_nsec(0);
+atomic<int64_t>    late_max_nsec(0);
+
+//Paces itself with sub-millisecond timers
+class Pacer final : public Dynamic<Pacer, frame::aio::Object> {
+public:
+    Pacer(const size_t _count)
+        : timer(this->proxy())
+        , count(_count)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            postWait(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void postWait(frame::aio::ReactorContext& _rctx)
+    {
+        //100us to 500us
+        const std::chrono::microseconds wait(100 + (count % 5) * 100);
+
+        expire_tp = std::chrono::steady_clock::now() + wait;
+
+        timer.waitUntil(
+            _rctx, expire_tp,
+            [this](frame::aio::ReactorContext& _rctx) { onTimer(_rctx); });
+    }
+
+    void onTimer(frame::aio::ReactorContext& _rctx)
+    {
+        const TimePointT now  = std::chrono::steady_clock::now();
+        const int64_t    late = std::chrono::duration_cast<std::chrono::nanoseconds>(now - expire_tp).count();
+
+        if (_rctx.error() || late < 0) {
+            cout << "Timer fired early by " << -late << "ns" << endl;
+            failed = true;
+        }
+
+        late_nsec += late;
+        if (late > late_max_nsec) {
+            late_max_nsec = late;
+        }
+
+        if (--count != 0) {
+            postWait(_rctx);
+        } else {
+            lock_guard<mutex> lock(mtx);
+            done = true;
+            cnd.notify_one();
+        }
+    }
+
+private:
+    frame::aio::SteadyTimer timer;
+    size_t                  count;
+    TimePointT              expire_tp;
+};
+
+} //namespace
+
+int test_timer_precision(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t wait_count = 1000;
+    if (argc > 1) {
+        wait_count = atoi(argv[1]);
+    }
+
+    cout << "Test timer precision with wait_count = " << wait_count << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(1)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    {
+        DynamicPointer<frame::aio::Object> objptr(new Pacer(wait_count));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(30), []() { return done; })) {
+            cout << "Timers not done" << endl;
+            return -1;
+        }
+    }
+
+    frame::ReactorStatisticVectorT stat_vec;
+
+    sch.statistics(stat_vec);
+    mgr.stop();
+
+    const int64_t late_avg_nsec = late_nsec / static_cast<int64_t>(wait_count);
+
+    cout << "Late average = " << late_avg_nsec << "ns max = " << late_max_nsec << "ns iterations = " << stat_vec.front().iteration_count << endl;
+
+    if (failed) {
+        return -1;
+    }
+
+    //the reactor must block until the timer expires - not poll for it
+    if (stat_vec.front().iteration_count > (wait_count * 4)) {
+        cout << "Too many reactor iterations" << endl;
+        return -1;
+    }
+#if defined(SOLID_USE_IO_URING) || defined(SOLID_USE_EPOLL_PWAIT2)
+    //generous for loaded machines - a millisecond resolution would be late by about 500us on average
+    if (late_avg_nsec > 300 * 1000) {
+        cout << "Timers not precise" << endl;
+        return -1;
+    }
+#endif
+    return 0;
+}
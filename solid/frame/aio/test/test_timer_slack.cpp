@@ -0,0 +1,149 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioreactorcontext.hpp"
+#include "solid/frame/aio/aiotimer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "solid/system/log.hpp"
+
+#include "solid/utility/event.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+
+namespace {
+
+using TimePointT = std::chrono::steady_clock::time_point;
+
+mutex              mtx;
+condition_variable cnd;
+size_t             done_count = 0;
+atomic<bool>       failed(false);
+
+const std::chrono::milliseconds timeout(100);
+const std::chrono::milliseconds slack(50);
+
+//Re-arms a slack timer like a keepalive timer on every "send", then waits for it to fire
+class Waiter final : public Dynamic<Waiter, frame::aio::Object> {
+public:
+    Waiter(const size_t _rearm_count)
+        : timer(this->proxy())
+        , tick_timer(this->proxy())
+        , rearm_count(_rearm_count)
+    {
+    }
+
+private:
+    void onEvent(frame::aio::ReactorContext& _rctx, Event&& _revent) override
+    {
+        if (generic_event_start == _revent) {
+            onTick(_rctx);
+        } else if (generic_event_kill == _revent) {
+            postStop(_rctx);
+        }
+    }
+
+    void onTick(frame::aio::ReactorContext& _rctx)
+    {
+        //only the last callback may be called
+        const size_t count = rearm_count;
+
+        expire_tp = _rctx.steadyTime() + timeout;
+
+        timer.waitFor(
+            _rctx, timeout, slack,
+            [this, count](frame::aio::ReactorContext& _rctx) { onTimer(_rctx, count); });
+
+        if (rearm_count != 0) {
+            --rearm_count;
+            tick_timer.waitFor(
+                _rctx, std::chrono::milliseconds(2),
+                [this](frame::aio::ReactorContext& _rctx) { onTick(_rctx); });
+        }
+    }
+
+    void onTimer(frame::aio::ReactorContext& _rctx, const size_t _count)
+    {
+        const TimePointT now = std::chrono::steady_clock::now();
+
+        if (_rctx.error() || _count != 0 || rearm_count != 0) {
+            cout << "Wrong timer callback: " << _count << " " << rearm_count << endl;
+            failed = true;
+        } else if (now < expire_tp) {
+            cout << "Timer fired early by " << std::chrono::duration_cast<std::chrono::microseconds>(expire_tp - now).count() << "us" << endl;
+            failed = true;
+        } else if (now > (expire_tp + slack + std::chrono::milliseconds(100))) {
+            cout << "Timer fired late by " << std::chrono::duration_cast<std::chrono::milliseconds>(now - expire_tp).count() << "ms" << endl;
+            failed = true;
+        }
+        lock_guard<mutex> lock(mtx);
+        ++done_count;
+        cnd.notify_one();
+    }
+
+private:
+    frame::aio::SteadyTimer timer;
+    frame::aio::SteadyTimer tick_timer;
+    size_t                  rearm_count;
+    TimePointT              expire_tp;
+};
+
+} //namespace
+
+int test_timer_slack(int argc, char* argv[])
+{
+    solid::log_start(std::cerr, {"solid::frame::aio.*:EW"});
+
+    size_t object_count = 100;
+    if (argc > 1) {
+        object_count = atoi(argv[1]);
+    }
+
+    cout << "Test timer slack with object_count = " << object_count << endl;
+
+    AioSchedulerT   sch;
+    frame::Manager  mgr;
+    frame::ServiceT svc{mgr};
+
+    if (sch.start(2)) {
+        cout << "Error starting scheduler" << endl;
+        return -1;
+    }
+
+    for (size_t i = 0; i < object_count; ++i) {
+        DynamicPointer<frame::aio::Object> objptr(new Waiter(i % 40));
+        solid::ErrorConditionT             err;
+
+        sch.startObject(objptr, svc, make_event(GenericEvents::Start), err);
+
+        if (err) {
+            cout << "Error starting object: " << err.message() << endl;
+            return -1;
+        }
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(10), [object_count]() { return done_count == object_count; })) {
+            cout << "Timers not fired: " << done_count << " != " << object_count << endl;
+            return -1;
+        }
+    }
+
+    mgr.stop();
+
+    return failed ? -1 : 0;
+}
@@ -147,6 +147,11 @@ struct File {
     {
         return ptmp;
     }
+    //! The file device for non temporary files - e.g. for aio::Stream::sendFile
+    FileDevice* device()
+    {
+        return ptmp == nullptr ? &fd : nullptr;
+    }
 
 private:
     friend struct Utf8Controller;
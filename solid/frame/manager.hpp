@@ -171,6 +171,24 @@ private:
         ScheduleFunctionT& _rfct,
         ErrorConditionT&   _rerr);
 
+    //! Registers the objects at positions _ppos[0, _count) of _pobjs and schedules them with one _rfct call
+    /*!
+        On success _pobjuids[_ppos[i]] gets the id of the object at _pobjs[_ppos[i]].
+    */
+    size_t registerObjects(
+        const Service&          _rsvc,
+        ObjectBase* const*      _pobjs,
+        ObjectIdT*              _pobjuids,
+        const size_t*           _ppos,
+        const size_t            _count,
+        ReactorBase&            _rr,
+        ScheduleBatchFunctionT& _rfct,
+        ErrorConditionT&        _rerr);
+
+    bool migrateObject(ObjectIdT const& _ruid, SchedulerBase& _rsch, const size_t _reactor_index);
+
+    bool moveObject(ObjectBase& _robj, ReactorBase& _rfrom, ReactorBase& _rto, ScheduleFunctionT& _rfct);
+
     size_t notifyAll(const Service& _rsvc, Event const& _revt);
 
     template <typename F>
@@ -78,6 +78,8 @@ inline void setup(mpipc::Configuration& _rcfg, size_t _buff_threshold = 1024, si
 {
     _rcfg.reader.decompress_fnc       = Engine(_buff_threshold, _diff_threshold);
     _rcfg.writer.inplace_compress_fnc = Engine(_buff_threshold, _diff_threshold);
+    //relayed data sent by reference cannot be compressed
+    _rcfg.writer.relayed_reference_threshold = InvalidSize();
 }
 
 } //namespace snappy
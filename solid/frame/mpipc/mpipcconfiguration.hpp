@@ -333,11 +333,17 @@ struct WriterConfiguration {
     size_t max_message_count_multiplex;
     size_t max_message_count_response_wait;
     size_t max_message_continuous_packet_count;
+    //while messages of both priority classes wait to be sent, this many
+    //MessageFlagsE::HighPriority message chunks are written for every
+    //normal priority one - 0 means no priority
+    size_t high_priority_weight;
 
     size_t   string_size_limit;
     size_t   container_size_limit;
     uint64_t stream_size_limit;
 
+    size_t relayed_reference_threshold; //relayed data chunks of at least this many bytes are sent from the relay buffer, uncompressed
+
     CompressFunctionT inplace_compress_fnc;
 };
 
@@ -351,7 +357,7 @@ public:
     Configuration(
         AioSchedulerT&      _rsch,
         std::shared_ptr<P>& _rprotcol_ptr)
-        : pools_mutex_count(16)
+        : pools_mutex_count(0)
         , protocol_ptr(std::static_pointer_cast<Protocol>(_rprotcol_ptr))
         , pscheduler(&_rsch)
         , prelayengine(&RelayEngine::instance())
@@ -364,7 +370,7 @@ public:
         AioSchedulerT&      _rsch,
         RelayEngine&        _rrelayengine,
         std::shared_ptr<P>& _rprotcol_ptr)
-        : pools_mutex_count(16)
+        : pools_mutex_count(0)
         , protocol_ptr(std::static_pointer_cast<Protocol>(_rprotcol_ptr))
         , pscheduler(&_rsch)
         , prelayengine(&_rrelayengine)
@@ -446,7 +452,7 @@ public:
     size_t pool_max_pending_connection_count;
     size_t pool_max_message_queue_size;
 
-    size_t pools_mutex_count;
+    size_t pools_mutex_count; //zero means 4 per hardware thread but no less than 16
     bool   relay_enabled;
 
     ReaderConfiguration reader;
@@ -457,7 +463,8 @@ public:
         using ConnectionSecureHandshakeFunctionT = SOLID_FUNCTION(void(ConnectionContext&));
 
         Server()
-            : listener_port(-1)
+            : listener_sharded(false)
+            , listener_port(-1)
         {
         }
 
@@ -475,6 +482,9 @@ public:
         std::string                        listener_address_str;
         std::string                        listener_service_str;
         Any<>                              secure_any;
+        //one SO_REUSEPORT listener on every reactor of the scheduler,
+        //the accepted connections stay on the reactor of their listener
+        bool listener_sharded;
 
         int listenerPort() const
         {
@@ -516,6 +526,7 @@ public:
     uint8_t                       connection_recv_buffer_max_capacity_kb;
     uint8_t                       connection_send_buffer_start_capacity_kb;
     uint8_t                       connection_send_buffer_max_capacity_kb;
+    size_t                        connection_send_zero_copy_threshold; //non zero: sends of at least this many bytes use MSG_ZEROCOPY - Linux, plain sockets only
     uint16_t                      connection_relay_buffer_count;
     ExtractRecipientNameFunctionT extract_recipient_name_fnc;
     ConnectionStopFunctionT       connection_stop_fnc;
@@ -17,6 +17,7 @@
 #include "solid/utility/dynamicpointer.hpp"
 
 #include <ostream>
+#include <vector>
 
 #include "solid/frame/common.hpp"
 
@@ -227,6 +228,8 @@ private:
 
 std::ostream& operator<<(std::ostream& _ros, MessageId const& _msguid);
 
+using MessageIdVectorT = std::vector<MessageId>;
+
 class Service;
 class Connection;
 struct Configuration;
@@ -209,6 +209,11 @@ struct Message : std::enable_shared_from_this<Message> {
         return _flags.has(MessageFlagsE::Relayed);
     }
 
+    static bool is_high_priority(const MessageFlagsT& _flags)
+    {
+        return _flags.has(MessageFlagsE::HighPriority);
+    }
+
     static MessageFlagsT clear_state_flags(MessageFlagsT _flags)
     {
         _flags.reset(MessageFlagsE::OnPeer).reset(MessageFlagsE::BackOnSender).reset(MessageFlagsE::Relayed);
@@ -30,6 +30,7 @@ enum struct MessageFlagsE : MessageFlagsValueT {
     OnPeer,
     BackOnSender,
     Relayed,
+    HighPriority,
     LastFlag
 };
 
@@ -133,6 +133,44 @@ public:
         MessageId&                _rmsg_id,
         const MessageFlagsT&      _flags = 0);
 
+    // send a batch of messages using recipient name -------------------------
+    //! Send all the messages in [_first, _last) to the same recipient
+    /*!
+        The range holds std::shared_ptr<T> to messages and all of them are
+        sent with the same _flags. The batch is queued on the connection
+        pool under a single lock and with a single connection wakeup.
+        The messages are checked before any of them is queued, so on error
+        none is sent - e.g. error_service_pool_full if the pool has no room
+        for the whole batch or error_service_unknown_connection if the
+        recipient connection is gone.
+    */
+    template <class It>
+    ErrorConditionT sendMessages(
+        const char*          _recipient_url,
+        It                   _first,
+        It                   _last,
+        const MessageFlagsT& _flags = 0);
+
+    //! Also returns the recipient and, in _rmsg_id_vec, the id of every message
+    template <class It>
+    ErrorConditionT sendMessages(
+        const char*          _recipient_url,
+        It                   _first,
+        It                   _last,
+        RecipientId&         _rrecipient_id,
+        MessageIdVectorT&    _rmsg_id_vec,
+        const MessageFlagsT& _flags = 0);
+
+    // send a batch of messages using connection uid --------------------------
+
+    template <class It>
+    ErrorConditionT sendMessages(
+        RecipientId const&   _rrecipient_id,
+        It                   _first,
+        It                   _last,
+        MessageIdVectorT&    _rmsg_id_vec,
+        const MessageFlagsT& _flags = 0);
+
     // send request using recipient name --------------------------------------
 
     template <class T, class Fnc>
@@ -313,7 +351,7 @@ private:
 
     ErrorConditionT doStart();
 
-    void acceptIncomingConnection(SocketDevice& _rsd);
+    void acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index);
 
     ErrorConditionT activateConnection(Connection& _rcon, ObjectIdT const& _robjuid);
 
@@ -426,6 +464,20 @@ private:
         MessageId*                _pmsg_id_out,
         const MessageFlagsT&      _flags);
 
+    ErrorConditionT doSendMessages(
+        const char*          _recipient_url,
+        const RecipientId&   _rrecipient_id_in,
+        MessagePointerT*     _pmsgptr,
+        const size_t         _msg_count,
+        RecipientId*         _precipient_id_out,
+        MessageId*           _pmsg_id_out,
+        const MessageFlagsT& _flags);
+
+    ErrorConditionT doCheckSendMessage(
+        MessagePointerT const& _rmsgptr,
+        const MessageFlagsT&   _flags,
+        size_t&                _rmsg_type_idx) const;
+
     ErrorConditionT doSendMessageToNewPool(
         const char*               _recipient_url,
         MessagePointerT&          _rmsgptr,
@@ -436,6 +488,30 @@ private:
         const MessageFlagsT&      _flags,
         std::string&              _msg_url);
 
+    ErrorConditionT doSendMessageToPool(
+        const size_t              _pool_index,
+        MessagePointerT&          _rmsgptr,
+        const size_t              _msg_type_idx,
+        MessageCompleteFunctionT& _rcomplete_fnc,
+        RecipientId*              _precipient_id_out,
+        MessageId*                _pmsg_id_out,
+        const MessageFlagsT&      _flags,
+        std::string&              _msg_url);
+
+    ErrorConditionT doSendMessagesToPool(
+        const size_t         _pool_index,
+        MessagePointerT*     _pmsgptr,
+        const size_t*        _pmsg_type_idx,
+        const size_t         _msg_count,
+        RecipientId*         _precipient_id_out,
+        MessageId*           _pmsg_id_out,
+        const MessageFlagsT& _flags,
+        std::string&         _msg_url);
+
+    void doNotifyPoolNewMessages(const size_t _pool_index, const MessageFlagsT& _flags);
+
+    void doCancelOneShotPoolMessage(const size_t _pool_index, MessageId const& _rmsgid);
+
     ErrorConditionT doSendMessageToConnection(
         const RecipientId&        _rrecipient_id_in,
         MessagePointerT&          _rmsgptr,
@@ -445,6 +521,15 @@ private:
         const MessageFlagsT&      _flags,
         std::string&              _msg_url);
 
+    ErrorConditionT doSendMessagesToConnection(
+        const RecipientId&   _rrecipient_id_in,
+        MessagePointerT*     _pmsgptr,
+        const size_t*        _pmsg_type_idx,
+        const size_t         _msg_count,
+        MessageId*           _pmsg_id_out,
+        const MessageFlagsT& _flags,
+        std::string&         _msg_url);
+
     bool doTryCreateNewConnectionForPool(const size_t _pool_index, ErrorConditionT& _rerror);
 
     void doFetchResendableMessagesFromConnection(
@@ -459,6 +544,8 @@ private:
 
     bool doTryNotifyPoolWaitingConnection(const size_t _conpoolindex);
 
+    void doDrainPoolSubmissions(const size_t _pool_index, ObjectIdT const& _rconsumer_uid = ObjectIdT());
+
     ErrorConditionT doForceCloseConnectionPool(
         RecipientId const&        _rrecipient_id,
         MessageCompleteFunctionT& _rcomplete_fnc);
@@ -539,6 +626,61 @@ ErrorConditionT Service::sendMessage(
     return doSendMessage(nullptr, _rrecipient_id, msgptr, complete_handler, nullptr, &_rmsg_id, _flags);
 }
 //-------------------------------------------------------------------------
+// send a batch of messages using recipient name -------------------------
+template <class It>
+ErrorConditionT Service::sendMessages(
+    const char*          _recipient_url,
+    It                   _first,
+    It                   _last,
+    const MessageFlagsT& _flags)
+{
+    std::vector<MessagePointerT> msgvec;
+    RecipientId                  recipient_id;
+
+    for (; _first != _last; ++_first) {
+        msgvec.emplace_back(std::static_pointer_cast<Message>(*_first));
+    }
+    return doSendMessages(_recipient_url, recipient_id, msgvec.data(), msgvec.size(), nullptr, nullptr, _flags);
+}
+//-------------------------------------------------------------------------
+template <class It>
+ErrorConditionT Service::sendMessages(
+    const char*          _recipient_url,
+    It                   _first,
+    It                   _last,
+    RecipientId&         _rrecipient_id,
+    MessageIdVectorT&    _rmsg_id_vec,
+    const MessageFlagsT& _flags)
+{
+    std::vector<MessagePointerT> msgvec;
+    RecipientId                  recipient_id;
+
+    for (; _first != _last; ++_first) {
+        msgvec.emplace_back(std::static_pointer_cast<Message>(*_first));
+    }
+    _rmsg_id_vec.clear();
+    _rmsg_id_vec.resize(msgvec.size());
+    return doSendMessages(_recipient_url, recipient_id, msgvec.data(), msgvec.size(), &_rrecipient_id, _rmsg_id_vec.data(), _flags);
+}
+// send a batch of messages using connection uid -------------------------
+template <class It>
+ErrorConditionT Service::sendMessages(
+    RecipientId const&   _rrecipient_id,
+    It                   _first,
+    It                   _last,
+    MessageIdVectorT&    _rmsg_id_vec,
+    const MessageFlagsT& _flags)
+{
+    std::vector<MessagePointerT> msgvec;
+
+    for (; _first != _last; ++_first) {
+        msgvec.emplace_back(std::static_pointer_cast<Message>(*_first));
+    }
+    _rmsg_id_vec.clear();
+    _rmsg_id_vec.resize(msgvec.size());
+    return doSendMessages(nullptr, _rrecipient_id, msgvec.data(), msgvec.size(), nullptr, _rmsg_id_vec.data(), _flags);
+}
+//-------------------------------------------------------------------------
 // send request using recipient name --------------------------------------
 template <class T, class Fnc>
 ErrorConditionT Service::sendRequest(
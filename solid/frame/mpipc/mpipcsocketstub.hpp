@@ -74,6 +74,10 @@ public:
         frame::aio::ReactorContext& _rctx, OnSendF _pf, char* _buf, size_t _bufcp)
         = 0;
 
+    virtual bool sendAll(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, IoVecT* _piov, size_t _iovcnt)
+        = 0;
+
     virtual void prepareSocket(
         frame::aio::ReactorContext& _rctx)
         = 0;
@@ -171,6 +171,12 @@ private:
         return sock.sendAll(_rctx, _buf, _bufcp, _pf);
     }
 
+    bool sendAll(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, IoVecT* _piov, size_t _iovcnt) override final
+    {
+        return sock.sendAll(_rctx, _piov, _iovcnt, _pf);
+    }
+
     void prepareSocket(
         frame::aio::ReactorContext& _rctx) override final
     {
@@ -25,12 +25,14 @@ namespace plain {
 
 class SocketStub final : public mpipc::SocketStub {
 public:
-    SocketStub(frame::aio::ObjectProxy const& _rproxy)
+    SocketStub(frame::aio::ObjectProxy const& _rproxy, const size_t _zero_copy_threshold = 0)
         : sock(_rproxy)
+        , zero_copy_threshold(_zero_copy_threshold)
     {
     }
-    SocketStub(frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd)
+    SocketStub(frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd, const size_t _zero_copy_threshold = 0)
         : sock(_rproxy, std::move(_usd))
+        , zero_copy_threshold(_zero_copy_threshold)
     {
     }
 
@@ -133,33 +135,44 @@ private:
         return sock.sendAll(_rctx, _buf, _bufcp, _pf);
     }
 
+    bool sendAll(
+        frame::aio::ReactorContext& _rctx, OnSendF _pf, IoVecT* _piov, size_t _iovcnt) override final
+    {
+        return sock.sendAll(_rctx, _piov, _iovcnt, _pf);
+    }
+
     void prepareSocket(
         frame::aio::ReactorContext& _rctx) override final
     {
+        if (zero_copy_threshold != 0) {
+            //on failure the sends are simply copied
+            sock.enableZeroCopy(zero_copy_threshold);
+        }
     }
 
 private:
     using StreamSocketT = frame::aio::Stream<frame::aio::Socket>;
 
     StreamSocketT sock;
+    const size_t  zero_copy_threshold;
 };
 
-inline SocketStubPtrT create_client_socket(Configuration const& /*_rcfg*/, frame::aio::ObjectProxy const& _rproxy, char* _emplace_buf)
+inline SocketStubPtrT create_client_socket(Configuration const& _rcfg, frame::aio::ObjectProxy const& _rproxy, char* _emplace_buf)
 {
     if (sizeof(SocketStub) > static_cast<size_t>(ConnectionValues::SocketEmplacementSize)) {
-        return SocketStubPtrT(new SocketStub(_rproxy), SocketStub::delete_deleter);
+        return SocketStubPtrT(new SocketStub(_rproxy, _rcfg.connection_send_zero_copy_threshold), SocketStub::delete_deleter);
     } else {
-        return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy), SocketStub::emplace_deleter);
+        return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, _rcfg.connection_send_zero_copy_threshold), SocketStub::emplace_deleter);
     }
 }
 
-inline SocketStubPtrT create_server_socket(Configuration const& /*_rcfg*/, frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd, char* _emplace_buf)
+inline SocketStubPtrT create_server_socket(Configuration const& _rcfg, frame::aio::ObjectProxy const& _rproxy, SocketDevice&& _usd, char* _emplace_buf)
 {
 
     if (sizeof(SocketStub) > static_cast<size_t>(ConnectionValues::SocketEmplacementSize)) {
-        return SocketStubPtrT(new SocketStub(_rproxy, std::move(_usd)), SocketStub::delete_deleter);
+        return SocketStubPtrT(new SocketStub(_rproxy, std::move(_usd), _rcfg.connection_send_zero_copy_threshold), SocketStub::delete_deleter);
     } else {
-        return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, std::move(_usd)), SocketStub::emplace_deleter);
+        return SocketStubPtrT(new (_emplace_buf) SocketStub(_rproxy, std::move(_usd), _rcfg.connection_send_zero_copy_threshold), SocketStub::emplace_deleter);
     }
 }
 
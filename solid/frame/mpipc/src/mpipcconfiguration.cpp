@@ -15,7 +15,9 @@
 #include "solid/system/cassert.hpp"
 #include "solid/system/memory.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <thread>
 
 namespace solid {
 namespace frame {
@@ -139,11 +141,14 @@ WriterConfiguration::WriterConfiguration()
 
     max_message_continuous_packet_count = 4;
     max_message_count_response_wait     = 128;
+    high_priority_weight                = 16;
 
     string_size_limit    = InvalidSize();
     stream_size_limit    = InvalidSize();
     container_size_limit = InvalidSize();
 
+    relayed_reference_threshold = 1024;
+
     inplace_compress_fnc = &default_compress;
 }
 //-----------------------------------------------------------------------------
@@ -235,6 +240,8 @@ void Configuration::init()
 
     connection_recv_buffer_max_capacity_kb = connection_send_buffer_max_capacity_kb = 64;
 
+    connection_send_zero_copy_threshold = 0;
+
     connection_inactivity_timeout_seconds = 60 * 10; //ten minutes
     connection_keepalive_timeout_seconds  = 60 * 5; //five minutes
     connection_reconnect_timeout_seconds  = 10;
@@ -312,6 +319,11 @@ void Configuration::prepare()
         pool_max_pending_connection_count = 1;
     }
 
+    if (pools_mutex_count == 0) {
+        //the pools are spread on the mutexes so that concurrent senders rarely contend
+        pools_mutex_count = std::max(static_cast<size_t>(16), static_cast<size_t>(std::thread::hardware_concurrency()) * 4);
+    }
+
     if (connection_recv_buffer_max_capacity_kb > 64) {
         connection_recv_buffer_max_capacity_kb = 64;
     }
@@ -13,6 +13,7 @@
 #include "solid/frame/mpipc/mpipcerror.hpp"
 #include "solid/frame/mpipc/mpipcservice.hpp"
 #include "solid/utility/event.hpp"
+#include <algorithm>
 #include <cstdio>
 
 namespace solid {
@@ -80,6 +81,13 @@ const EventCategory<ConnectionEvents> connection_event_category{
         }
     }};
 
+//keepalive and inactivity timers do not need precision - a slack of up to a second
+//spares the timer store an update on every send and receive
+std::chrono::milliseconds timer_slack(const uint32_t _seconds)
+{
+    return std::chrono::milliseconds(std::min<uint64_t>(static_cast<uint64_t>(_seconds) * 250, 1000));
+}
+
 } //namespace
 
 //-----------------------------------------------------------------------------
@@ -116,6 +124,13 @@ inline ObjectIdT Connection::uid(frame::aio::ReactorContext& _rctx) const
     return event;
 }
 //-----------------------------------------------------------------------------
+/*static*/ Event Connection::eventNewMessages(const MessageIdVectorT& _rmsgid_vec)
+{
+    Event event = connection_event_category.event(ConnectionEvents::NewConnMessage);
+    event.any() = _rmsgid_vec;
+    return event;
+}
+//-----------------------------------------------------------------------------
 /*static*/ Event Connection::eventCancelConnMessage(const MessageId& _rmsgid)
 {
     Event event = connection_event_category.event(ConnectionEvents::CancelConnMessage);
@@ -489,6 +504,9 @@ void Connection::doStop(frame::aio::ReactorContext& _rctx, const ErrorConditionT
 
         flags_.set(FlagsE::Stopping);
 
+        //release the relayed data before the messages get canceled
+        doReleaseRelayedReferences(_rctx);
+
         ConnectionContext conctx(service(_rctx), *this);
         ErrorConditionT   tmp_error(error());
         ObjectIdT         objuid(uid(_rctx));
@@ -896,22 +914,29 @@ void Connection::doHandleEventNewPoolMessage(frame::aio::ReactorContext& _rctx,
 void Connection::doHandleEventNewConnMessage(frame::aio::ReactorContext& _rctx, Event& _revent)
 {
 
-    MessageId* pmsgid = _revent.any().cast<MessageId>();
-    SOLID_ASSERT(pmsgid);
+    MessageId*        pmsgid     = _revent.any().cast<MessageId>();
+    MessageIdVectorT* pmsgid_vec = _revent.any().cast<MessageIdVectorT>();
+    SOLID_ASSERT(pmsgid || pmsgid_vec);
 
-    if (pmsgid) {
+    //a batch of messages comes with a single event - see Service::sendMessages
+    const MessageId* pmsgid_beg = pmsgid ? pmsgid : (pmsgid_vec ? pmsgid_vec->data() : nullptr);
+    const MessageId* pmsgid_end = pmsgid ? pmsgid + 1 : (pmsgid_vec ? pmsgid_vec->data() + pmsgid_vec->size() : nullptr);
+
+    if (pmsgid_beg != pmsgid_end) {
 
         if (!this->isStopping()) {
-            pending_message_vec_.push_back(*pmsgid);
+            pending_message_vec_.insert(pending_message_vec_.end(), pmsgid_beg, pmsgid_end);
             if (!this->isRawState()) {
                 flags_.set(FlagsE::PollPool);
                 doSend(_rctx);
             }
         } else {
-            MessageBundle msg_bundle;
+            for (const MessageId* pit = pmsgid_beg; pit != pmsgid_end; ++pit) {
+                MessageBundle msg_bundle;
 
-            if (service(_rctx).fetchCanceledMessage(*this, *pmsgid, msg_bundle)) {
-                doCompleteMessage(_rctx, *pmsgid, msg_bundle, error_connection_stopping);
+                if (service(_rctx).fetchCanceledMessage(*this, *pit, msg_bundle)) {
+                    doCompleteMessage(_rctx, *pit, msg_bundle, error_connection_stopping);
+                }
             }
         }
     }
@@ -1314,7 +1339,7 @@ void Connection::doResetTimerStart(frame::aio::ReactorContext& _rctx)
 
             solid_dbg(logger, Info, this << ' ' << this->id() << " wait for " << config.connection_inactivity_timeout_seconds << " seconds");
 
-            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_inactivity_timeout_seconds), onTimerInactivity);
+            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_inactivity_timeout_seconds), timer_slack(config.connection_inactivity_timeout_seconds), onTimerInactivity);
         }
     } else { //client
         if (config.connection_keepalive_timeout_seconds) {
@@ -1322,7 +1347,7 @@ void Connection::doResetTimerStart(frame::aio::ReactorContext& _rctx)
 
             solid_dbg(logger, Info, this << ' ' << this->id() << " wait for " << config.connection_keepalive_timeout_seconds << " seconds");
 
-            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
+            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), timer_slack(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
         }
     }
 }
@@ -1341,7 +1366,7 @@ void Connection::doResetTimerSend(frame::aio::ReactorContext& _rctx)
 
             solid_dbg(logger, Verbose, this << ' ' << this->id() << " wait for " << config.connection_keepalive_timeout_seconds << " seconds");
 
-            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
+            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), timer_slack(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
         }
     }
 }
@@ -1361,7 +1386,7 @@ void Connection::doResetTimerRecv(frame::aio::ReactorContext& _rctx)
 
             solid_dbg(logger, Info, this << ' ' << this->id() << " wait for " << config.connection_keepalive_timeout_seconds << " seconds");
 
-            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
+            timer_.waitFor(_rctx, std::chrono::seconds(config.connection_keepalive_timeout_seconds), timer_slack(config.connection_keepalive_timeout_seconds), onTimerKeepalive);
         }
     }
 }
@@ -1381,7 +1406,7 @@ void Connection::doResetTimerRecv(frame::aio::ReactorContext& _rctx)
 
         solid_dbg(logger, Info, &rthis << ' ' << rthis.id() << " wait for " << config.connection_inactivity_timeout_seconds << " seconds");
 
-        rthis.timer_.waitFor(_rctx, std::chrono::seconds(config.connection_inactivity_timeout_seconds), onTimerInactivity);
+        rthis.timer_.waitFor(_rctx, std::chrono::seconds(config.connection_inactivity_timeout_seconds), timer_slack(config.connection_inactivity_timeout_seconds), onTimerInactivity);
     } else {
         rthis.doStop(_rctx, error_connection_inactivity_timeout);
     }
@@ -1699,6 +1724,9 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 
             while (repeatcnt) {
 
+                //the relayed data sent with the previous buffer can be released
+                msg_writer_.completeRelayedReferences(sender);
+
                 if (shouldPollPool()) {
                     flags_.reset(FlagsE::PollPool); //reset flag
                     if ((error = service(_rctx).pollPoolForUpdates(*this, uid(_rctx), MessageId()))) {
@@ -1732,7 +1760,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
 
                 if (!error) {
 
-                    if (buffer.size() && this->sendAll(_rctx, buffer.data(), buffer.size())) {
+                    if (buffer.size() && this->doSendBuffer(_rctx, buffer)) {
                         if (_rctx.error()) {
                             solid_dbg(logger, Error, this << ' ' << id() << " sending " << buffer.size() << ": " << _rctx.error().message());
                             flags_.set(FlagsE::StopPeer);
@@ -1749,7 +1777,7 @@ void Connection::doSend(frame::aio::ReactorContext& _rctx)
                     solid_dbg(logger, Error, this << ' ' << id() << " size to send " << buffer.size() << " error " << error.message());
 
                     if (buffer.size()) {
-                        this->sendAll(_rctx, buffer.data(), buffer.size());
+                        this->doSendBuffer(_rctx, buffer);
                     }
 
                     doStop(_rctx, error);
@@ -1925,6 +1953,15 @@ void Connection::doCompleteRelayed(
     }
 }
 //-----------------------------------------------------------------------------
+void Connection::doReleaseRelayedReferences(frame::aio::ReactorContext& _rctx)
+{
+    ConnectionContext    conctx(service(_rctx), *this);
+    Configuration const& rconfig = service(_rctx).configuration();
+    Sender               sender(*this, _rctx, rconfig.writer, rconfig.protocol(), conctx);
+
+    msg_writer_.releaseRelayedReferences(sender);
+}
+//-----------------------------------------------------------------------------
 void Connection::doCancelRelayed(
     frame::aio::ReactorContext& _rctx,
     RelayData*                  _prelay_data,
@@ -2057,6 +2094,9 @@ bool Connection::doReceiveRelayResponse(
 //-----------------------------------------------------------------------------
 ResponseStateE Connection::doCheckResponseState(frame::aio::ReactorContext& _rctx, const MessageHeader& _rmsghdr, MessageId& _rrelay_id)
 {
+    //the response may come before the relayed request data is completed
+    doReleaseRelayedReferences(_rctx);
+
     ResponseStateE rv = msg_writer_.checkResponseState(_rmsghdr.recipient_request_id_, _rrelay_id);
     if (rv == ResponseStateE::Invalid) {
         this->post(
@@ -2118,6 +2158,23 @@ ResponseStateE Connection::doCheckResponseState(frame::aio::ReactorContext& _rct
     return sock_ptr_->sendAll(_rctx, Connection::onSend, _buf, _bufcp);
 }
 //-----------------------------------------------------------------------------
+/*virtual*/ bool Connection::sendAll(frame::aio::ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt)
+{
+    return sock_ptr_->sendAll(_rctx, Connection::onSend, _piov, _iovcnt);
+}
+//-----------------------------------------------------------------------------
+//a buffer referencing relayed data is sent with one gathered write
+bool Connection::doSendBuffer(frame::aio::ReactorContext& _rctx, WriteBuffer const& _rbuffer)
+{
+    IoVecT* piov   = nullptr;
+    size_t  iovcnt = 0;
+
+    if (msg_writer_.gather(_rbuffer, piov, iovcnt)) {
+        return this->sendAll(_rctx, piov, iovcnt);
+    }
+    return this->sendAll(_rctx, _rbuffer.data(), _rbuffer.size());
+}
+//-----------------------------------------------------------------------------
 /*virtual*/ void Connection::prepareSocket(frame::aio::ReactorContext& _rctx)
 {
     sock_ptr_->prepareSocket(_rctx);
@@ -79,6 +79,7 @@ public:
     static Event eventResolve();
     static Event eventNewMessage();
     static Event eventNewMessage(const MessageId&);
+    static Event eventNewMessages(const MessageIdVectorT&);
     static Event eventNewQueueMessage();
     static Event eventCancelConnMessage(const MessageId&);
     static Event eventCancelPoolMessage(const MessageId&);
@@ -266,6 +267,8 @@ private:
         RelayData*                  _prelay_data,
         MessageId const&            _rengine_msg_id);
 
+    void doReleaseRelayedReferences(frame::aio::ReactorContext& _rctx);
+
     void doCompleteKeepalive(frame::aio::ReactorContext& _rctx);
     void doCompleteAckCount(frame::aio::ReactorContext& _rctx, uint8_t _count);
     void doCompleteCancelRequest(frame::aio::ReactorContext& _rctx, const RequestId& _reqid);
@@ -335,6 +338,8 @@ private:
     bool recvSome(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp, size_t& _sz);
     bool hasPendingSend() const;
     bool sendAll(frame::aio::ReactorContext& _rctx, char* _buf, size_t _bufcp);
+    bool sendAll(frame::aio::ReactorContext& _rctx, IoVecT* _piov, size_t _iovcnt);
+    bool doSendBuffer(frame::aio::ReactorContext& _rctx, WriteBuffer const& _rbuffer);
     void prepareSocket(frame::aio::ReactorContext& _rctx);
 
     uint32_t recvBufferCapacity() const
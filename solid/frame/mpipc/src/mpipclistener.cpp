@@ -54,7 +54,7 @@ void Listener::onAccept(frame::aio::ReactorContext& _rctx, SocketDevice& _rsd)
 
     do {
         if (!_rctx.error()) {
-            service(_rctx).acceptIncomingConnection(_rsd);
+            service(_rctx).acceptIncomingConnection(_rsd, _rctx.reactorIndex());
         } else if (_rctx.error() == aio::error_listener_hangup) {
             solid_dbg(logger, Error, "listen hangup" << _rctx.error().message());
             //TODO: maybe you shoud restart the listener.
@@ -26,6 +26,8 @@ extern const LoggerT logger;
 MessageWriter::MessageWriter()
     : current_message_type_id_(InvalidIndex())
     , current_synchronous_message_idx_(InvalidIndex())
+    , write_high_priority_count_(0)
+    , high_priority_turn_count_(0)
     , order_inner_list_(message_vec_)
     , write_inner_list_(message_vec_)
     , cache_inner_list_(message_vec_)
@@ -48,6 +50,7 @@ void MessageWriter::prepare(WriterConfiguration const& _rconfig)
 //-----------------------------------------------------------------------------
 void MessageWriter::unprepare()
 {
+    SOLID_ASSERT(relayed_ref_vec_.empty());
 }
 //-----------------------------------------------------------------------------
 bool MessageWriter::full(WriterConfiguration const& _rconfig) const
@@ -87,7 +90,7 @@ bool MessageWriter::enqueue(
     _rconn_msg_id = MessageId(idx, rmsgstub.unique_);
 
     order_inner_list_.pushBack(idx);
-    write_inner_list_.pushBack(idx);
+    doWriteQueuePushBack(idx);
     solid_dbg(logger, Verbose, "is_relayed = " << Message::is_relayed(rmsgstub.msgbundle_.message_ptr->flags()) << ' ' << MessageWriterPrintPairT(*this, PrintInnerListsE));
 
     return true;
@@ -121,6 +124,10 @@ bool MessageWriter::enqueue(
         msgidx                      = cache_inner_list_.popFront();
         _rconn_msg_id               = MessageId(msgidx, message_vec_[msgidx].unique_);
         message_vec_[msgidx].state_ = MessageStub::StateE::RelayedStart;
+        if (Message::is_high_priority(_rprelay_data->pmessage_header_->flags_)) {
+            //relayed messages have no message, so keep the priority on the bundle flags
+            message_vec_[msgidx].msgbundle_.message_flags.set(MessageFlagsE::HighPriority);
+        }
         order_inner_list_.pushBack(msgidx);
     } else {
         msgidx = _rconn_msg_id.index;
@@ -128,6 +135,10 @@ bool MessageWriter::enqueue(
         if (message_vec_[msgidx].unique_ != _rconn_msg_id.unique || message_vec_[msgidx].prelay_data_ != nullptr) {
             return false;
         }
+        if (doHasRelayedReference(_rengine_msg_id)) {
+            //the previous relay data is not yet completed
+            return false;
+        }
     }
 
     SOLID_ASSERT(_rprelay_data);
@@ -138,7 +149,7 @@ bool MessageWriter::enqueue(
 
         solid_dbg(logger, Verbose, msgidx << " relay_data.is_last " << _rprelay_data->is_last_ << ' ' << MessageWriterPrintPairT(*this, PrintInnerListsE));
 
-        write_inner_list_.pushBack(msgidx);
+        doWriteQueuePushBack(msgidx);
         rmsgstub.prelay_data_ = _rprelay_data;
         rmsgstub.prelay_pos_  = rmsgstub.prelay_data_->pdata_;
         rmsgstub.relay_size_  = rmsgstub.prelay_data_->data_size_;
@@ -151,7 +162,7 @@ bool MessageWriter::enqueue(
         //after the current function call, the MessageStub in the RelayEngine is distroyed.
         //we need to forward the cancel on the connection
         rmsgstub.state_ = MessageStub::StateE::RelayedCancel;
-        write_inner_list_.pushBack(msgidx);
+        doWriteQueuePushBack(msgidx);
         solid_dbg(logger, Verbose, "relayedcancel msg " << msgidx);
         //we do not need the relay_data - leave it to the relay engine to delete it.
     } else if (rmsgstub.state_ == MessageStub::StateE::RelayedWait) {
@@ -208,7 +219,7 @@ ResponseStateE MessageWriter::checkResponseState(MessageId const& _rmsguid, Mess
         case MessageStub::StateE::WriteCanceled:
             SOLID_ASSERT(write_inner_list_.size());
             order_inner_list_.erase(_rmsguid.index);
-            write_inner_list_.erase(_rmsguid.index);
+            doWriteQueueErase(_rmsguid.index);
             doUnprepareMessageStub(_rmsguid.index);
             return ResponseStateE::Cancel;
         case MessageStub::StateE::WriteWaitCanceled:
@@ -257,7 +268,7 @@ void MessageWriter::doCancel(
         if (_force) {
             SOLID_ASSERT(write_inner_list_.size());
             order_inner_list_.erase(_msgidx);
-            write_inner_list_.erase(_msgidx);
+            doWriteQueueErase(_msgidx);
             doUnprepareMessageStub(_msgidx);
         }
         return; //already canceled
@@ -282,10 +293,13 @@ void MessageWriter::doCancel(
             //message is waiting to be sent
             SOLID_ASSERT(write_inner_list_.size());
             order_inner_list_.erase(_msgidx);
-            write_inner_list_.erase(_msgidx);
+            doWriteQueueErase(_msgidx);
             doUnprepareMessageStub(_msgidx);
         }
     } else {
+        //the relay engine expects the sent relay data completed before the cancel
+        releaseRelayedReferences(_rsender);
+
         //usually called when reader receives a cancel request
         switch (rmsgstub.state_) {
         case MessageStub::StateE::RelayedHeadStart:
@@ -295,7 +309,7 @@ void MessageWriter::doCancel(
             rmsgstub.state_ = MessageStub::StateE::RelayedCancelRequest;
             _rsender.cancelRelayed(rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
             if (!rmsgstub.prelay_data_) { //message not in write_inner_list_
-                write_inner_list_.pushBack(_msgidx);
+                doWriteQueuePushBack(_msgidx);
             }
             rmsgstub.prelay_data_ = nullptr;
             break;
@@ -310,7 +324,7 @@ void MessageWriter::doCancel(
             break;
         case MessageStub::StateE::RelayedCancelRequest:
             if (_force) {
-                write_inner_list_.erase(_msgidx);
+                doWriteQueueErase(_msgidx);
                 order_inner_list_.erase(_msgidx);
                 doUnprepareMessageStub(_msgidx);
                 return;
@@ -322,6 +336,67 @@ void MessageWriter::doCancel(
     }
 }
 //-----------------------------------------------------------------------------
+bool MessageWriter::gather(WriteBuffer const& _rbuffer, IoVecT*& _rpiov, size_t& _riovcnt)
+{
+    if (relayed_ref_vec_.empty()) {
+        return false;
+    }
+
+    char* pbufpos = _rbuffer.data();
+
+    iov_vec_.clear();
+
+    for (const auto& rref : relayed_ref_vec_) {
+        if (rref.pbuf_ != pbufpos) {
+            iov_vec_.emplace_back();
+            iov_vec_.back().iov_base = pbufpos;
+            iov_vec_.back().iov_len  = rref.pbuf_ - pbufpos;
+        }
+        iov_vec_.emplace_back();
+        iov_vec_.back().iov_base = const_cast<char*>(rref.pdata_);
+        iov_vec_.back().iov_len  = rref.size_;
+
+        pbufpos = rref.pbuf_ + rref.size_;
+    }
+
+    if (pbufpos != _rbuffer.end()) {
+        iov_vec_.emplace_back();
+        iov_vec_.back().iov_base = pbufpos;
+        iov_vec_.back().iov_len  = _rbuffer.end() - pbufpos;
+    }
+
+    _rpiov   = iov_vec_.data();
+    _riovcnt = iov_vec_.size();
+    return true;
+}
+//-----------------------------------------------------------------------------
+void MessageWriter::completeRelayedReferences(Sender& _rsender)
+{
+    for (const auto& rref : relayed_ref_vec_) {
+        if (rref.complete_) {
+            _rsender.completeRelayed(rref.prelay_data_, rref.relay_msg_id_);
+        }
+    }
+    relayed_ref_vec_.clear();
+}
+//-----------------------------------------------------------------------------
+void MessageWriter::releaseRelayedReferences(Sender& _rsender)
+{
+    for (const auto& rref : relayed_ref_vec_) {
+        memcpy(rref.pbuf_, rref.pdata_, rref.size_);
+
+        //the chunks not yet sent must point to the copy
+        for (auto& riov : iov_vec_) {
+            const char* pbase = static_cast<const char*>(riov.iov_base);
+
+            if (pbase >= rref.pdata_ && pbase < (rref.pdata_ + rref.size_)) {
+                riov.iov_base = rref.pbuf_ + (pbase - rref.pdata_);
+            }
+        }
+    }
+    completeRelayedReferences(_rsender);
+}
+//-----------------------------------------------------------------------------
 bool MessageWriter::empty() const
 {
     return order_inner_list_.empty();
@@ -411,8 +486,33 @@ ErrorConditionT MessageWriter::write(
 // Objectives for doFindEligibleMessage:
 // - be fast
 // - try to fill up the package
-// - be fair with all messages
-bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size_t _size)
+// - be fair with all messages of the same priority
+// - while messages of both priority classes wait, write
+//   high_priority_weight high priority chunks for every normal one
+bool MessageWriter::doFindEligibleMessage(WriterConfiguration const& _rconfig, const bool _can_send_relay, const size_t _size)
+{
+    bool found;
+
+    if (_rconfig.high_priority_weight == 0 || write_high_priority_count_ == 0 || write_high_priority_count_ == write_inner_list_.size()) {
+        found = doFindEligibleMessage(_can_send_relay, PriorityE::Any);
+    } else {
+        //look first for a message of the priority class whose turn it is
+        const PriorityE priority = high_priority_turn_count_ < _rconfig.high_priority_weight ? PriorityE::High : PriorityE::Normal;
+
+        found = doFindEligibleMessage(_can_send_relay, priority) || doFindEligibleMessage(_can_send_relay, PriorityE::Any);
+    }
+
+    if (found) {
+        if (!message_vec_[write_inner_list_.frontIndex()].isHighPriority()) {
+            high_priority_turn_count_ = 0;
+        } else if (high_priority_turn_count_ < _rconfig.high_priority_weight) {
+            ++high_priority_turn_count_;
+        }
+    }
+    return found;
+}
+//-----------------------------------------------------------------------------
+bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const PriorityE _priority)
 {
     size_t qsz = write_inner_list_.size();
     while (qsz--) {
@@ -422,6 +522,11 @@ bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size
         if (rmsgstub.isHeadState())
             return true; //prevent splitting the header
 
+        if (_priority != PriorityE::Any && rmsgstub.isHighPriority() != (_priority == PriorityE::High)) {
+            write_inner_list_.pushBack(write_inner_list_.popFront());
+            continue;
+        }
+
         if (rmsgstub.isSynchronous()) {
             if (current_synchronous_message_idx_ == InvalidIndex() || msgidx == current_synchronous_message_idx_) {
             } else {
@@ -446,10 +551,28 @@ bool MessageWriter::doFindEligibleMessage(const bool _can_send_relay, const size
     return false;
 }
 //-----------------------------------------------------------------------------
+void MessageWriter::doWriteQueuePushBack(const size_t _msgidx)
+{
+    write_inner_list_.pushBack(_msgidx);
+    if (message_vec_[_msgidx].isHighPriority()) {
+        ++write_high_priority_count_;
+    }
+}
+//-----------------------------------------------------------------------------
+void MessageWriter::doWriteQueueErase(const size_t _msgidx)
+{
+    write_inner_list_.erase(_msgidx);
+    if (message_vec_[_msgidx].isHighPriority()) {
+        SOLID_ASSERT(write_high_priority_count_ != 0);
+        --write_high_priority_count_;
+    }
+}
+//-----------------------------------------------------------------------------
 // we have three types of messages:
 // - direct: serialized onto buffer
 // - relay: serialized onto a relay buffer (one that needs confirmation)
-// - relayed: copyed onto the output buffer (no serialization)
+// - relayed: copyed onto the output buffer (no serialization) or, when large
+//   enough, sent right from the relay buffer - see MessageWriter::gather
 
 size_t MessageWriter::doWritePacketData(
     char*             _pbufbeg,
@@ -483,7 +606,7 @@ size_t MessageWriter::doWritePacketData(
     }
 
     while (
-        !_rerror && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize() && doFindEligibleMessage(_relay_free_count != 0, _pbufend - pbufpos)) {
+        !_rerror && static_cast<size_t>(_pbufend - pbufpos) >= _rsender.protocol().minimumFreePacketDataSize() && doFindEligibleMessage(_rsender.configuration(), _relay_free_count != 0, _pbufend - pbufpos)) {
         const size_t msgidx = write_inner_list_.frontIndex();
 
         PacketHeader::CommandE cmd = PacketHeader::CommandE::Message;
@@ -751,7 +874,13 @@ char* MessageWriter::doWriteRelayedBody(
         towrite = rmsgstub.relay_size_;
     }
 
-    memcpy(_pbufpos, rmsgstub.prelay_pos_, towrite);
+    if (towrite >= _rsender.configuration().relayed_reference_threshold) {
+        //leave a gap on the buffer - the data is sent from the relay buffer
+        relayed_ref_vec_.emplace_back(_pbufpos, rmsgstub.prelay_pos_, towrite, rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
+        _rpacket_options.force_no_compress = true;
+    } else {
+        memcpy(_pbufpos, rmsgstub.prelay_pos_, towrite);
+    }
 
     _pbufpos += towrite;
     rmsgstub.prelay_pos_ += towrite;
@@ -762,12 +891,14 @@ char* MessageWriter::doWriteRelayedBody(
 
     if (rmsgstub.relay_size_ == 0) {
         SOLID_ASSERT(write_inner_list_.size());
-        write_inner_list_.erase(_msgidx); //call before _rsender.pollRelayEngine
+        doWriteQueueErase(_msgidx); //call before _rsender.pollRelayEngine
 
         const bool is_last                 = rmsgstub.prelay_data_->is_last_;
         const bool is_waiting_for_response = Message::is_waiting_response(rmsgstub.prelay_data_->pmessage_header_->flags_);
 
-        _rsender.completeRelayed(rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
+        if (!doDeferCompleteRelayed(rmsgstub.prelay_data_)) {
+            _rsender.completeRelayed(rmsgstub.prelay_data_, rmsgstub.pool_msg_id_);
+        }
         rmsgstub.prelay_data_ = nullptr; //when prelay_data_ is null we consider the message not in write_inner_list_
 
         if (is_last) {
@@ -788,6 +919,28 @@ char* MessageWriter::doWriteRelayedBody(
     return _pbufpos;
 }
 //-----------------------------------------------------------------------------
+//the relay data must not be released while the buffer referencing it is being sent
+bool MessageWriter::doDeferCompleteRelayed(RelayData* _prelay_data)
+{
+    for (auto it = relayed_ref_vec_.rbegin(); it != relayed_ref_vec_.rend(); ++it) {
+        if (it->prelay_data_ == _prelay_data) {
+            it->complete_ = true;
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
+bool MessageWriter::doHasRelayedReference(MessageId const& _rrelay_msg_id) const
+{
+    for (const auto& rref : relayed_ref_vec_) {
+        if (rref.relay_msg_id_.index == _rrelay_msg_id.index && rref.relay_msg_id_.unique == _rrelay_msg_id.unique) {
+            return true;
+        }
+    }
+    return false;
+}
+//-----------------------------------------------------------------------------
 char* MessageWriter::doWriteMessageCancel(
     char*            _pbufpos,
     char*            _pbufend,
@@ -806,7 +959,7 @@ char* MessageWriter::doWriteMessageCancel(
     SOLID_CHECK(_pbufpos != nullptr, "fail store cross value");
 
     SOLID_ASSERT(write_inner_list_.size());
-    write_inner_list_.erase(_msgidx);
+    doWriteQueueErase(_msgidx);
     order_inner_list_.erase(_msgidx);
     doUnprepareMessageStub(_msgidx);
     if (current_synchronous_message_idx_ == _msgidx) {
@@ -837,7 +990,7 @@ char* MessageWriter::doWriteRelayedCancel(
     //rmsgstub.prelay_data_ = nullptr;
 
     SOLID_ASSERT(write_inner_list_.size());
-    write_inner_list_.erase(_msgidx);
+    doWriteQueueErase(_msgidx);
     order_inner_list_.erase(_msgidx);
     doUnprepareMessageStub(_msgidx);
     if (current_synchronous_message_idx_ == _msgidx) {
@@ -864,7 +1017,7 @@ char* MessageWriter::doWriteRelayedCancelRequest(
     SOLID_CHECK(_pbufpos != nullptr, "fail store cross value");
 
     SOLID_ASSERT(write_inner_list_.size());
-    write_inner_list_.erase(_msgidx);
+    doWriteQueueErase(_msgidx);
     order_inner_list_.erase(_msgidx);
     doUnprepareMessageStub(_msgidx);
     if (current_synchronous_message_idx_ == _msgidx) {
@@ -886,8 +1039,8 @@ void MessageWriter::doTryCompleteMessageAfterSerialization(
 
     cache(rmsgstub.serializer_ptr_);
 
-    SOLID_ASSERT(write_inner_list_.size());
-    write_inner_list_.popFront();
+    SOLID_ASSERT(write_inner_list_.size() && write_inner_list_.frontIndex() == _msgidx);
+    doWriteQueueErase(_msgidx);
 
     if (current_synchronous_message_idx_ == _msgidx) {
         current_synchronous_message_idx_ = InvalidIndex();
@@ -940,7 +1093,7 @@ void MessageWriter::forEveryMessagesNewerToOlder(VisitFunctionT const& _rvisit_f
 
                 if (message_in_write_queue) {
                     SOLID_ASSERT(write_inner_list_.size());
-                    write_inner_list_.erase(msgidx);
+                    doWriteQueueErase(msgidx);
                 }
 
                 const size_t oldidx = msgidx;
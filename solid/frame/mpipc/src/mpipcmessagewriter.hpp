@@ -14,6 +14,7 @@
 
 #include "solid/system/common.hpp"
 #include "solid/system/error.hpp"
+#include "solid/system/socketdevice.hpp"
 #include "solid/utility/function.hpp"
 
 #include "mpipcutility.hpp"
@@ -102,6 +103,7 @@ public:
 
     using WriteFlagsT      = Flags<WriteFlagsE>;
     using RequestIdVectorT = std::vector<RequestId>;
+    using IoVecVectorT     = std::vector<IoVecT>;
 
     MessageWriter();
     ~MessageWriter();
@@ -135,6 +137,18 @@ public:
         uint8_t&           _rrelay_free_count,
         Sender&            _rsender);
 
+    //Returns false when the last written buffer can be sent as is.
+    //Otherwise returns the buffer chunks interleaved with the referenced
+    //relayed data - the gaps left in the buffer.
+    bool gather(WriteBuffer const& _rbuffer, IoVecT*& _rpiov, size_t& _riovcnt);
+
+    //Must be called once the last written buffer was sent
+    void completeRelayedReferences(Sender& _rsender);
+
+    //Can be called while the last written buffer is being sent - the
+    //referenced relayed data is first copied onto the buffer
+    void releaseRelayedReferences(Sender& _rsender);
+
     bool empty() const;
 
     bool full(WriterConfiguration const& _rconfig) const;
@@ -268,11 +282,43 @@ private:
         {
             return Message::is_synchronous(msgbundle_.message_flags);
         }
+
+        bool isHighPriority() const noexcept
+        {
+            return Message::is_high_priority(msgbundle_.message_flags);
+        }
+    };
+
+    //Relayed data sent from the relay buffer instead of being copied
+    //onto the write buffer, where only a gap of the same size is left.
+    struct RelayedReference {
+        char*       pbuf_;
+        const char* pdata_;
+        size_t      size_;
+        RelayData*  prelay_data_;
+        MessageId   relay_msg_id_;
+        bool        complete_; //complete prelay_data_ once sent
+
+        RelayedReference(
+            char*            _pbuf,
+            const char*      _pdata,
+            const size_t     _size,
+            RelayData*       _prelay_data,
+            MessageId const& _rrelay_msg_id)
+            : pbuf_(_pbuf)
+            , pdata_(_pdata)
+            , size_(_size)
+            , prelay_data_(_prelay_data)
+            , relay_msg_id_(_rrelay_msg_id)
+            , complete_(false)
+        {
+        }
     };
 
     using MessageVectorT          = std::vector<MessageStub>;
     using MessageOrderInnerListT  = inner::List<MessageVectorT, InnerLinkOrder>;
     using MessageStatusInnerListT = inner::List<MessageVectorT, InnerLinkStatus>;
+    using RelayedReferenceVectorT = std::vector<RelayedReference>;
 
     struct PacketOptions {
         bool force_no_compress;
@@ -301,7 +347,17 @@ private:
     bool isAsynchronousInPendingQueue() const;
     bool isDelayedCloseInPendingQueue() const;
 
-    bool doFindEligibleMessage(const bool _can_send_relay, const size_t _size);
+    enum struct PriorityE {
+        Any,
+        Normal,
+        High,
+    };
+
+    bool doFindEligibleMessage(WriterConfiguration const& _rconfig, const bool _can_send_relay, const size_t _size);
+    bool doFindEligibleMessage(const bool _can_send_relay, const PriorityE _priority);
+
+    void doWriteQueuePushBack(const size_t _msgidx);
+    void doWriteQueueErase(const size_t _msgidx);
 
     void doTryMoveMessageFromPendingToWriteQueue(mpipc::Configuration const& _rconfig);
 
@@ -339,6 +395,9 @@ private:
         Sender&          _rsender,
         ErrorConditionT& _rerror);
 
+    bool doDeferCompleteRelayed(RelayData* _prelay_data);
+    bool doHasRelayedReference(MessageId const& _rrelay_msg_id) const;
+
     char* doWriteMessageCancel(
         char*            _pbufpos,
         char*            _pbufend,
@@ -374,10 +433,14 @@ private:
     MessageVectorT          message_vec_;
     uint32_t                current_message_type_id_;
     size_t                  current_synchronous_message_idx_;
+    size_t                  write_high_priority_count_; //high priority messages in write_inner_list_
+    size_t                  high_priority_turn_count_;
     MessageOrderInnerListT  order_inner_list_;
     MessageStatusInnerListT write_inner_list_;
     MessageStatusInnerListT cache_inner_list_;
     Serializer::PointerT    ser_top_;
+    RelayedReferenceVectorT relayed_ref_vec_;
+    IoVecVectorT            iov_vec_;
 };
 
 typedef std::pair<MessageWriter const&, MessageWriter::PrintWhat> MessageWriterPrintPairT;
@@ -36,6 +36,7 @@
 
 #include "solid/system/mutualstore.hpp"
 #include "solid/utility/innerlist.hpp"
+#include "solid/utility/mpscqueue.hpp"
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
 #include "solid/utility/string.hpp"
@@ -53,7 +54,15 @@ namespace mpipc {
 const LoggerT logger("solid::frame::mpipc");
 
 //=============================================================================
-using NameMapT       = std::unordered_map<const char*, size_t, CStringHash, CStringEqual>;
+struct ConnectionPoolStub;
+
+struct PoolNameStub {
+    size_t              index;
+    uint32_t            unique;
+    ConnectionPoolStub* ppool; //the pools never move within the deque
+};
+
+using NameMapT       = std::unordered_map<const char*, PoolNameStub, CStringHash, CStringEqual>;
 using ObjectIdQueueT = Queue<ObjectIdT>;
 
 enum {
@@ -127,6 +136,27 @@ struct MessageStub : inner::Node<InnerLinkCount> {
 
 //-----------------------------------------------------------------------------
 
+//A message pushed on the submission queue of a pool without locking the pool mutex
+struct SubmitStub {
+    SubmitStub(
+        MessagePointerT&          _rmsgptr,
+        const size_t              _msg_type_idx,
+        MessageCompleteFunctionT& _rcomplete_fnc,
+        const MessageFlagsT&      _flags,
+        std::string&              _rmsg_url)
+        : next(nullptr)
+        , msgbundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _rmsg_url)
+    {
+    }
+
+    SubmitStub*   next;
+    MessageBundle msgbundle;
+};
+
+using SubmitQueueT = MpscQueue<SubmitStub>;
+
+//-----------------------------------------------------------------------------
+
 using MessageVectorT         = std::vector<MessageStub>;
 using MessageOrderInnerListT = inner::List<MessageVectorT, InnerLinkOrder>;
 using MessageCacheInnerListT = inner::List<MessageVectorT, InnerLinkOrder>;
@@ -186,6 +216,11 @@ struct ConnectionPoolStub {
     uint8_t                flags;
     uint8_t                retry_connect_count;
     AddressVectorT         connect_addr_vec;
+    SubmitQueueT           submitq;          //messages pushed by the senders without the pool mutex
+    std::atomic<uint64_t>  submit_key;       //submitKey(unique) while the senders may push on submitq, zero otherwise
+    std::atomic<size_t>    submit_use_count; //senders pushing on submitq
+    std::atomic<size_t>    msg_count;        //msgvec.size() - msgcache_inner_list.size(), for the senders without the pool mutex
+    std::atomic<size_t>    reserve_count;    //room taken by the messages on submitq or being pushed under the pool mutex
 
     ConnectionPoolStub()
         : unique(0)
@@ -198,6 +233,10 @@ struct ConnectionPoolStub {
         , msgasync_inner_list(msgvec)
         , flags(0)
         , retry_connect_count(0)
+        , submit_key(0)
+        , submit_use_count(0)
+        , msg_count(0)
+        , reserve_count(0)
     {
     }
 
@@ -218,16 +257,29 @@ struct ConnectionPoolStub {
         , flags(_rpool.flags)
         , retry_connect_count(_rpool.retry_connect_count)
         , connect_addr_vec(std::move(_rpool.connect_addr_vec))
+        , submit_key(0)
+        , submit_use_count(0)
+        , msg_count(_rpool.msg_count.load())
+        , reserve_count(0)
     {
+        SOLID_ASSERT(_rpool.submitq.empty() && _rpool.reserve_count.load() == 0);
     }
 
     ~ConnectionPoolStub()
     {
+        SubmitStub* pstub = submitq.pop();
+
+        while (pstub != nullptr) {
+            SubmitStub* pnext = pstub->next;
+            delete pstub;
+            pstub = pnext;
+        }
         SOLID_ASSERT(msgcache_inner_list.size() == msgvec.size());
     }
 
     void clear()
     {
+        disableSubmit();
         name.clear();
         main_connection_id = ObjectIdT();
         ++unique;
@@ -245,6 +297,7 @@ struct ConnectionPoolStub {
         msgasync_inner_list.clear();
         msgvec.clear();
         msgvec.shrink_to_fit();
+        msg_count.store(0);
         flags               = 0;
         retry_connect_count = 0;
         connect_addr_vec.clear();
@@ -271,6 +324,7 @@ struct ConnectionPoolStub {
         MessageStub& rmsgstub(msgvec[idx]);
 
         rmsgstub.msgbundle = MessageBundle(_rmsgptr, _msg_type_idx, _flags, _rcomplete_fnc, _msg_url);
+        msg_count.fetch_add(1);
 
         //SOLID_ASSERT(rmsgstub.msgbundle.message_ptr.get());
 
@@ -350,17 +404,23 @@ struct ConnectionPoolStub {
         return _rmsgid;
     }
 
+    void cacheMessage(const size_t _msg_idx)
+    {
+        msgcache_inner_list.pushBack(_msg_idx);
+        msg_count.fetch_sub(1);
+    }
+
     void clearAndCacheMessage(const size_t _msg_idx)
     {
         MessageStub& rmsgstub(msgvec[_msg_idx]);
         rmsgstub.clear();
-        msgcache_inner_list.pushBack(_msg_idx);
+        cacheMessage(_msg_idx);
     }
 
     void cacheFrontMessage()
     {
         solid_dbg(logger, Info, "msgorder_inner_list " << msgorder_inner_list);
-        msgcache_inner_list.pushBack(msgorder_inner_list.popFront());
+        cacheMessage(msgorder_inner_list.popFront());
 
         SOLID_ASSERT(msgorder_inner_list.check());
     }
@@ -403,19 +463,129 @@ struct ConnectionPoolStub {
             msgasync_inner_list.erase(_msg_idx);
         }
 
-        msgcache_inner_list.pushBack(_msg_idx);
+        cacheMessage(_msg_idx);
 
         rmsgstub.clear();
         SOLID_ASSERT(msgorder_inner_list.check());
     }
 
+    static uint64_t submitKey(const uint32_t _unique)
+    {
+        return static_cast<uint64_t>(_unique) + 1;
+    }
+
+    //Lock free - returns false when the pool does not take submissions
+    //or when it has no room for the message.
+    bool trySubmitMessage(
+        const uint32_t            _unique,
+        const size_t              _max_count,
+        MessagePointerT&          _rmsgptr,
+        const size_t              _msg_type_idx,
+        MessageCompleteFunctionT& _rcomplete_fnc,
+        const MessageFlagsT&      _flags,
+        std::string&              _msg_url,
+        bool&                     _rwas_empty)
+    {
+        bool submitted = false;
+
+        submit_use_count.fetch_add(1);
+
+        if (submit_key.load() == submitKey(_unique) && tryReserve(_max_count)) {
+            _rwas_empty = submitq.push(new SubmitStub(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url));
+            submitted   = true;
+        }
+
+        submit_use_count.fetch_sub(1);
+        return submitted;
+    }
+
+    //Reserves room for _count messages: the messages in the pool plus the
+    //reserved ones must not exceed _max_count. Lock free.
+    bool tryReserve(const size_t _max_count, const size_t _count = 1)
+    {
+        size_t count = reserve_count.load();
+
+        do {
+            if (count + msg_count.load() + _count > _max_count) {
+                return false;
+            }
+        } while (!reserve_count.compare_exchange_weak(count, count + _count));
+
+        return true;
+    }
+
+    //Called once the reserved messages were pushed on the pool's lists.
+    void releaseReserve(const size_t _count = 1)
+    {
+        reserve_count.fetch_sub(_count);
+    }
+
+    //Moves the submitted messages, in order, at the back of the pool's lists.
+    //Returns false if there was no submitted message.
+    bool drainSubmitQueue(bool& _rhas_synchronous, bool& _rhas_asynchronous)
+    {
+        SubmitStub* pstub = submitq.pop();
+
+        _rhas_synchronous  = false;
+        _rhas_asynchronous = false;
+
+        if (pstub == nullptr) {
+            return false;
+        }
+
+        while (pstub != nullptr) {
+            SubmitStub*    pnext = pstub->next;
+            MessageBundle& rmsgbundle(pstub->msgbundle);
+
+            if (Message::is_synchronous(rmsgbundle.message_flags)) {
+                _rhas_synchronous = true;
+            } else {
+                _rhas_asynchronous = true;
+            }
+
+            pushBackMessage(rmsgbundle.message_ptr, rmsgbundle.message_type_id, rmsgbundle.complete_fnc, rmsgbundle.message_flags, rmsgbundle.message_url);
+            releaseReserve();
+
+            delete pstub;
+            pstub = pnext;
+        }
+        return true;
+    }
+
+    //The senders may push on submitq while the pool is named, has an active
+    //main connection - not a stopping one - and is not closing, cleaning up
+    //or restarting.
+    void enableSubmit()
+    {
+        if (
+            !name.empty() && isMainConnectionActive() && !isMainConnectionStopping() && (flags & (ClosingFlag | FastClosingFlag | CleanOneShotMessagesFlag | CleanAllMessagesFlag | RestartFlag)) == 0) {
+            submit_key.store(submitKey(unique));
+        }
+    }
+
+    //Waits for the senders pushing on submitq and moves the submitted
+    //messages to the pool's lists, so the pool state can be changed.
+    void disableSubmit()
+    {
+        bool has_synchronous;
+        bool has_asynchronous;
+
+        submit_key.store(0);
+
+        while (submit_use_count.load() != 0) {
+            std::this_thread::yield();
+        }
+
+        drainSubmitQueue(has_synchronous, has_asynchronous);
+    }
+
     void cacheMessageId(const MessageId& _rmsgid)
     {
         SOLID_ASSERT(_rmsgid.index < msgvec.size());
         SOLID_ASSERT(msgvec[_rmsgid.index].unique == _rmsgid.unique);
         if (_rmsgid.index < msgvec.size() && msgvec[_rmsgid.index].unique == _rmsgid.unique) {
             msgvec[_rmsgid.index].clear();
-            msgcache_inner_list.pushBack(_rmsgid.index);
+            cacheMessage(_rmsgid.index);
         }
     }
 
@@ -460,6 +630,7 @@ struct ConnectionPoolStub {
     void setClosing()
     {
         flags |= ClosingFlag;
+        disableSubmit();
     }
     bool isFastClosing() const
     {
@@ -545,11 +716,6 @@ struct ConnectionPoolStub {
         return (static_cast<size_t>(pending_connection_count) + active_connection_count) == 1;
     }
 
-    bool isFull(const size_t _max_message_queue_size) const
-    {
-        return msgcache_inner_list.empty() && msgvec.size() >= _max_message_queue_size;
-    }
-
     bool shouldClose() const
     {
         return isClosing() && hasNoMessage();
@@ -565,9 +731,25 @@ typedef Stack<size_t>                  SizeStackT;
 
 struct Service::Data {
 
+    //Two copies of the recipient name map, so that the senders can look up
+    //a name without locking the service mutex. A writer - holding mtx -
+    //updates the copy not in use, makes it the current one, waits for the
+    //readers of the other copy to leave and updates it too.
+    struct NameStoreStub {
+        NameStoreStub()
+            : usecnt(0)
+        {
+        }
+
+        std::atomic<size_t> usecnt;
+        NameMapT            map;
+    };
+
     Data(Service& _rsvc)
         : pmtxarr(nullptr)
         , mtxsarrcp(0)
+        , crtnamestoreidx(0)
+        , poolcnt(0)
         , config() /*, status(Status::Running)*/
     {
     }
@@ -596,14 +778,93 @@ struct Service::Data {
         }
     }
 
-    std::mutex           mtx;
-    std::mutex*          pmtxarr;
-    size_t               mtxsarrcp;
-    NameMapT             namemap;
-    ConnectionPoolDequeT pooldq;
-    SizeStackT           conpoolcachestk;
-    Configuration        config;
-    std::string          tmp_str;
+    //Lock free - the returned pool must be checked under its mutex,
+    //it might have been closed meanwhile.
+    bool findPool(const char* _name, PoolNameStub& _rpool_stub) const
+    {
+        const size_t    idx   = aquireNameStore();
+        const NameMapT& rmap  = namestore[idx].map;
+        const auto      it    = rmap.find(_name);
+        const bool      found = it != rmap.end();
+
+        if (found) {
+            _rpool_stub = it->second;
+        }
+        namestore[idx].usecnt.fetch_sub(1);
+        return found;
+    }
+
+    bool findPool(const char* _name, size_t& _rpool_index) const
+    {
+        PoolNameStub pool_stub;
+
+        if (findPool(_name, pool_stub)) {
+            _rpool_index = pool_stub.index;
+            return true;
+        }
+        return false;
+    }
+
+    //NOTE: mtx must be locked
+    void insertName(const char* _name, const size_t _pool_index)
+    {
+        const PoolNameStub pool_stub{_pool_index, pooldq[_pool_index].unique, &pooldq[_pool_index]};
+
+        updateNameStores([_name, &pool_stub](NameMapT& _rmap) { _rmap[_name] = pool_stub; });
+    }
+
+    //NOTE: mtx must be locked
+    void eraseName(const char* _name)
+    {
+        updateNameStores([_name](NameMapT& _rmap) { _rmap.erase(_name); });
+    }
+
+    size_t aquireNameStore() const
+    {
+        while (true) {
+            const size_t idx = crtnamestoreidx.load();
+
+            namestore[idx].usecnt.fetch_add(1);
+
+            if (idx == crtnamestoreidx.load()) {
+                return idx;
+            }
+            namestore[idx].usecnt.fetch_sub(1);
+        }
+    }
+
+    template <class F>
+    void updateNameStores(F _f)
+    {
+        const size_t oldidx = crtnamestoreidx.load();
+        const size_t newidx = (oldidx + 1) % 2;
+
+        waitNameStoreReaders(newidx);
+        _f(namestore[newidx].map);
+
+        crtnamestoreidx.store(newidx);
+
+        waitNameStoreReaders(oldidx);
+        _f(namestore[oldidx].map);
+    }
+
+    void waitNameStoreReaders(const size_t _idx) const
+    {
+        //the readers only hold a store for a map lookup
+        while (namestore[_idx].usecnt.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::mutex            mtx;
+    std::mutex*           pmtxarr;
+    size_t                mtxsarrcp;
+    mutable NameStoreStub namestore[2];
+    std::atomic<size_t>   crtnamestoreidx;
+    std::atomic<size_t>   poolcnt; //pooldq.size() readable without locking
+    ConnectionPoolDequeT  pooldq;
+    SizeStackT            conpoolcachestk;
+    Configuration         config;
 };
 //=============================================================================
 
@@ -662,35 +923,60 @@ ErrorConditionT Service::doStart()
             svc_name = impl_->config.server.listener_service_str.c_str();
         }
 
-        ResolveData  rd = synchronous_resolve(hst_name, svc_name, 0, -1, SocketInfo::Stream);
-        SocketDevice sd;
+        ResolveData rd = synchronous_resolve(hst_name, svc_name, 0, -1, SocketInfo::Stream);
+
+        if (rd.empty()) {
+            error = error_service_start_listener;
+            return error;
+        }
+
+        if (impl_->config.server.listener_sharded) {
+            SocketAddress local_address;
+            ErrorCodeT    errc;
+
+            error = aio::start_sharded_listeners(
+                impl_->config.scheduler(), *this, rd.begin(),
+                [](SocketDevice& _rsd) { return DynamicPointer<aio::Object>(new Listener(_rsd)); },
+                local_address, errc, Listener::backlog_size());
+
+            if (errc) {
+                solid_dbg(logger, Error, this << " sharded listener: " << errc.message());
+                error = error_service_start_listener;
+                return error;
+            }
+            if (error) {
+                return error;
+            }
+
+            impl_->config.server.listener_port = local_address.port();
+        } else {
+            SocketDevice sd;
 
-        if (!rd.empty()) {
             sd.create(rd.begin());
             const ErrorCodeT errc = sd.prepareAccept(rd.begin(), Listener::backlog_size());
             if (errc) {
                 sd.close();
             }
-        }
 
-        if (sd) {
+            if (sd) {
 
-            SocketAddress local_address;
+                SocketAddress local_address;
 
-            sd.localAddress(local_address);
+                sd.localAddress(local_address);
 
-            impl_->config.server.listener_port = local_address.port();
+                impl_->config.server.listener_port = local_address.port();
 
-            DynamicPointer<aio::Object> objptr(new Listener(sd));
+                DynamicPointer<aio::Object> objptr(new Listener(sd));
 
-            ObjectIdT conuid = impl_->config.scheduler().startObject(objptr, *this, make_event(GenericEvents::Start), error);
-            (void)conuid;
-            if (error) {
+                ObjectIdT conuid = impl_->config.scheduler().startObject(objptr, *this, make_event(GenericEvents::Start), error);
+                (void)conuid;
+                if (error) {
+                    return error;
+                }
+            } else {
+                error = error_service_start_listener;
                 return error;
             }
-        } else {
-            error = error_service_start_listener;
-            return error;
         }
     }
 
@@ -737,6 +1023,7 @@ size_t Service::doPushNewConnectionPool()
         impl_->pooldq.push_back(ConnectionPoolStub());
         impl_->conpoolcachestk.push(pool_idx);
     }
+    impl_->poolcnt.store(impl_->pooldq.size());
     impl_->unlockAllConnectionPoolMutexes();
     size_t idx = impl_->conpoolcachestk.top();
     impl_->conpoolcachestk.pop();
@@ -776,9 +1063,10 @@ ErrorConditionT Service::createConnectionPool(const char* _recipient_url, const
     solid::ErrorConditionT error;
     size_t                 pool_index;
     std::string            message_url;
+    std::string            tmp_str;
 
     lock_guard<std::mutex> lock(impl_->mtx);
-    const char*            recipient_name = configuration().extract_recipient_name_fnc(_recipient_url, message_url, impl_->tmp_str);
+    const char*            recipient_name = configuration().extract_recipient_name_fnc(_recipient_url, message_url, tmp_str);
 
     if (recipient_name == nullptr || recipient_name[0] == '\0') {
         solid_dbg(logger, Error, this << " failed extracting recipient name");
@@ -787,11 +1075,7 @@ ErrorConditionT Service::createConnectionPool(const char* _recipient_url, const
     }
 
     {
-        NameMapT::const_iterator it = impl_->namemap.find(recipient_name);
-
-        if (it != impl_->namemap.end()) {
-            pool_index = it->second;
-
+        if (impl_->findPool(recipient_name, pool_index)) {
             lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
             ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
 
@@ -817,7 +1101,7 @@ ErrorConditionT Service::createConnectionPool(const char* _recipient_url, const
                 return error;
             }
 
-            impl_->namemap[rpool.name.c_str()] = pool_index;
+            impl_->insertName(rpool.name.c_str(), pool_index);
         }
     }
 
@@ -839,9 +1123,6 @@ ErrorConditionT Service::doSendMessage(
 
     solid::ErrorConditionT error;
     size_t                 pool_index;
-    uint32_t               unique    = -1;
-    bool                   check_uid = false;
-    lock_guard<std::mutex> lock(impl_->mtx);
 
     if (!isRunning()) {
         solid_dbg(logger, Error, this << " service stopping");
@@ -849,6 +1130,124 @@ ErrorConditionT Service::doSendMessage(
         return error;
     }
 
+    size_t msg_type_idx;
+
+    error = doCheckSendMessage(_rmsgptr, _flags, msg_type_idx);
+
+    if (error) {
+        return error;
+    }
+
+    std::string message_url;
+    std::string tmp_str;
+    const char* recipient_name = configuration().extract_recipient_name_fnc(_recipient_url, message_url, tmp_str);
+
+    if (_recipient_url != nullptr && (recipient_name == nullptr || recipient_name[0] == '\0')) {
+        solid_dbg(logger, Error, this << " failed extracting recipient name");
+        error = error_service_invalid_url;
+        return error;
+    }
+
+    if (_rrecipient_id_in.isValidConnection()) {
+        SOLID_ASSERT(_precipient_id_out == nullptr);
+        //directly send the message to a connection object
+        return doSendMessageToConnection(
+            _rrecipient_id_in,
+            _rmsgptr,
+            msg_type_idx,
+            _rcomplete_fnc,
+            _pmsgid_out,
+            _flags,
+            message_url);
+    } else if (recipient_name) {
+        PoolNameStub pool_stub;
+
+        //the service mutex is only needed when the pool must be created
+        if (impl_->findPool(recipient_name, pool_stub)) {
+            bool was_empty = false;
+
+            pool_index = pool_stub.index;
+
+            //a cancelable message needs its MessageId, so it goes through the pool mutex
+            if (
+                _pmsgid_out == nullptr && pool_stub.ppool->trySubmitMessage(pool_stub.unique, configuration().pool_max_message_queue_size, _rmsgptr, msg_type_idx, _rcomplete_fnc, _flags, message_url, was_empty)) {
+
+                if (_precipient_id_out) {
+                    _precipient_id_out->poolid = ConnectionPoolId(pool_index, pool_stub.unique);
+                }
+
+                if (was_empty) {
+                    //the first submitter hands the queue over to the connections
+                    lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+
+                    if (impl_->pooldq[pool_index].unique == pool_stub.unique) {
+                        doDrainPoolSubmissions(pool_index);
+                    }
+                }
+                return error;
+            }
+
+            lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+            ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+
+            //the pool might have been closed and reused since the lookup
+            if (!rpool.isClosing() && rpool.name == recipient_name) {
+                return doSendMessageToPool(
+                    pool_index, _rmsgptr, msg_type_idx,
+                    _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+            }
+        }
+
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        if (impl_->findPool(recipient_name, pool_index)) {
+            lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+
+            return doSendMessageToPool(
+                pool_index, _rmsgptr, msg_type_idx,
+                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+        }
+
+        if (configuration().isServerOnly()) {
+            solid_dbg(logger, Error, this << " request for name resolve for a server only configuration");
+            error = error_service_server_only;
+            return error;
+        }
+
+        return this->doSendMessageToNewPool(
+            recipient_name, _rmsgptr, msg_type_idx,
+            _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+    } else if (
+        static_cast<size_t>(_rrecipient_id_in.poolid.index) < impl_->poolcnt.load()) {
+        pool_index = static_cast<size_t>(_rrecipient_id_in.poolid.index);
+
+        lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+        ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+
+        if (rpool.unique != _rrecipient_id_in.poolid.unique) {
+            //failed uid check
+            solid_dbg(logger, Error, this << " connection pool does not exist");
+            error = error_service_unknown_pool;
+            return error;
+        }
+
+        return doSendMessageToPool(
+            pool_index, _rmsgptr, msg_type_idx,
+            _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+    } else {
+        solid_dbg(logger, Error, this << " recipient does not exist");
+        error = error_service_unknown_recipient;
+        return error;
+    }
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doCheckSendMessage(
+    MessagePointerT const& _rmsgptr,
+    const MessageFlagsT&   _flags,
+    size_t&                _rmsg_type_idx) const
+{
+    solid::ErrorConditionT error;
+
     if (!_rmsgptr) {
         error = error_service_message_null;
         return error;
@@ -871,16 +1270,59 @@ ErrorConditionT Service::doSendMessage(
         }
     }
 
-    const size_t msg_type_idx = configuration().protocol().typeIndex(_rmsgptr.get());
+    _rmsg_type_idx = configuration().protocol().typeIndex(_rmsgptr.get());
 
-    if (msg_type_idx == 0) {
+    if (_rmsg_type_idx == 0) {
         solid_dbg(logger, Error, this << " message type not registered");
         error = error_service_message_unknown_type;
         return error;
     }
+    return error;
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doSendMessages(
+    const char*          _recipient_url,
+    const RecipientId&   _rrecipient_id_in,
+    MessagePointerT*     _pmsgptr,
+    const size_t         _msg_count,
+    RecipientId*         _precipient_id_out,
+    MessageId*           _pmsgid_out,
+    const MessageFlagsT& _flags)
+{
+
+    solid_dbg(logger, Verbose, this << " message count = " << _msg_count);
+
+    solid::ErrorConditionT error;
+    size_t                 pool_index;
+
+    if (!isRunning()) {
+        solid_dbg(logger, Error, this << " service stopping");
+        error = error_service_stopping;
+        return error;
+    }
+
+    if (_msg_count == 0) {
+        return error;
+    }
+
+    std::vector<size_t> msg_type_idx_vec(_msg_count);
+
+    for (size_t i = 0; i < _msg_count; ++i) {
+        error = doCheckSendMessage(_pmsgptr[i], _flags, msg_type_idx_vec[i]);
+        if (error) {
+            return error;
+        }
+    }
+
+    if (_msg_count > configuration().pool_max_message_queue_size) {
+        solid_dbg(logger, Error, this << " too many messages for a connection pool");
+        error = error_service_pool_full;
+        return error;
+    }
 
     std::string message_url;
-    const char* recipient_name = configuration().extract_recipient_name_fnc(_recipient_url, message_url, impl_->tmp_str);
+    std::string tmp_str;
+    const char* recipient_name = configuration().extract_recipient_name_fnc(_recipient_url, message_url, tmp_str);
 
     if (_recipient_url != nullptr && (recipient_name == nullptr || recipient_name[0] == '\0')) {
         solid_dbg(logger, Error, this << " failed extracting recipient name");
@@ -890,52 +1332,107 @@ ErrorConditionT Service::doSendMessage(
 
     if (_rrecipient_id_in.isValidConnection()) {
         SOLID_ASSERT(_precipient_id_out == nullptr);
-        //directly send the message to a connection object
-        return doSendMessageToConnection(
-            _rrecipient_id_in,
-            _rmsgptr,
-            msg_type_idx,
-            _rcomplete_fnc,
-            _pmsgid_out,
-            _flags,
-            message_url);
+        return doSendMessagesToConnection(
+            _rrecipient_id_in, _pmsgptr, msg_type_idx_vec.data(), _msg_count,
+            _pmsgid_out, _flags, message_url);
     } else if (recipient_name) {
-        NameMapT::const_iterator it = impl_->namemap.find(recipient_name);
+        //the service mutex is only needed when the pool must be created
+        if (impl_->findPool(recipient_name, pool_index)) {
+            lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+            ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
 
-        if (it != impl_->namemap.end()) {
-            pool_index = it->second;
-        } else {
-            if (configuration().isServerOnly()) {
-                solid_dbg(logger, Error, this << " request for name resolve for a server only configuration");
-                error = error_service_server_only;
-                return error;
+            //the pool might have been closed and reused since the lookup
+            if (!rpool.isClosing() && rpool.name == recipient_name) {
+                return doSendMessagesToPool(
+                    pool_index, _pmsgptr, msg_type_idx_vec.data(), _msg_count,
+                    _precipient_id_out, _pmsgid_out, _flags, message_url);
             }
+        }
 
-            return this->doSendMessageToNewPool(
-                recipient_name, _rmsgptr, msg_type_idx,
-                _rcomplete_fnc, _precipient_id_out, _pmsgid_out, _flags, message_url);
+        lock_guard<std::mutex> lock(impl_->mtx);
+
+        if (impl_->findPool(recipient_name, pool_index)) {
+            lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+
+            return doSendMessagesToPool(
+                pool_index, _pmsgptr, msg_type_idx_vec.data(), _msg_count,
+                _precipient_id_out, _pmsgid_out, _flags, message_url);
+        }
+
+        if (configuration().isServerOnly()) {
+            solid_dbg(logger, Error, this << " request for name resolve for a server only configuration");
+            error = error_service_server_only;
+            return error;
+        }
+
+        //the first message creates the pool, the others follow under the same service lock
+        RecipientId              recipient_id;
+        MessageCompleteFunctionT complete_fnc;
+
+        error = this->doSendMessageToNewPool(
+            recipient_name, _pmsgptr[0], msg_type_idx_vec[0],
+            complete_fnc, &recipient_id, _pmsgid_out, _flags, message_url);
+
+        if (error) {
+            return error;
+        }
+
+        if (_precipient_id_out) {
+            *_precipient_id_out = recipient_id;
+        }
+
+        if (_msg_count == 1) {
+            return error;
         }
+
+        pool_index = static_cast<size_t>(recipient_id.poolId().index);
+
+        lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+
+        return doSendMessagesToPool(
+            pool_index, _pmsgptr + 1, msg_type_idx_vec.data() + 1, _msg_count - 1,
+            nullptr, _pmsgid_out ? _pmsgid_out + 1 : nullptr, _flags, message_url);
     } else if (
-        static_cast<size_t>(_rrecipient_id_in.poolid.index) < impl_->pooldq.size()) {
-        //we cannot check the uid right now because we need a lock on the pool's mutex
-        check_uid  = true;
+        static_cast<size_t>(_rrecipient_id_in.poolid.index) < impl_->poolcnt.load()) {
         pool_index = static_cast<size_t>(_rrecipient_id_in.poolid.index);
-        unique     = _rrecipient_id_in.poolid.unique;
+
+        lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+        ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+
+        if (rpool.unique != _rrecipient_id_in.poolid.unique) {
+            //failed uid check
+            solid_dbg(logger, Error, this << " connection pool does not exist");
+            error = error_service_unknown_pool;
+            return error;
+        }
+
+        return doSendMessagesToPool(
+            pool_index, _pmsgptr, msg_type_idx_vec.data(), _msg_count,
+            _precipient_id_out, _pmsgid_out, _flags, message_url);
     } else {
         solid_dbg(logger, Error, this << " recipient does not exist");
         error = error_service_unknown_recipient;
         return error;
     }
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doSendMessageToPool(
+    const size_t              _pool_index,
+    MessagePointerT&          _rmsgptr,
+    const size_t              _msg_type_idx,
+    MessageCompleteFunctionT& _rcomplete_fnc,
+    RecipientId*              _precipient_id_out,
+    MessageId*                _pmsgid_out,
+    const MessageFlagsT&      _flags,
+    std::string&              _msg_url)
+{
+    //the pool mutex must be locked
 
-    lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
-    ConnectionPoolStub&    rpool(impl_->pooldq[pool_index]);
+    solid::ErrorConditionT error;
+    ConnectionPoolStub&    rpool(impl_->pooldq[_pool_index]);
 
-    if (check_uid && rpool.unique != unique) {
-        //failed uid check
-        solid_dbg(logger, Error, this << " connection pool does not exist");
-        error = error_service_unknown_pool;
-        return error;
-    }
+    //keep the order with the messages already submitted
+    doDrainPoolSubmissions(_pool_index);
 
     if (rpool.isClosing()) {
         solid_dbg(logger, Error, this << " connection pool is stopping");
@@ -943,19 +1440,21 @@ ErrorConditionT Service::doSendMessage(
         return error;
     }
 
-    if (rpool.isFull(configuration().pool_max_message_queue_size)) {
+    if (!rpool.tryReserve(configuration().pool_max_message_queue_size)) {
         solid_dbg(logger, Error, this << " connection pool is full");
         error = error_service_pool_full;
         return error;
     }
 
     if (_precipient_id_out) {
-        _precipient_id_out->poolid = ConnectionPoolId(pool_index, rpool.unique);
+        _precipient_id_out->poolid = ConnectionPoolId(_pool_index, rpool.unique);
     }
 
     //At this point we can fetch the message from user's pointer
     //because from now on we can call complete on the message
-    const MessageId msgid = rpool.pushBackMessage(_rmsgptr, msg_type_idx, _rcomplete_fnc, _flags, message_url);
+    const MessageId msgid = rpool.pushBackMessage(_rmsgptr, _msg_type_idx, _rcomplete_fnc, _flags, _msg_url);
+
+    rpool.releaseReserve();
 
     if (_pmsgid_out) {
 
@@ -967,27 +1466,108 @@ ErrorConditionT Service::doSendMessage(
         solid_dbg(logger, Info, this << " set message id to " << *_pmsgid_out);
     }
 
-    bool success = false;
-
     if (
         rpool.isCleaningOneShotMessages() && Message::is_one_shot(_flags)) {
-        success = manager().notify(
-            rpool.main_connection_id,
-            Connection::eventClosePoolMessage(msgid));
+        doCancelOneShotPoolMessage(_pool_index, msgid);
+    } else {
+        doNotifyPoolNewMessages(_pool_index, _flags);
+    }
 
-        if (success) {
-            solid_dbg(logger, Verbose, this << " message " << msgid << " from pool " << pool_index << " sent for canceling to " << rpool.main_connection_id);
-            //erase/unlink the message from any list
-            if (rpool.msgorder_inner_list.contains(msgid.index)) {
-                rpool.eraseMessageOrderAsync(msgid.index);
-            }
-        } else {
-            SOLID_THROW("Message Cancel connection not available");
+    return error;
+}
+//-----------------------------------------------------------------------------
+ErrorConditionT Service::doSendMessagesToPool(
+    const size_t         _pool_index,
+    MessagePointerT*     _pmsgptr,
+    const size_t*        _pmsg_type_idx,
+    const size_t         _msg_count,
+    RecipientId*         _precipient_id_out,
+    MessageId*           _pmsgid_out,
+    const MessageFlagsT& _flags,
+    std::string&         _msg_url)
+{
+    //the pool mutex must be locked
+
+    solid::ErrorConditionT error;
+    ConnectionPoolStub&    rpool(impl_->pooldq[_pool_index]);
+
+    //keep the order with the messages already submitted
+    doDrainPoolSubmissions(_pool_index);
+
+    if (rpool.isClosing()) {
+        solid_dbg(logger, Error, this << " connection pool is stopping");
+        error = error_service_pool_stopping;
+        return error;
+    }
+
+    if (!rpool.tryReserve(configuration().pool_max_message_queue_size, _msg_count)) {
+        solid_dbg(logger, Error, this << " connection pool is full");
+        error = error_service_pool_full;
+        return error;
+    }
+
+    if (_precipient_id_out) {
+        _precipient_id_out->poolid = ConnectionPoolId(_pool_index, rpool.unique);
+    }
+
+    const bool cancel_one_shot = rpool.isCleaningOneShotMessages() && Message::is_one_shot(_flags);
+
+    for (size_t i = 0; i < _msg_count; ++i) {
+        MessageCompleteFunctionT complete_fnc;
+        const MessageId          msgid = rpool.pushBackMessage(_pmsgptr[i], _pmsg_type_idx[i], complete_fnc, _flags, _msg_url);
+
+        if (_pmsgid_out) {
+            rpool.msgvec[msgid.index].makeCancelable();
+            _pmsgid_out[i] = msgid;
         }
+
+        if (cancel_one_shot) {
+            doCancelOneShotPoolMessage(_pool_index, msgid);
+        }
+    }
+
+    rpool.releaseReserve(_msg_count);
+
+    solid_dbg(logger, Info, this << " pool " << _pool_index << " got " << _msg_count << " messages");
+
+    if (!cancel_one_shot) {
+        //a single wakeup for the whole batch
+        doNotifyPoolNewMessages(_pool_index, _flags);
+    }
+
+    return error;
+}
+//-----------------------------------------------------------------------------
+void Service::doCancelOneShotPoolMessage(const size_t _pool_index, MessageId const& _rmsgid)
+{
+    //the pool mutex must be locked
+
+    ConnectionPoolStub& rpool(impl_->pooldq[_pool_index]);
+
+    if (
+        manager().notify(
+            rpool.main_connection_id,
+            Connection::eventClosePoolMessage(_rmsgid))) {
+        solid_dbg(logger, Verbose, this << " message " << _rmsgid << " from pool " << _pool_index << " sent for canceling to " << rpool.main_connection_id);
+        //erase/unlink the message from any list
+        if (rpool.msgorder_inner_list.contains(_rmsgid.index)) {
+            rpool.eraseMessageOrderAsync(_rmsgid.index);
+        }
+    } else {
+        SOLID_THROW("Message Cancel connection not available");
     }
+}
+//-----------------------------------------------------------------------------
+void Service::doNotifyPoolNewMessages(const size_t _pool_index, const MessageFlagsT& _flags)
+{
+    //the pool mutex must be locked
+
+    solid::ErrorConditionT error;
+    ConnectionPoolStub&    rpool(impl_->pooldq[_pool_index]);
+    bool                   success = false;
 
     if (
-        !success && Message::is_synchronous(_flags) &&
+        Message::is_synchronous(_flags) &&
         //      rpool.main_connection_id.isValid() and
         rpool.isMainConnectionActive()) {
         success = manager().notify(
@@ -997,19 +1577,16 @@ ErrorConditionT Service::doSendMessage(
     }
 
     if (!success && !Message::is_synchronous(_flags)) {
-        success = doTryNotifyPoolWaitingConnection(pool_index);
+        success = doTryNotifyPoolWaitingConnection(_pool_index);
     }
 
     if (!success) {
-        doTryCreateNewConnectionForPool(pool_index, error);
-        error.clear();
+        doTryCreateNewConnectionForPool(_pool_index, error);
     }
 
     if (!success) {
         solid_dbg(logger, Warning, this << " no connection notified about the new message");
     }
-
-    return error;
 }
 
 //-----------------------------------------------------------------------------
@@ -1023,8 +1600,6 @@ ErrorConditionT Service::doSendMessageToConnection(
     const MessageFlagsT&      _flags,
     std::string&              _msg_url)
 {
-    //d.mtx must be locked
-
     solid_dbg(logger, Verbose, this);
 
     if (!_rrecipient_id_in.isValidPool()) {
@@ -1034,12 +1609,17 @@ ErrorConditionT Service::doSendMessageToConnection(
 
     const size_t pool_index = static_cast<size_t>(_rrecipient_id_in.poolId().index);
 
-    if (pool_index >= impl_->pooldq.size() || impl_->pooldq[pool_index].unique != _rrecipient_id_in.poolId().unique) {
+    if (pool_index >= impl_->poolcnt.load()) {
         return error_service_unknown_connection;
     }
 
     lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
     ConnectionPoolStub&    rpool = impl_->pooldq[pool_index];
+
+    if (rpool.unique != _rrecipient_id_in.poolId().unique) {
+        return error_service_unknown_connection;
+    }
+
     solid::ErrorConditionT error;
     const bool             is_server_side_pool = rpool.isServerSide(); //unnamed pool has a single connection
 
@@ -1078,6 +1658,88 @@ ErrorConditionT Service::doSendMessageToConnection(
     return error;
 }
 
+//-----------------------------------------------------------------------------
+// the batch variant of doSendMessageToConnection: all the messages are queued
+// under one pool lock and the connection gets a single event for them.
+// If the connection cannot be notified none of the messages is kept.
+ErrorConditionT Service::doSendMessagesToConnection(
+    const RecipientId&   _rrecipient_id_in,
+    MessagePointerT*     _pmsgptr,
+    const size_t*        _pmsg_type_idx,
+    const size_t         _msg_count,
+    MessageId*           _pmsgid_out,
+    const MessageFlagsT& _flags,
+    std::string&         _msg_url)
+{
+    solid_dbg(logger, Verbose, this << " message count = " << _msg_count);
+
+    if (!_rrecipient_id_in.isValidPool()) {
+        SOLID_ASSERT(false);
+        return error_service_unknown_connection;
+    }
+
+    const size_t pool_index = static_cast<size_t>(_rrecipient_id_in.poolId().index);
+
+    if (pool_index >= impl_->poolcnt.load()) {
+        return error_service_unknown_connection;
+    }
+
+    lock_guard<std::mutex> lock2(impl_->poolMutex(pool_index));
+    ConnectionPoolStub&    rpool = impl_->pooldq[pool_index];
+
+    if (rpool.unique != _rrecipient_id_in.poolId().unique) {
+        return error_service_unknown_connection;
+    }
+
+    solid::ErrorConditionT error;
+    const bool             is_server_side_pool = rpool.isServerSide(); //unnamed pool has a single connection
+    MessageIdVectorT       msgid_vec;
+    bool                   success = false;
+
+    msgid_vec.reserve(_msg_count);
+
+    for (size_t i = 0; i < _msg_count; ++i) {
+        MessageCompleteFunctionT complete_fnc;
+
+        if (is_server_side_pool) {
+            //for a server pool we want to enque messages in the pool
+            msgid_vec.emplace_back(rpool.pushBackMessage(_pmsgptr[i], _pmsg_type_idx[i], complete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url));
+        } else {
+            msgid_vec.emplace_back(rpool.insertMessage(_pmsgptr[i], _pmsg_type_idx[i], complete_fnc, _flags | MessageFlagsE::OneShotSend, _msg_url));
+        }
+    }
+
+    if (is_server_side_pool) {
+        success = manager().notify(
+            _rrecipient_id_in.connectionId(),
+            Connection::eventNewMessage());
+    } else {
+        success = manager().notify(
+            _rrecipient_id_in.connectionId(),
+            Connection::eventNewMessages(msgid_vec));
+    }
+
+    if (success) {
+        if (_pmsgid_out) {
+            for (size_t i = 0; i < _msg_count; ++i) {
+                _pmsgid_out[i] = msgid_vec[i];
+                rpool.msgvec[msgid_vec[i].index].makeCancelable();
+            }
+        }
+    } else {
+        for (const auto& rmsgid : msgid_vec) {
+            if (is_server_side_pool) {
+                rpool.clearPopAndCacheMessage(rmsgid.index);
+            } else {
+                rpool.clearAndCacheMessage(rmsgid.index);
+            }
+        }
+        error = error_service_unknown_connection;
+    }
+
+    return error;
+}
+
 //-----------------------------------------------------------------------------
 
 ErrorConditionT Service::doSendMessageToNewPool(
@@ -1118,7 +1780,7 @@ ErrorConditionT Service::doSendMessageToNewPool(
         return error;
     }
 
-    impl_->namemap[rpool.name.c_str()] = pool_index;
+    impl_->insertName(rpool.name.c_str(), pool_index);
 
     if (_precipient_id_out) {
         _precipient_id_out->poolid = ConnectionPoolId(pool_index, rpool.unique);
@@ -1185,7 +1847,7 @@ bool Service::doTryPushMessageToConnection(
                 rpool.msgasync_inner_list.erase(_msg_idx);
             }
 
-            rpool.msgcache_inner_list.pushBack(_msg_idx);
+            rpool.cacheMessage(_msg_idx);
             rmsgstub.clear();
         }
     }
@@ -1223,7 +1885,7 @@ bool Service::doTryPushMessageToConnection(
         success = _rcon.tryPushMessage(configuration(), rmsgstub.msgbundle, rmsgstub.msgid, MessageId());
 
         if (success) {
-            rpool.msgcache_inner_list.pushBack(_rmsg_id.index);
+            rpool.cacheMessage(_rmsg_id.index);
             rmsgstub.clear();
         }
     }
@@ -1250,6 +1912,8 @@ ErrorConditionT Service::pollPoolForUpdates(
         return error;
     }
 
+    doDrainPoolSubmissions(pool_index, _robjuid);
+
     if (rpool.isMainConnectionStopping() && rpool.main_connection_id != _robjuid) {
 
         solid_dbg(logger, Info, this << ' ' << &_rconnection << " switch message main connection from " << rpool.main_connection_id << " to " << _robjuid);
@@ -1261,6 +1925,7 @@ ErrorConditionT Service::pollPoolForUpdates(
         rpool.main_connection_id = _robjuid;
         rpool.resetMainConnectionStopping();
         rpool.setMainConnectionActive();
+        rpool.enableSubmit();
     }
 
     if (_rcompleted_msgid.isValid()) {
@@ -1358,6 +2023,39 @@ void Service::rejectNewPoolMessage(Connection const& _rconnection)
     doTryNotifyPoolWaitingConnection(pool_index);
 }
 //-----------------------------------------------------------------------------
+//Moves the submitted messages to the pool's lists and notifies the
+//connections like doSendMessageToPool does. _rconsumer_uid is the
+//connection polling the pool, if any - it will take the messages itself.
+void Service::doDrainPoolSubmissions(const size_t _pool_index, ObjectIdT const& _rconsumer_uid)
+{
+    //the pool mutex must be locked
+
+    ConnectionPoolStub& rpool(impl_->pooldq[_pool_index]);
+    bool                has_synchronous;
+    bool                has_asynchronous;
+
+    if (!rpool.drainSubmitQueue(has_synchronous, has_asynchronous)) {
+        return;
+    }
+
+    solid_dbg(logger, Verbose, this << " pool " << _pool_index << " drained submitted messages: " << rpool.msgorder_inner_list);
+
+    bool success = false;
+
+    if (has_synchronous && rpool.isMainConnectionActive()) {
+        success = rpool.isMainConnection(_rconsumer_uid) || manager().notify(rpool.main_connection_id, Connection::eventNewMessage());
+    }
+
+    if (!success && has_asynchronous) {
+        success = _rconsumer_uid.isValid() || doTryNotifyPoolWaitingConnection(_pool_index);
+    }
+
+    if (!success) {
+        ErrorConditionT error;
+        doTryCreateNewConnectionForPool(_pool_index, error);
+    }
+}
+//-----------------------------------------------------------------------------
 bool Service::doTryNotifyPoolWaitingConnection(const size_t _pool_index)
 {
 
@@ -1401,7 +2099,7 @@ ErrorConditionT Service::doDelayCloseConnectionPool(
     solid_dbg(logger, Verbose, this << " pool " << pool_index << " set closing");
 
     if (rpool.name.size()) {
-        impl_->namemap.erase(rpool.name.c_str());
+        impl_->eraseName(rpool.name.c_str());
     }
 
     MessagePointerT empty_msg_ptr;
@@ -1447,7 +2145,7 @@ ErrorConditionT Service::doForceCloseConnectionPool(
     solid_dbg(logger, Verbose, this << " pool " << pool_index << " set fast closing");
 
     if (rpool.name.size()) {
-        impl_->namemap.erase(rpool.name.c_str());
+        impl_->eraseName(rpool.name.c_str());
     }
 
     MessagePointerT empty_msg_ptr;
@@ -1507,7 +2205,7 @@ ErrorConditionT Service::cancelMessage(RecipientId const& _rrecipient_id, Messag
 
                 if (success) {
                     rmsgstub.clear();
-                    rpool.msgcache_inner_list.pushBack(_rmsg_id.index);
+                    rpool.cacheMessage(_rmsg_id.index);
                 } else {
                     rmsgstub.msgid = MessageId();
                     rmsgstub.objid = ObjectIdT();
@@ -1682,7 +2380,7 @@ bool Service::fetchCanceledMessage(Connection const& _rcon, MessageId const& _rm
         _rmsg_bundle = std::move(rmsgstub.msgbundle);
 
         rmsgstub.clear();
-        rpool.msgcache_inner_list.pushBack(_rmsg_id.index);
+        rpool.cacheMessage(_rmsg_id.index);
         return true;
     }
     return false;
@@ -1723,6 +2421,11 @@ bool Service::connectionStopping(
 
     solid_dbg(logger, Info, this << ' ' << pool_index << " active_connection_count " << rpool.active_connection_count << " pending_connection_count " << rpool.pending_connection_count);
 
+    if (rpool.isMainConnection(_robjuid)) {
+        //the senders go through the pool mutex until another connection becomes active
+        rpool.disableSubmit();
+    }
+
     if (!rpool.isMainConnection(_robjuid)) {
         return doNonMainConnectionStopping(_rcon, _robjuid, _rseconds_to_wait, _rmsg_id, _rmsg_bundle, _revent_context, _rerror);
     } else if (!rpool.isLastConnection()) {
@@ -1903,7 +2606,7 @@ bool Service::doMainConnectionStoppingCleanAll(
         rpool.resetCleaningAllMessages();
 
         if (rpool.name.size() && !rpool.isClosing()) { //closing pools are already unregistered from namemap
-            impl_->namemap.erase(rpool.name.c_str());
+            impl_->eraseName(rpool.name.c_str());
             rpool.setClosing();
             solid_dbg(logger, Verbose, this << " pool " << pool_index << " set closing");
         }
@@ -1949,7 +2652,7 @@ bool Service::doMainConnectionStoppingPrepareCleanOneShot(
         ++rpool.stopping_connection_count;
 
         if (rpool.name.size() && !rpool.isClosing()) { //closing pools are already unregistered from namemap
-            impl_->namemap.erase(rpool.name.c_str());
+            impl_->eraseName(rpool.name.c_str());
             rpool.setClosing();
             solid_dbg(logger, Verbose, this << " pool " << pool_index << " set closing");
         }
@@ -1974,7 +2677,7 @@ bool Service::doMainConnectionStoppingPrepareCleanAll(
     ConnectionPoolStub& rpool(impl_->pooldq[pool_index]);
 
     if (rpool.name.size() && !rpool.isClosing()) { //closing pools are already unregistered from namemap
-        impl_->namemap.erase(rpool.name.c_str());
+        impl_->eraseName(rpool.name.c_str());
     }
 
     rpool.setCleaningAllMessages();
@@ -2078,7 +2781,7 @@ void Service::connectionStop(Connection const& _rcon)
         impl_->conpoolcachestk.push(pool_index);
 
         if (rpool.name.size() && !rpool.isClosing()) { //closing pools are already unregistered from namemap
-            impl_->namemap.erase(rpool.name.c_str());
+            impl_->eraseName(rpool.name.c_str());
         }
 
         rpool.clear();
@@ -2257,6 +2960,7 @@ ErrorConditionT Service::activateConnection(Connection& _rconnection, ObjectIdT
         rpool.main_connection_id = _robjuid;
         rpool.resetMainConnectionStopping();
         rpool.setMainConnectionActive();
+        rpool.enableSubmit();
 
         return error;
     }
@@ -2271,6 +2975,12 @@ ErrorConditionT Service::activateConnection(Connection& _rconnection, ObjectIdT
 
     --rpool.pending_connection_count;
     ++rpool.active_connection_count;
+
+    if (rpool.isMainConnection(_robjuid)) {
+        //so that the new synchronous messages wake it up
+        rpool.setMainConnectionActive();
+    }
+    rpool.enableSubmit();
     {
         ErrorConditionT err;
         doTryCreateNewConnectionForPool(pool_index, err);
@@ -2279,7 +2989,7 @@ ErrorConditionT Service::activateConnection(Connection& _rconnection, ObjectIdT
     return error;
 }
 //-----------------------------------------------------------------------------
-void Service::acceptIncomingConnection(SocketDevice& _rsd)
+void Service::acceptIncomingConnection(SocketDevice& _rsd, const size_t _reactor_index)
 {
 
     solid_dbg(logger, Verbose, this);
@@ -2306,8 +3016,15 @@ void Service::acceptIncomingConnection(SocketDevice& _rsd)
 
         solid::ErrorConditionT error;
 
-        ObjectIdT con_id = impl_->config.scheduler().startObject(
-            objptr, *this, make_event(GenericEvents::Start), error);
+        ObjectIdT con_id;
+
+        if (impl_->config.server.listener_sharded) {
+            con_id = impl_->config.scheduler().startObject(
+                objptr, *this, _reactor_index, make_event(GenericEvents::Start), error);
+        } else {
+            con_id = impl_->config.scheduler().startObject(
+                objptr, *this, make_event(GenericEvents::Start), error);
+        }
 
         solid_dbg(logger, Info, this << " receive connection [" << con_id << "] error = " << error.message());
 
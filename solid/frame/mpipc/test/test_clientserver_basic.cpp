@@ -276,6 +276,8 @@ int test_clientserver_basic(int argc, char* argv[])
 
     bool secure   = false;
     bool compress = false;
+    bool sharded  = false;
+    bool zerocopy = false;
 
     if (argc > 2) {
         if (*argv[2] == 's' || *argv[2] == 'S') {
@@ -288,6 +290,12 @@ int test_clientserver_basic(int argc, char* argv[])
             secure   = true;
             compress = true;
         }
+        if (*argv[2] == 'r' || *argv[2] == 'R') {
+            sharded = true;
+        }
+        if (*argv[2] == 'z' || *argv[2] == 'Z') {
+            zerocopy = true;
+        }
     }
 
     for (int j = 0; j < 1; ++j) {
@@ -325,7 +333,7 @@ int test_clientserver_basic(int argc, char* argv[])
             return 1;
         }
 
-        err = sch_server.start(1);
+        err = sch_server.start(sharded ? 4 : 1);
 
         if (err) {
             solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
@@ -355,6 +363,12 @@ int test_clientserver_basic(int argc, char* argv[])
             cfg.server.connection_start_fnc = &server_connection_start;
 
             cfg.server.listener_address_str = "0.0.0.0:0";
+            cfg.server.listener_sharded     = sharded;
+
+            if (zerocopy) {
+                //small enough for most of the sends to use MSG_ZEROCOPY
+                cfg.connection_send_zero_copy_threshold = 1024;
+            }
 
             if (secure) {
                 solid_dbg(generic_logger, Info, "Configure SSL server -------------------------------------");
@@ -404,6 +418,10 @@ int test_clientserver_basic(int argc, char* argv[])
 
             cfg.pool_max_active_connection_count = max_per_pool_connection_count;
 
+            if (zerocopy) {
+                cfg.connection_send_zero_copy_threshold = 1024;
+            }
+
             cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str() /*, SocketInfo::Inet4*/);
 
             if (secure) {
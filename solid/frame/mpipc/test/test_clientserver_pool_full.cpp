@@ -0,0 +1,239 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             sent_count     = 0;
+size_t             received_count = 0;
+size_t             error_count    = 0;
+bool               blocked        = false;
+bool               unblock        = false;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+//completing the first message keeps the client reactor busy until the test
+//filled the pool, so no connection takes messages from the pool meanwhile
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        unique_lock<mutex> lock(mtx);
+
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        ++sent_count;
+        cnd.notify_all();
+
+        if (_rsent_msg_ptr->idx == 0) {
+            blocked = true;
+            cnd.wait(lock, []() { return unblock; });
+        }
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++received_count;
+        cnd.notify_all();
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+} //namespace
+
+//Messages sent to an active pool go through its lock-free submission queue.
+//They must still count against pool_max_message_queue_size.
+int test_clientserver_pool_full(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    size_t message_count = 10;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (message_count == 0) {
+        message_count = 1;
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &connection_start;
+
+        cfg.pool_max_active_connection_count = 1;
+        cfg.pool_max_message_queue_size      = message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(0), 0);
+    SOLID_CHECK(!err, "sendMessage: " << err.message());
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(10), []() { return blocked; })) {
+            cout << "First message not sent" << endl;
+            return 1;
+        }
+    }
+
+    //the pool is empty and its connection does not take messages
+    for (size_t i = 1; i <= message_count; ++i) {
+        err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(i), 0);
+        SOLID_CHECK(!err, "sendMessage " << i << ": " << err.message());
+    }
+
+    err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(message_count + 1), 0);
+    SOLID_CHECK(err == frame::mpipc::error_service_pool_full, "expected error_service_pool_full, got: " << err.message());
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        unblock = true;
+        cnd.notify_all();
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(120), [message_count]() { return received_count >= message_count + 1 && sent_count >= message_count + 1; })) {
+            cout << "Messages not sent or received: " << sent_count << ' ' << received_count << " != " << message_count + 1 << endl;
+            return 1;
+        }
+
+        if (error_count != 0) {
+            cout << "Messages completed with error: " << error_count << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             sent_count  = 0;
+size_t             error_count = 0;
+vector<uint32_t>   received_vec;
+bool               wrong_data = false;
+bool               all_queued = false;
+
+const size_t message_size = 2 * 1024 * 1024;
+
+//the first half of the messages has normal priority, the second half high priority
+size_t message_count = 8;
+
+bool is_high_priority(const uint32_t _idx)
+{
+    return _idx >= message_count / 2;
+}
+
+struct Message : frame::mpipc::Message {
+    uint32_t    idx;
+    std::string str;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+        , str(message_size, static_cast<char>('a' + _idx % 26))
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+        _s.add(_rthis.str, _rctx, "str");
+    }
+};
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        ++sent_count;
+        cnd.notify_all();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        if (!_rrecv_msg_ptr->isOnPeer()) {
+            SOLID_THROW("Message not on peer!.");
+        }
+        lock_guard<mutex> lock(mtx);
+
+        //the priority travels with the message flags
+        if (
+            _rrecv_msg_ptr->str.size() != message_size || _rrecv_msg_ptr->str[message_size - 1] != static_cast<char>('a' + _rrecv_msg_ptr->idx % 26) || frame::mpipc::Message::is_high_priority(_rrecv_msg_ptr->flags()) != is_high_priority(_rrecv_msg_ptr->idx)) {
+            solid_dbg(generic_logger, Error, "wrong message " << _rrecv_msg_ptr->idx);
+            wrong_data = true;
+        }
+        received_vec.emplace_back(_rrecv_msg_ptr->idx);
+        cnd.notify_all();
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+//the client connection becomes active only after all the messages were queued
+//so they reach the message writer together
+void client_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    {
+        unique_lock<mutex> lock(mtx);
+        cnd.wait(lock, []() { return all_queued; });
+    }
+    connection_start(_rctx);
+}
+
+} //namespace
+
+//Sends large normal priority messages followed by large high priority ones.
+//The high priority messages must all arrive before any of the normal ones,
+//which only get one packet for every WriterConfiguration::high_priority_weight.
+int test_clientserver_priority(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]) * 2;
+    }
+    if (message_count == 0) {
+        message_count = 2;
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &client_connection_start;
+
+        cfg.pool_max_message_queue_size = message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    for (uint32_t i = 0; i < message_count; ++i) {
+        frame::mpipc::MessageFlagsT flags;
+
+        if (is_high_priority(i)) {
+            flags |= frame::mpipc::MessageFlagsE::HighPriority;
+        }
+
+        err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(i), flags);
+        SOLID_CHECK(!err, "sendMessage: " << err.message());
+    }
+
+    {
+        lock_guard<mutex> lock(mtx);
+        all_queued = true;
+        cnd.notify_all();
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return received_vec.size() >= message_count && sent_count >= message_count; })) {
+            cout << "Messages not sent or received: " << sent_count << ' ' << received_vec.size() << " != " << message_count << endl;
+            return 1;
+        }
+
+        if (wrong_data) {
+            cout << "Messages received with wrong data" << endl;
+            return 1;
+        }
+
+        if (error_count != 0) {
+            cout << "Messages completed with error: " << error_count << endl;
+            return 1;
+        }
+
+        cout << "Received:";
+        for (const auto idx : received_vec) {
+            cout << ' ' << idx;
+        }
+        cout << endl;
+
+        for (size_t i = 0; i < message_count / 2; ++i) {
+            if (!is_high_priority(received_vec[i])) {
+                cout << "Normal priority message received before a high priority one" << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
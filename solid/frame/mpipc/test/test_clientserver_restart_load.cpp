@@ -0,0 +1,267 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             message_count   = 20000;
+size_t             sent_count      = 0;
+size_t             error_count     = 0;
+size_t             received_count  = 0; //distinct messages received by the server
+size_t             restart_count   = 0;
+size_t             next_restart_at = 0;
+vector<bool>       received_vec;
+
+//every eighth message is synchronous so it goes on the main connection
+bool is_synchronous(const uint32_t _idx)
+{
+    return (_idx % 8) == 0;
+}
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+//stops the main connection - the one completing a synchronous message -
+//a few times while the senders keep the pool loaded
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        ++sent_count;
+
+        if (sent_count >= next_restart_at && is_synchronous(_rsent_msg_ptr->idx) && _rctx.service().closeConnection(_rctx.recipientId())) {
+            solid_dbg(generic_logger, Warning, "stop main connection " << _rctx.recipientId() << " after " << sent_count << " messages");
+            ++restart_count;
+            next_restart_at += message_count / 4;
+        }
+        cnd.notify_all();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        //an idempotent message may come again after its connection stopped
+        if (_rrecv_msg_ptr->idx < received_vec.size() && !received_vec[_rrecv_msg_ptr->idx]) {
+            received_vec[_rrecv_msg_ptr->idx] = true;
+            ++received_count;
+        }
+        cnd.notify_all();
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void send_messages(frame::mpipc::ServiceT& _rsvc, const uint32_t _first, const uint32_t _last)
+{
+    for (uint32_t i = _first; i < _last; ++i) {
+        frame::mpipc::MessageFlagsT flags{frame::mpipc::MessageFlagsE::Idempotent};
+
+        if (is_synchronous(i)) {
+            flags |= frame::mpipc::MessageFlagsE::Synchronous;
+        }
+
+        const ErrorConditionT err = _rsvc.sendMessage("localhost", std::make_shared<Message>(i), flags);
+        SOLID_CHECK(!err, "sendMessage " << i << ": " << err.message());
+
+        if ((i % 256) == 0) {
+            //leave the connections time to stop and restart while messages are still sent
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    }
+}
+
+} //namespace
+
+//The main connection of a loaded pool stops a few times and another
+//connection takes over. The senders go through the pool mutex while there is
+//no active main connection and every message must still reach the server.
+int test_clientserver_restart_load(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (message_count < 8) {
+        message_count = 8;
+    }
+
+    received_vec.resize(message_count, false);
+    next_restart_at = message_count / 4;
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &connection_start;
+
+        cfg.pool_max_active_connection_count = 4;
+        cfg.pool_max_message_queue_size      = message_count;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    //the first message creates the pool
+    send_messages(mpipcclient, 0, 1);
+
+    {
+        thread sender_thr(send_messages, std::ref(mpipcclient), 1, static_cast<uint32_t>(message_count / 2));
+        send_messages(mpipcclient, static_cast<uint32_t>(message_count / 2), static_cast<uint32_t>(message_count));
+        sender_thr.join();
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return received_count >= message_count && sent_count >= message_count; })) {
+            cout << "Messages not sent or received: " << sent_count << ' ' << received_count << " != " << message_count << " restarts: " << restart_count << endl;
+            return 1;
+        }
+
+        cout << "Main connection restarts: " << restart_count << endl;
+
+        if (error_count != 0) {
+            cout << "Messages completed with error: " << error_count << endl;
+            return 1;
+        }
+
+        if (restart_count == 0) {
+            cout << "The main connection was not restarted" << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
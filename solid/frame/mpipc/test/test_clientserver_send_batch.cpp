@@ -0,0 +1,354 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcerror.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             sent_count     = 0;
+size_t             error_count    = 0;
+size_t             received_count = 0;
+bool               out_of_order   = false;
+size_t             pool_count     = 0; //the messages sent through the client pool
+size_t             back_size      = 0; //the batch the server sends back on the connection
+size_t             back_count     = 0;
+bool               back_error     = false;
+
+frame::mpipc::RecipientId client_connection_id;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+using MessageVectorT = std::vector<std::shared_ptr<Message>>;
+
+void create_batch(MessageVectorT& _rmsgvec, const size_t _count, uint32_t& _ridx)
+{
+    _rmsgvec.clear();
+    for (size_t i = 0; i < _count; ++i) {
+        _rmsgvec.emplace_back(std::make_shared<Message>(_ridx++));
+    }
+}
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        ++sent_count;
+        cnd.notify_one();
+    }
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        if (_rrecv_msg_ptr->idx != back_count) {
+            solid_dbg(generic_logger, Error, "received back " << _rrecv_msg_ptr->idx << " expected " << back_count);
+            out_of_order = true;
+        }
+        ++back_count;
+        cnd.notify_one();
+    }
+}
+
+//the messages are synchronous so they must arrive in the order they were sent
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        if (!_rrecv_msg_ptr->isOnPeer()) {
+            SOLID_THROW("Message not on peer!.");
+        }
+        lock_guard<mutex> lock(mtx);
+
+        if (_rrecv_msg_ptr->idx != received_count) {
+            solid_dbg(generic_logger, Error, "received " << _rrecv_msg_ptr->idx << " expected " << received_count);
+            out_of_order = true;
+        }
+        ++received_count;
+
+        if (received_count == pool_count) {
+            //send a batch back on the connection - to a server side pool
+            const frame::mpipc::MessageFlagsT flags{frame::mpipc::MessageFlagsE::Synchronous};
+            frame::mpipc::MessageIdVectorT    msgid_vec;
+            MessageVectorT                    msgvec;
+            uint32_t                          idx = 0;
+
+            create_batch(msgvec, back_size, idx);
+
+            const ErrorConditionT err = _rctx.service().sendMessages(_rctx.recipientId(), msgvec.begin(), msgvec.end(), msgid_vec, flags);
+
+            if (err || msgid_vec.size() != back_size) {
+                solid_dbg(generic_logger, Error, "sending back: " << err.message());
+                back_error = true;
+            }
+        }
+        cnd.notify_one();
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+void client_connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    {
+        lock_guard<mutex> lock(mtx);
+        client_connection_id = _rctx.recipientId();
+    }
+    connection_start(_rctx);
+}
+
+} //namespace
+
+int test_clientserver_send_batch(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    size_t batch_count = 20;
+    size_t batch_size  = 100;
+
+    if (argc > 1) {
+        batch_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        batch_size = atoi(argv[2]);
+    }
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &client_connection_start;
+
+        cfg.pool_max_message_queue_size = batch_count * batch_size + 1;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    pool_count = batch_count * batch_size;
+    back_size  = batch_size;
+
+    const frame::mpipc::MessageFlagsT flags{frame::mpipc::MessageFlagsE::Synchronous};
+    frame::mpipc::RecipientId         recipient_id;
+    frame::mpipc::MessageIdVectorT    msgid_vec;
+    MessageVectorT                    msgvec;
+    uint32_t                          crtidx = 0;
+
+    //the first batch creates the pool
+    create_batch(msgvec, batch_size, crtidx);
+
+    err = mpipcclient.sendMessages("localhost", msgvec.begin(), msgvec.end(), recipient_id, msgid_vec, flags);
+    SOLID_CHECK(!err, "sendMessages: " << err.message());
+    SOLID_CHECK(recipient_id.isValidPool(), "invalid recipient id");
+    SOLID_CHECK(msgid_vec.size() == batch_size, "wrong message id count");
+
+    for (size_t i = 1; i < batch_count; ++i) {
+        create_batch(msgvec, batch_size, crtidx);
+
+        if (i % 2) {
+            err = mpipcclient.sendMessages("localhost", msgvec.begin(), msgvec.end(), flags);
+        } else {
+            err = mpipcclient.sendMessages(recipient_id, msgvec.begin(), msgvec.end(), msgid_vec, flags);
+
+            for (const auto& msgid : msgid_vec) {
+                SOLID_CHECK(msgid.isValid(), "invalid message id");
+            }
+        }
+        SOLID_CHECK(!err, "sendMessages: " << err.message());
+    }
+
+    { //none of the messages is sent if one of them is wrong
+        MessageVectorT bad_msgvec;
+        uint32_t       bad_idx = 0;
+
+        create_batch(bad_msgvec, 3, bad_idx);
+        bad_msgvec[1].reset();
+
+        err = mpipcclient.sendMessages("localhost", bad_msgvec.begin(), bad_msgvec.end(), flags);
+        SOLID_CHECK(err == frame::mpipc::error_service_message_null, "expected error_service_message_null, got: " << err.message());
+
+        create_batch(bad_msgvec, batch_count * batch_size + 2, bad_idx);
+
+        err = mpipcclient.sendMessages("localhost", bad_msgvec.begin(), bad_msgvec.end(), flags);
+        SOLID_CHECK(err == frame::mpipc::error_service_pool_full, "expected error_service_pool_full, got: " << err.message());
+    }
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(120), []() { return received_count >= pool_count && sent_count >= pool_count; })) {
+            cout << "Messages not sent or received: " << sent_count << ' ' << received_count << " != " << pool_count << endl;
+            return 1;
+        }
+    }
+
+    { //a batch on the client connection - to a client side pool
+        frame::mpipc::RecipientId connection_id;
+        {
+            lock_guard<mutex> lock(mtx);
+            connection_id = client_connection_id;
+        }
+        SOLID_CHECK(connection_id.isValidConnection(), "invalid client connection id");
+
+        create_batch(msgvec, batch_size, crtidx);
+
+        err = mpipcclient.sendMessages(connection_id, msgvec.begin(), msgvec.end(), msgid_vec, flags);
+        SOLID_CHECK(!err, "sendMessages to connection: " << err.message());
+        SOLID_CHECK(msgid_vec.size() == batch_size, "wrong message id count");
+    }
+
+    const size_t total_count = pool_count + batch_size;
+
+    {
+        unique_lock<mutex> lock(mtx);
+
+        if (!cnd.wait_for(lock, std::chrono::seconds(120), [total_count]() { return received_count >= total_count && sent_count >= total_count && back_count >= back_size; })) {
+            cout << "Messages not sent or received: " << sent_count << ' ' << received_count << " != " << total_count << " back: " << back_count << " != " << back_size << endl;
+            return 1;
+        }
+
+        if (back_error) {
+            cout << "Error sending messages back on the connection" << endl;
+            return 1;
+        }
+
+        if (out_of_order) {
+            cout << "Messages received out of order" << endl;
+            return 1;
+        }
+
+        if (error_count != 0) {
+            cout << "Messages completed with error: " << error_count << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex               mtx;
+condition_variable  cnd;
+std::atomic<size_t> sent_count(0);
+std::atomic<size_t> error_count(0);
+std::atomic<size_t> expected_count(0);
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        if (++sent_count == expected_count) {
+            lock_guard<mutex> lock(mtx);
+            cnd.notify_one();
+        }
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr && !_rrecv_msg_ptr->isOnPeer()) {
+        SOLID_THROW("Message not on peer!.");
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+std::string recipient_name(const size_t _idx)
+{
+    return "peer" + std::to_string(_idx);
+}
+
+bool wait_sent(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+
+    return cnd.wait_for(lock, std::chrono::seconds(120), [_count]() { return sent_count >= _count; });
+}
+
+} //namespace
+
+//Measures how many small messages per second concurrent threads can push
+//through frame::mpipc::Service::sendMessage. Every thread sends to its own
+//recipient name, so the threads only share the service.
+//With a batch_size greater than 1, the threads use sendMessages instead.
+int test_clientserver_send_perf(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    size_t message_count = 20000; //per thread
+    size_t thread_max    = 8;
+    size_t batch_size    = 1;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        thread_max = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        batch_size = atoi(argv[3]);
+    }
+    if (thread_max == 0) {
+        thread_max = 1;
+    }
+    if (batch_size == 0) {
+        batch_size = 1;
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(2);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(2);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &connection_start;
+
+        //no sendMessage should fail with error_service_pool_full
+        cfg.pool_max_message_queue_size = message_count + 1;
+
+        //all the recipient names are the same server
+        frame::mpipc::InternetResolverF resolve_fnc(resolver, server_port.c_str());
+
+        cfg.client.name_resolve_fnc = [resolve_fnc](const std::string&, frame::mpipc::ResolveCompleteFunctionT& _rcbk) mutable {
+            resolve_fnc("localhost", _rcbk);
+        };
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    //create the pools and their connections before measuring
+    expected_count = thread_max;
+
+    for (size_t i = 0; i < thread_max; ++i) {
+        err = mpipcclient.sendMessage(recipient_name(i).c_str(), std::make_shared<Message>(0), {});
+        SOLID_CHECK(!err, "sendMessage: " << err.message());
+    }
+
+    if (!wait_sent(expected_count)) {
+        SOLID_THROW("Connections not ready.");
+    }
+
+    for (size_t thread_count = 1; thread_count <= thread_max; thread_count *= 2) {
+        const size_t             start_count = sent_count;
+        std::atomic<size_t>      ready_count(0);
+        std::atomic<bool>        go(false);
+        std::atomic<size_t>      send_error_count(0);
+        std::vector<std::thread> thr_vec;
+
+        expected_count = start_count + thread_count * message_count;
+
+        for (size_t t = 0; t < thread_count; ++t) {
+            thr_vec.emplace_back(
+                [&, t]() {
+                    const std::string                     name = recipient_name(t);
+                    std::vector<std::shared_ptr<Message>> msgvec;
+
+                    ++ready_count;
+                    while (!go) {
+                        std::this_thread::yield();
+                    }
+
+                    if (batch_size == 1) {
+                        for (size_t i = 0; i < message_count; ++i) {
+                            if (mpipcclient.sendMessage(name.c_str(), std::make_shared<Message>(static_cast<uint32_t>(i)), {})) {
+                                ++send_error_count;
+                            }
+                        }
+                        return;
+                    }
+
+                    for (size_t i = 0; i < message_count;) {
+                        msgvec.clear();
+                        for (; i < message_count && msgvec.size() < batch_size; ++i) {
+                            msgvec.emplace_back(std::make_shared<Message>(static_cast<uint32_t>(i)));
+                        }
+                        if (mpipcclient.sendMessages(name.c_str(), msgvec.begin(), msgvec.end())) {
+                            ++send_error_count;
+                        }
+                    }
+                });
+        }
+
+        while (ready_count != thread_count) {
+            std::this_thread::yield();
+        }
+
+        const auto start_time = std::chrono::steady_clock::now();
+
+        go = true;
+
+        for (auto& thr : thr_vec) {
+            thr.join();
+        }
+
+        const auto   send_time  = std::chrono::steady_clock::now() - start_time;
+        const double send_sec   = std::chrono::duration<double>(send_time).count();
+        const size_t total_sent = thread_count * message_count;
+
+        if (send_error_count != 0) {
+            cout << "sendMessage failed " << send_error_count << " times" << endl;
+            return 1;
+        }
+
+        if (!wait_sent(expected_count)) {
+            cout << "Messages not sent: " << (sent_count - start_count) << " != " << total_sent << endl;
+            return 1;
+        }
+
+        cout << "threads = " << thread_count << " batch = " << batch_size << " messages = " << total_sent
+             << " sendMessage rate = " << static_cast<size_t>(send_sec != 0 ? total_sent / send_sec : 0) << " msgs/sec" << endl;
+    }
+
+    if (error_count != 0) {
+        cout << "Messages completed with error: " << error_count << endl;
+        return 1;
+    }
+
+    return 0;
+}
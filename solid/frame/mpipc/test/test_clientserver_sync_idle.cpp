@@ -0,0 +1,223 @@
+#include "solid/frame/manager.hpp"
+#include "solid/frame/scheduler.hpp"
+#include "solid/frame/service.hpp"
+
+#include "solid/frame/aio/aioobject.hpp"
+#include "solid/frame/aio/aioreactor.hpp"
+#include "solid/frame/aio/aioresolver.hpp"
+
+#include "solid/frame/mpipc/mpipcconfiguration.hpp"
+#include "solid/frame/mpipc/mpipcprotocol_serialization_v2.hpp"
+#include "solid/frame/mpipc/mpipcservice.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "solid/system/exception.hpp"
+
+#include "solid/system/log.hpp"
+
+#include <iostream>
+
+using namespace std;
+using namespace solid;
+
+using AioSchedulerT = frame::Scheduler<frame::aio::Reactor>;
+using ProtocolT     = frame::mpipc::serialization_v2::Protocol<uint8_t>;
+
+namespace {
+
+mutex              mtx;
+condition_variable cnd;
+size_t             sent_count     = 0;
+size_t             received_count = 0;
+size_t             error_count    = 0;
+
+struct Message : frame::mpipc::Message {
+    uint32_t idx;
+
+    Message(uint32_t _idx)
+        : idx(_idx)
+    {
+    }
+    Message()
+        : idx(0)
+    {
+    }
+
+    SOLID_PROTOCOL_V2(_s, _rthis, _rctx, _name)
+    {
+        _s.add(_rthis.idx, _rctx, "idx");
+    }
+};
+
+void client_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rsent_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+
+        if (_rerror) {
+            solid_dbg(generic_logger, Error, _rctx.recipientId() << " error: " << _rerror.message());
+            ++error_count;
+        }
+        ++sent_count;
+        cnd.notify_one();
+    }
+}
+
+void server_complete_message(
+    frame::mpipc::ConnectionContext& _rctx,
+    std::shared_ptr<Message>& _rsent_msg_ptr, std::shared_ptr<Message>& _rrecv_msg_ptr,
+    ErrorConditionT const& _rerror)
+{
+    if (_rrecv_msg_ptr) {
+        lock_guard<mutex> lock(mtx);
+        ++received_count;
+        cnd.notify_one();
+    }
+}
+
+void connection_start(frame::mpipc::ConnectionContext& _rctx)
+{
+    auto lambda = [](frame::mpipc::ConnectionContext&, ErrorConditionT const& _rerror) {
+        return frame::mpipc::MessagePointerT();
+    };
+    _rctx.service().connectionNotifyEnterActiveState(_rctx.recipientId(), lambda);
+}
+
+bool wait_count(const size_t _count)
+{
+    unique_lock<mutex> lock(mtx);
+
+    //well below the keepalive timeout, which would also wake the connection
+    return cnd.wait_for(lock, std::chrono::seconds(10), [_count]() { return received_count >= _count && sent_count >= _count; });
+}
+
+} //namespace
+
+//Synchronous messages sent on a pool whose main connection is active and idle
+//must wake the main connection - they cannot go on any other connection.
+int test_clientserver_sync_idle(int argc, char* argv[])
+{
+
+    solid::log_start(std::cerr, {".*:EW"});
+
+    size_t message_count = 5;
+
+    if (argc > 1) {
+        message_count = atoi(argv[1]);
+    }
+
+    AioSchedulerT sch_client;
+    AioSchedulerT sch_server;
+
+    frame::Manager         m;
+    frame::mpipc::ServiceT mpipcserver(m);
+    frame::mpipc::ServiceT mpipcclient(m);
+    ErrorConditionT        err;
+
+    frame::aio::Resolver resolver;
+
+    err = sch_client.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio client scheduler: " << err.message());
+        return 1;
+    }
+
+    err = sch_server.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio server scheduler: " << err.message());
+        return 1;
+    }
+
+    err = resolver.start(1);
+
+    if (err) {
+        solid_dbg(generic_logger, Error, "starting aio resolver: " << err.message());
+        return 1;
+    }
+
+    std::string server_port;
+
+    { //mpipc server initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_server, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(server_complete_message, 1);
+
+        cfg.server.connection_start_fnc = &connection_start;
+        cfg.server.listener_address_str = "0.0.0.0:0";
+
+        err = mpipcserver.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting server mpipcservice: " << err.message());
+            return 1;
+        }
+
+        {
+            std::ostringstream oss;
+            oss << mpipcserver.configuration().server.listenerPort();
+            server_port = oss.str();
+        }
+    }
+
+    { //mpipc client initialization
+        auto                        proto = ProtocolT::create();
+        frame::mpipc::Configuration cfg(sch_client, proto);
+
+        proto->null(0);
+        proto->registerMessage<Message>(client_complete_message, 1);
+
+        cfg.client.connection_start_fnc = &connection_start;
+
+        cfg.pool_max_active_connection_count = 1;
+
+        cfg.client.name_resolve_fnc = frame::mpipc::InternetResolverF(resolver, server_port.c_str());
+
+        err = mpipcclient.reconfigure(std::move(cfg));
+
+        if (err) {
+            solid_dbg(generic_logger, Error, "starting client mpipcservice: " << err.message());
+            return 1;
+        }
+    }
+
+    //an asynchronous message creates the pool and activates its main connection
+    err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(0), 0);
+    SOLID_CHECK(!err, "sendMessage: " << err.message());
+
+    if (!wait_count(1)) {
+        cout << "First message not sent or received" << endl;
+        return 1;
+    }
+
+    for (size_t i = 1; i <= message_count; ++i) {
+        //let the connection go idle
+        this_thread::sleep_for(chrono::milliseconds(100));
+
+        err = mpipcclient.sendMessage("localhost", std::make_shared<Message>(i), {frame::mpipc::MessageFlagsE::Synchronous});
+        SOLID_CHECK(!err, "sendMessage: " << err.message());
+
+        if (!wait_count(i + 1)) {
+            cout << "Synchronous message " << i << " not sent or received" << endl;
+            return 1;
+        }
+    }
+
+    if (error_count != 0) {
+        cout << "Messages completed with error: " << error_count << endl;
+        return 1;
+    }
+
+    return 0;
+}
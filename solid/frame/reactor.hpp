@@ -104,6 +104,8 @@ public:
 
     void run();
     bool push(TaskT& _robj, Service& _rsvc, Event const& _revt);
+    //! Push a batch of objects with a single lock and at most one wakeup
+    bool push(TaskT* const* _ptasks, const size_t _count, Service& _rsvc, Event const& _revt);
 
     Service& service(ReactorContext const& _rctx) const;
 
@@ -11,7 +11,9 @@
 #pragma once
 
 #include "solid/frame/objectbase.hpp"
+#include "solid/frame/schedulerbase.hpp"
 #include "solid/utility/stack.hpp"
+#include <chrono>
 
 namespace solid {
 struct Event;
@@ -19,6 +21,8 @@ namespace frame {
 
 class Manager;
 class SchedulerBase;
+struct BusyPollConfiguration;
+struct ExecBudgetConfiguration;
 
 //! The base for every selector
 /*!
@@ -31,9 +35,21 @@ public:
     virtual bool raise(UniqueId const& _robjuid, Event&& _ue)      = 0;
     virtual void stop()                                            = 0;
 
-    bool   prepareThread(const bool _success);
-    void   unprepareThread();
-    size_t load() const;
+    //! Asynchronously move an object to another reactor of the same scheduler
+    /*!
+        Returns false if the reactor cannot move objects.
+    */
+    virtual bool migrateObject(UniqueId const& _robjuid, const size_t _reactor_index);
+
+    //! Asynchronously move up to _count of the most active objects to another reactor
+    virtual bool migrateBusiestObjects(const size_t _count, const size_t _reactor_index);
+
+    bool                     prepareThread(const bool _success);
+    void                     unprepareThread();
+    size_t                   load() const;
+    size_t                   idInScheduler() const;
+    std::chrono::nanoseconds busyTime() const;
+    void                     statistic(ReactorStatistic& _rstat) const;
 
 protected:
     typedef std::atomic<size_t> AtomicSizeT;
@@ -41,6 +57,8 @@ protected:
     ReactorBase(
         SchedulerBase& _rsch, const size_t _schidx, const size_t _crtidx = 0)
         : crtload(0)
+        , incomingcnt(0)
+        , timecompletions(false)
         , rsch(_rsch)
         , schidx(_schidx)
         , crtidx(_crtidx)
@@ -52,13 +70,68 @@ protected:
     UniqueId       popUid(ObjectBase& _robj);
     void           pushUid(UniqueId const& _ruid);
 
-    AtomicSizeT crtload;
+    BusyPollConfiguration const&   busyPollConfiguration() const;
+    ExecBudgetConfiguration const& execBudgetConfiguration() const;
+    bool                           timeCompletionsConfiguration() const;
+
+    //! Call _f as a completion callback - timed when timecompletions is set
+    template <class F>
+    void complete(F _f);
+
+    static void addCount(AtomicSizeT& _rcnt, const size_t _val);
+    static void maxCount(AtomicSizeT& _rcnt, const size_t _val);
+
+    //! Returns the reactor with the given index, preventing it from exiting until incomingcnt is decremented
+    ReactorBase* acquireReactor(const size_t _reactor_index);
+
+    //! Raise an event on another reactor of the scheduler
+    bool raiseOnReactor(const size_t _reactor_index, UniqueId const& _robjuid, Event&& _uevt);
+
+    //! Move the object to _rtarget if it is still registered on this reactor
+    /*!
+        _rfct is called with the object's mutex locked, before the manager
+        starts forwarding the object's events to _rtarget.
+    */
+    bool moveObject(ObjectBase& _robj, Manager& _rm, ReactorBase& _rtarget, ScheduleFunctionT& _rfct);
+
+    //! Counters written only by the reactor thread, on their own cache lines
+    /*!
+        See ReactorStatistic.
+    */
+    struct alignas(64) StatisticCounters {
+        StatisticCounters();
+
+        AtomicSizeT iteration_count;
+        AtomicSizeT wait_nsec;
+        AtomicSizeT busy_nsec;
+        AtomicSizeT wakeup_count;
+        AtomicSizeT event_count;
+        AtomicSizeT event_max;
+        AtomicSizeT exec_queue_max;
+        AtomicSizeT timer_count;
+        AtomicSizeT timer_fired_count;
+        AtomicSizeT inbox_count;
+        AtomicSizeT inbox_max;
+        AtomicSizeT completion_count;
+        AtomicSizeT exec_deferred_count;
+        AtomicSizeT exec_over_share_count;
+        AtomicSizeT poll_mod_request_count;
+        AtomicSizeT poll_mod_count;
+        AtomicSizeT spin_hit_count;
+        AtomicSizeT spin_miss_count;
+        AtomicSizeT completion_time_histogram[ReactorStatistic::CompletionTimeBucketCount];
+    };
+
+    AtomicSizeT       crtload;
+    AtomicSizeT       incomingcnt; //objects being moved onto this reactor
+    bool              timecompletions;
+    StatisticCounters statcnt;
 
     size_t runIndex(ObjectBase& _robj) const;
 
 private:
     friend class SchedulerBase;
-    size_t idInScheduler() const;
+    friend class Manager;
 
 private:
     typedef Stack<UniqueId> UidStackT;
@@ -89,6 +162,46 @@ inline size_t ReactorBase::load() const
     return crtload;
 }
 
+inline std::chrono::nanoseconds ReactorBase::busyTime() const
+{
+    return std::chrono::nanoseconds(statcnt.busy_nsec.load(std::memory_order_relaxed));
+}
+
+//single writer - no need for an atomic read-modify-write
+inline /*static*/ void ReactorBase::addCount(AtomicSizeT& _rcnt, const size_t _val)
+{
+    _rcnt.store(_rcnt.load(std::memory_order_relaxed) + _val, std::memory_order_relaxed);
+}
+
+inline /*static*/ void ReactorBase::maxCount(AtomicSizeT& _rcnt, const size_t _val)
+{
+    if (_val > _rcnt.load(std::memory_order_relaxed)) {
+        _rcnt.store(_val, std::memory_order_relaxed);
+    }
+}
+
+template <class F>
+inline void ReactorBase::complete(F _f)
+{
+    if (timecompletions) {
+        const auto start_tp = std::chrono::steady_clock::now();
+
+        _f();
+
+        size_t usec = static_cast<size_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_tp).count());
+        size_t idx  = 0;
+
+        while (usec != 0 && idx < (ReactorStatistic::CompletionTimeBucketCount - 1)) {
+            usec >>= 1;
+            ++idx;
+        }
+        addCount(statcnt.completion_time_histogram[idx], 1);
+    } else {
+        _f();
+    }
+    addCount(statcnt.completion_count, 1);
+}
+
 inline void ReactorBase::pushUid(UniqueId const& _ruid)
 {
     uidstk.push(_ruid);
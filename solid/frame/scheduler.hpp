@@ -13,6 +13,7 @@
 #include "solid/frame/manager.hpp"
 #include "solid/frame/schedulerbase.hpp"
 #include "solid/utility/dynamicpointer.hpp"
+#include <vector>
 
 namespace solid {
 namespace frame {
@@ -31,9 +32,10 @@ private:
     struct Worker {
         static void run(SchedulerBase* _psched, const size_t _idx)
         {
-            ReactorT reactor(*_psched, _idx);
+            const bool placed = SchedulerBase::placeThread(*_psched, _idx);
+            ReactorT   reactor(*_psched, _idx);
 
-            if (!reactor.prepareThread(reactor.start())) {
+            if (!reactor.prepareThread(placed && reactor.start())) {
                 return;
             }
             reactor.run();
@@ -70,6 +72,29 @@ private:
         }
     };
 
+    struct ScheduleBatchCommand {
+        std::vector<ObjectPointerT*> const& rptrvec;
+        Service&                            rsvc;
+        Event const&                        revt;
+        std::vector<ObjectPointerT*>        taskvec;
+
+        ScheduleBatchCommand(std::vector<ObjectPointerT*> const& _rptrvec, Service& _rsvc, Event const& _revt)
+            : rptrvec(_rptrvec)
+            , rsvc(_rsvc)
+            , revt(_revt)
+        {
+        }
+
+        bool operator()(ReactorBase& _rreactor, const size_t* _ppos, const size_t _count)
+        {
+            taskvec.clear();
+            for (size_t i = 0; i < _count; ++i) {
+                taskvec.push_back(rptrvec[_ppos[i]]);
+            }
+            return static_cast<ReactorT&>(_rreactor).push(taskvec.data(), taskvec.size(), rsvc, revt);
+        }
+    };
+
 public:
     Scheduler() {}
 
@@ -93,6 +118,46 @@ public:
         SchedulerBase::doStop(_wait);
     }
 
+    //! Must be called before start
+    void busyPoll(BusyPollConfiguration const& _rcfg)
+    {
+        SchedulerBase::doBusyPoll(_rcfg);
+    }
+
+    //! Must be called before start
+    void execBudget(ExecBudgetConfiguration const& _rcfg)
+    {
+        SchedulerBase::doExecBudget(_rcfg);
+    }
+
+    //! Must be called before start
+    /*!
+        Fills ReactorStatistic::completion_time_histogram at the cost of
+        reading the clock around every completion callback.
+    */
+    void timeCompletions(const bool _enable)
+    {
+        SchedulerBase::doTimeCompletions(_enable);
+    }
+
+    //! Must be called before start
+    void affinity(AffinityConfiguration const& _rcfg)
+    {
+        SchedulerBase::doAffinity(_rcfg);
+    }
+
+    //! Must be called before start
+    void rebalance(RebalanceConfiguration const& _rcfg)
+    {
+        SchedulerBase::doRebalance(_rcfg);
+    }
+
+    //! Fills one entry for every running reactor
+    void statistics(ReactorStatisticVectorT& _rstat_vec) const
+    {
+        SchedulerBase::doStatistics(_rstat_vec);
+    }
+
     ObjectIdT startObject(
         ObjectPointerT& _robjptr, Service& _rsvc,
         Event&& _revt, ErrorConditionT& _rerr)
@@ -102,6 +167,105 @@ public:
 
         return doStartObject(*_robjptr, _rsvc, fct, _rerr);
     }
+
+    //! Start the object on the given reactor instead of the least loaded one
+    /*!
+        _reactor_index must be less than reactorCount().
+        Used to keep an object on the reactor of the object creating it,
+        e.g. a connection on the reactor of its sharded listener.
+    */
+    ObjectIdT startObject(
+        ObjectPointerT& _robjptr, Service& _rsvc, const size_t _reactor_index,
+        Event&& _revt, ErrorConditionT& _rerr)
+    {
+        ScheduleCommand   cmd(_robjptr, _rsvc, std::move(_revt));
+        ScheduleFunctionT fct([&cmd](ReactorBase& _rreactor) { return cmd(_rreactor); });
+
+        return doStartObject(*_robjptr, _rsvc, _reactor_index, fct, _rerr);
+    }
+
+    //! Start a batch of objects - e.g. the connections accepted at once
+    /*!
+        [_first, _last) is a range of ObjectPointerT. The objects are spread
+        on the least loaded reactors and every reactor gets its share with a
+        single Manager registration - one lock per object chunk - and at most
+        one wakeup. Every object gets a copy of _revt.
+        _robjuid_vec gets one id for every object in [_first, _last), in the
+        same order - an invalid id for the objects not started.
+        The objects of a reactor are started or not together, so the failed
+        ones are not necessarily the last ones in the range.
+        Returns the number of started objects, _rerr tells why the others
+        were not.
+    */
+    template <class It>
+    size_t startObjects(
+        It _first, It _last, Service& _rsvc,
+        Event const& _revt, std::vector<ObjectIdT>& _robjuid_vec, ErrorConditionT& _rerr)
+    {
+        std::vector<ObjectPointerT*> ptrvec;
+        std::vector<ObjectBase*>     objvec;
+
+        doPrepareObjects(_first, _last, ptrvec, objvec);
+
+        ScheduleBatchCommand   cmd(ptrvec, _rsvc, _revt);
+        ScheduleBatchFunctionT fct([&cmd](ReactorBase& _rreactor, const size_t* _ppos, const size_t _count) { return cmd(_rreactor, _ppos, _count); });
+
+        _robjuid_vec.assign(objvec.size(), ObjectIdT());
+
+        return doStartObjects(objvec.data(), _robjuid_vec.data(), objvec.size(), _rsvc, fct, _rerr);
+    }
+
+    //! Start a batch of objects on the given reactor
+    /*!
+        Either all the objects are started or none - see above for _robjuid_vec.
+    */
+    template <class It>
+    size_t startObjects(
+        It _first, It _last, Service& _rsvc, const size_t _reactor_index,
+        Event const& _revt, std::vector<ObjectIdT>& _robjuid_vec, ErrorConditionT& _rerr)
+    {
+        std::vector<ObjectPointerT*> ptrvec;
+        std::vector<ObjectBase*>     objvec;
+
+        doPrepareObjects(_first, _last, ptrvec, objvec);
+
+        ScheduleBatchCommand   cmd(ptrvec, _rsvc, _revt);
+        ScheduleBatchFunctionT fct([&cmd](ReactorBase& _rreactor, const size_t* _ppos, const size_t _count) { return cmd(_rreactor, _ppos, _count); });
+
+        _robjuid_vec.assign(objvec.size(), ObjectIdT());
+
+        return doStartObjects(objvec.data(), _robjuid_vec.data(), objvec.size(), _rsvc, _reactor_index, fct, _rerr);
+    }
+
+    //! Asynchronously move a running object to the given reactor
+    /*!
+        The object keeps its id, its completion handlers, devices, timers and
+        pending posts.
+        Returns false if the object is not running on this scheduler or if
+        its reactor cannot move objects.
+    */
+    bool migrateObject(Manager& _rm, ObjectIdT const& _robjuid, const size_t _reactor_index)
+    {
+        return SchedulerBase::doMigrateObject(_rm, _robjuid, _reactor_index);
+    }
+
+    //! The number of reactors - zero if the scheduler is not running
+    size_t reactorCount() const
+    {
+        return SchedulerBase::doReactorCount();
+    }
+
+private:
+    template <class It>
+    static void doPrepareObjects(It _first, It _last, std::vector<ObjectPointerT*>& _rptrvec, std::vector<ObjectBase*>& _robjvec)
+    {
+        for (; _first != _last; ++_first) {
+            ObjectPointerT& robjptr = *_first;
+
+            _rptrvec.push_back(&robjptr);
+            _robjvec.push_back(robjptr.get());
+        }
+    }
 };
 
 } //namespace frame
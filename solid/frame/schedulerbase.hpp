@@ -13,19 +13,241 @@
 #include "solid/frame/common.hpp"
 #include "solid/system/error.hpp"
 #include "solid/system/pimpl.hpp"
+#include "solid/system/thread.hpp"
 #include "solid/utility/function.hpp"
+#include <array>
+#include <chrono>
 #include <thread>
+#include <vector>
 
 namespace solid {
 
+struct Event;
+
 namespace frame {
 
 class Service;
+class Manager;
 class ReactorBase;
 class ObjectBase;
 
+//! Opt-in busy polling for the reactors of a scheduler
+/*!
+    Before blocking, a reactor polls without blocking, for new events and
+    for its inbox, for up to its current spin window.
+    The window grows when the reactor is woken within spin_max after it
+    stopped spinning and shrinks when it sleeps longer, but it stays
+    within [spin_min, spin_max].
+    See ReactorStatistic::spin_hit_count and spin_miss_count.
+    Only frame::aio::Reactor on Linux busy polls.
+*/
+struct BusyPollConfiguration {
+    BusyPollConfiguration(
+        const std::chrono::microseconds _spin_max = std::chrono::microseconds(0),
+        const std::chrono::microseconds _spin_min = std::chrono::microseconds(10))
+        : spin_max(_spin_max)
+        , spin_min(_spin_min < _spin_max ? _spin_min : _spin_max)
+    {
+    }
+
+    bool enabled() const
+    {
+        return spin_max.count() != 0;
+    }
+
+    std::chrono::microseconds spin_max; //zero disables busy polling
+    std::chrono::microseconds spin_min;
+};
+
+//! Opt-in budget for the posted completions a reactor runs in one loop
+/*!
+    Without a budget, a reactor runs all the posted completions queued when
+    the loop started, however long they take, before polling for io again.
+    With a budget, it stops after max_count completions or after max_time,
+    whichever comes first, and continues in the next loop, after the io and
+    the timers.
+    An object runs at most object_max_count completions in one loop - the
+    rest wait for the next loop, so an object posting a lot does not delay
+    the completions of the others. The completions of an object keep
+    their order.
+    A zero value means no limit.
+    Only frame::aio::Reactor applies the budget.
+*/
+struct ExecBudgetConfiguration {
+    ExecBudgetConfiguration(
+        const size_t                    _max_count        = 0,
+        const std::chrono::microseconds _max_time         = std::chrono::microseconds(0),
+        const size_t                    _object_max_count = 0)
+        : max_count(_max_count)
+        , max_time(_max_time)
+        , object_max_count(_object_max_count)
+    {
+    }
+
+    bool enabled() const
+    {
+        return max_count != 0 || max_time.count() != 0 || object_max_count != 0;
+    }
+
+    size_t                    max_count;
+    std::chrono::microseconds max_time;
+    size_t                    object_max_count;
+};
+
+//! A snapshot of the runtime counters of a reactor
+/*!
+    The counters are written only by the reactor thread and read without
+    locking, so the fields of a snapshot can be a few events apart.
+    completion_time_histogram[i] counts the completion callbacks that took
+    [2^(i-1), 2^i) microseconds - the first bucket is below 1us and the last
+    one is open. It is only filled when the scheduler times the completions.
+    Only frame::aio::Reactor fills the counters.
+*/
+struct ReactorStatistic {
+    enum {
+        CompletionTimeBucketCount = 16,
+    };
+
+    using CompletionTimeHistogramT = std::array<size_t, CompletionTimeBucketCount>;
+
+    ReactorStatistic()
+        : iteration_count(0)
+        , wait_nsec(0)
+        , busy_nsec(0)
+        , wakeup_count(0)
+        , event_count(0)
+        , event_max(0)
+        , exec_queue_max(0)
+        , timer_count(0)
+        , timer_fired_count(0)
+        , inbox_count(0)
+        , inbox_max(0)
+        , completion_count(0)
+        , exec_deferred_count(0)
+        , exec_over_share_count(0)
+        , poll_mod_request_count(0)
+        , poll_mod_count(0)
+        , spin_hit_count(0)
+        , spin_miss_count(0)
+    {
+        completion_time_histogram.fill(0);
+    }
+
+    double eventsPerWakeup() const
+    {
+        return wakeup_count != 0 ? static_cast<double>(event_count) / wakeup_count : 0.0;
+    }
+
+    size_t                   iteration_count;        //reactor loops
+    size_t                   wait_nsec;              //time blocked - or busy polling - waiting for events
+    size_t                   busy_nsec;              //time spent outside of the wait
+    size_t                   wakeup_count;           //waits that returned events
+    size_t                   event_count;            //events returned by all the waits
+    size_t                   event_max;              //most events returned by a single wait
+    size_t                   exec_queue_max;         //exec queue high-water mark
+    size_t                   timer_count;            //pending timers
+    size_t                   timer_fired_count;      //expired timers
+    size_t                   inbox_count;            //new objects, raised events and moved objects taken from the inbox
+    size_t                   inbox_max;              //most entries taken from the inbox at once
+    size_t                   completion_count;       //io, timer and posted completion callbacks
+    size_t                   exec_deferred_count;    //posted completions left for a later loop by the exec budget
+    size_t                   exec_over_share_count;  //posted completions held back because their object used its share
+    size_t                   poll_mod_request_count; //device interest changes requested
+    size_t                   poll_mod_count;         //device interest changes that reached the kernel
+    size_t                   spin_hit_count;         //busy poll waits that found events while spinning
+    size_t                   spin_miss_count;        //busy poll waits that blocked after the spin window elapsed
+    CompletionTimeHistogramT completion_time_histogram;
+};
+
+using ReactorStatisticVectorT = std::vector<ReactorStatistic>;
+
+//! Opt-in placement of the reactor threads of a scheduler
+/*!
+    Reactor i is pinned to cpu_set_vec[i % cpu_set_vec.size()] and prefers
+    allocating memory on numa_node_vec[i % numa_node_vec.size()].
+    When cpu_set_vec is empty, a reactor with a NUMA node is pinned to all
+    the cpus of its node.
+    The thread is placed before the reactor is created, so the reactor data -
+    object stubs, exec queue, event vector, timer store - is allocated
+    on the node of the reactor.
+    Only available on Linux - the scheduler fails to start elsewhere.
+*/
+struct AffinityConfiguration {
+    AffinityConfiguration() {}
+
+    AffinityConfiguration(
+        std::vector<CpuSetT> const& _cpu_set_vec,
+        std::vector<size_t> const&  _numa_node_vec = std::vector<size_t>())
+        : cpu_set_vec(_cpu_set_vec)
+        , numa_node_vec(_numa_node_vec)
+    {
+    }
+
+    //! One cpu per reactor, starting from _first_cpu
+    static AffinityConfiguration cpuPerReactor(const size_t _reactor_count, const size_t _first_cpu = 0)
+    {
+        AffinityConfiguration cfg;
+        for (size_t i = 0; i < _reactor_count; ++i) {
+            cfg.cpu_set_vec.push_back(CpuSetT{_first_cpu + i});
+        }
+        return cfg;
+    }
+
+    //! All the reactors on the cpus of a NUMA node
+    static AffinityConfiguration numaNode(const size_t _node)
+    {
+        AffinityConfiguration cfg;
+        cfg.numa_node_vec.push_back(_node);
+        return cfg;
+    }
+
+    bool enabled() const
+    {
+        return !cpu_set_vec.empty() || !numa_node_vec.empty();
+    }
+
+    std::vector<CpuSetT> cpu_set_vec;
+    std::vector<size_t>  numa_node_vec;
+};
+
+//! Opt-in moving of objects from the busiest reactor of a scheduler to the least busy one
+/*!
+    Every period, the scheduler computes the part of the period each reactor
+    spent outside of waiting for events.
+    When the busiest reactor was busy for at least busy_max_percent of the
+    period and for at least busy_diff_percent more than the least busy one,
+    it is asked to move its move_count most active objects - counted in
+    completions since the previous move - to the least busy reactor.
+    Only frame::aio::Reactor on Linux (epoll or io_uring) moves objects.
+*/
+struct RebalanceConfiguration {
+    RebalanceConfiguration(
+        const std::chrono::milliseconds _period            = std::chrono::milliseconds(0),
+        const size_t                    _busy_max_percent  = 75,
+        const size_t                    _busy_diff_percent = 25,
+        const size_t                    _move_count        = 1)
+        : period(_period)
+        , busy_max_percent(_busy_max_percent)
+        , busy_diff_percent(_busy_diff_percent)
+        , move_count(_move_count)
+    {
+    }
+
+    bool enabled() const
+    {
+        return period.count() != 0;
+    }
+
+    std::chrono::milliseconds period; //zero disables rebalancing
+    size_t                    busy_max_percent;
+    size_t                    busy_diff_percent;
+    size_t                    move_count;
+};
+
 //typedef FunctorReference<bool, ReactorBase&>  ScheduleFunctorT;
 typedef SOLID_FUNCTION(bool(ReactorBase&)) ScheduleFunctionT;
+//! Schedules, on the given reactor, the objects at the given positions of a batch
+typedef SOLID_FUNCTION(bool(ReactorBase&, const size_t*, const size_t)) ScheduleBatchFunctionT;
 
 //! A base class for all schedulers
 class SchedulerBase {
@@ -44,7 +266,28 @@ protected:
 
     void doStop(const bool _wait = true);
 
+    void doBusyPoll(BusyPollConfiguration const& _rcfg);
+    void doExecBudget(ExecBudgetConfiguration const& _rcfg);
+
+    void doTimeCompletions(const bool _enable);
+    void doStatistics(ReactorStatisticVectorT& _rstat_vec) const;
+
+    void doAffinity(AffinityConfiguration const& _rcfg);
+
+    void doRebalance(RebalanceConfiguration const& _rcfg);
+
+    bool doMigrateObject(Manager& _rm, ObjectIdT const& _robjuid, const size_t _reactor_index);
+
+    //! Called on the reactor thread, before creating the reactor
+    static bool placeThread(SchedulerBase& _rsched, const size_t _idx);
+
     ObjectIdT doStartObject(ObjectBase& _robj, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+    ObjectIdT doStartObject(ObjectBase& _robj, Service& _rsvc, const size_t _reactor_index, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+
+    size_t doStartObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t _count, Service& _rsvc, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr);
+    size_t doStartObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t _count, Service& _rsvc, const size_t _reactor_index, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr);
+
+    size_t doReactorCount() const;
 
 protected:
     SchedulerBase();
@@ -57,6 +300,16 @@ private:
     void   unprepareThread(const size_t _idx, ReactorBase& _rsel);
     size_t doComputeScheduleReactorIndex();
 
+    ReactorBase* acquireReactor(const size_t _idx);
+    bool         raiseOnReactor(const size_t _idx, UniqueId const& _robjuid, Event&& _uevt);
+
+    void runRebalance();
+    void doRebalanceStep(std::vector<size_t>& _rbusy_vec, std::chrono::nanoseconds const& _relapsed);
+
+    BusyPollConfiguration const&   busyPollConfiguration() const;
+    ExecBudgetConfiguration const& execBudgetConfiguration() const;
+    bool                           timeCompletions() const;
+
 private:
     struct Data;
     PimplT<Data> impl_;
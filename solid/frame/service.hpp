@@ -108,6 +108,7 @@ private:
     }
 
     ObjectIdT registerObject(ObjectBase& _robj, ReactorBase& _rr, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr);
+    size_t    registerObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t* _ppos, const size_t _count, ReactorBase& _rr, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr);
 
 private:
     Manager&            rm;
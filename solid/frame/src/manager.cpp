@@ -7,6 +7,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
 //
+#include <algorithm>
 #include <deque>
 #include <vector>
 
@@ -270,6 +271,9 @@ struct Manager::Data {
         Manager& _rm);
     ~Data();
 
+    //NOTE: _rss.rmtx must be locked
+    size_t allocateObjectIndex(ServiceStub& _rss);
+
     ObjectChunk* allocateChunk(std::mutex& _rmtx) const
     {
         char*        p   = new char[sizeof(ObjectChunk) + objchkcnt * sizeof(ObjectStub)];
@@ -547,90 +551,99 @@ void Manager::doUnregisterService(ServiceStub& _rss)
     }
 }
 
-ObjectIdT Manager::registerObject(
-    const Service&     _rsvc,
-    ObjectBase&        _robj,
-    ReactorBase&       _rr,
-    ScheduleFunctionT& _rfct,
-    ErrorConditionT&   _rerr)
+size_t Manager::Data::allocateObjectIndex(ServiceStub& _rss)
 {
-    ObjectIdT retval;
-
-    const size_t svcidx = _rsvc.idx;
-
-    if (svcidx == InvalidIndex()) {
-        _rerr = error_service_unknown;
-        return retval;
-    }
-
-    size_t                      objidx      = InvalidIndex();
-    const size_t                svcstoreidx = impl_->aquireReadServiceStore(); //can lock impl_->mtx
-    ServiceStub&                rss         = *impl_->svcstore[svcstoreidx].vec[svcidx];
-    std::lock_guard<std::mutex> lock(rss.rmtx);
-
-    impl_->releaseReadServiceStore(svcstoreidx);
-
-    if (rss.psvc != &_rsvc || rss.state != StateRunningE) {
-        _rerr = error_service_not_running;
-        return retval;
-    }
+    size_t objidx = InvalidIndex();
 
-    if (rss.objcache.size()) {
+    if (_rss.objcache.size()) {
 
-        objidx = rss.objcache.top();
-        rss.objcache.pop();
+        objidx = _rss.objcache.top();
+        _rss.objcache.pop();
 
-    } else if (rss.crtobjidx < rss.endobjidx) {
+    } else if (_rss.crtobjidx < _rss.endobjidx) {
 
-        objidx = rss.crtobjidx;
-        ++rss.crtobjidx;
+        objidx = _rss.crtobjidx;
+        ++_rss.crtobjidx;
 
     } else {
 
-        std::lock_guard<std::mutex> lock2(impl_->mtx);
+        std::lock_guard<std::mutex> lock2(mtx);
         size_t                      chkidx = InvalidIndex();
-        if (impl_->chkcache.size()) {
-            chkidx = impl_->chkcache.top();
-            impl_->chkcache.pop();
+        if (chkcache.size()) {
+            chkidx = chkcache.top();
+            chkcache.pop();
         } else {
-            const size_t newobjstoreidx = impl_->aquireWriteObjectStore();
+            const size_t newobjstoreidx = aquireWriteObjectStore();
             const size_t oldobjstoreidx = (newobjstoreidx + 1) % 2;
 
-            ObjectStoreStub& rnewobjstore = impl_->objstore[newobjstoreidx];
+            ObjectStoreStub& rnewobjstore = objstore[newobjstoreidx];
 
             rnewobjstore.vec.insert(
                 rnewobjstore.vec.end(),
-                impl_->objstore[oldobjstoreidx].vec.begin() + rnewobjstore.vec.size(),
-                impl_->objstore[oldobjstoreidx].vec.end());
+                objstore[oldobjstoreidx].vec.begin() + rnewobjstore.vec.size(),
+                objstore[oldobjstoreidx].vec.end());
             chkidx = rnewobjstore.vec.size();
-            rnewobjstore.vec.push_back(impl_->allocateChunk(impl_->pobjmtxarr[chkidx % impl_->objmtxcnt]));
+            rnewobjstore.vec.push_back(allocateChunk(pobjmtxarr[chkidx % objmtxcnt]));
 
-            impl_->releaseWriteObjectStore(newobjstoreidx);
+            releaseWriteObjectStore(newobjstoreidx);
         }
 
-        objidx        = chkidx * impl_->objchkcnt;
-        rss.crtobjidx = objidx + 1;
-        rss.endobjidx = objidx + impl_->objchkcnt;
+        objidx         = chkidx * objchkcnt;
+        _rss.crtobjidx = objidx + 1;
+        _rss.endobjidx = objidx + objchkcnt;
 
-        if (impl_->maxobjcnt < rss.endobjidx) {
-            impl_->maxobjcnt = rss.endobjidx;
+        if (maxobjcnt < _rss.endobjidx) {
+            maxobjcnt = _rss.endobjidx;
         }
 
-        if (rss.firstchk == InvalidIndex()) {
-            rss.firstchk = rss.lastchk = chkidx;
+        if (_rss.firstchk == InvalidIndex()) {
+            _rss.firstchk = _rss.lastchk = chkidx;
         } else {
 
             //make the link with the last chunk
-            const size_t objstoreidx = impl_->crtobjstoreidx; //impl_->mtx is locked so it is safe to fetch the value of
+            const size_t objstoreidx = crtobjstoreidx; //mtx is locked so it is safe to fetch the value of
 
-            ObjectChunk& laschk(*impl_->objstore[objstoreidx].vec[rss.lastchk]);
+            ObjectChunk& laschk(*objstore[objstoreidx].vec[_rss.lastchk]);
 
             std::lock_guard<std::mutex> lock3(laschk.rmtx);
 
             laschk.nextchk = chkidx;
         }
-        rss.lastchk = chkidx;
+        _rss.lastchk = chkidx;
+    }
+    return objidx;
+}
+
+ObjectIdT Manager::registerObject(
+    const Service&     _rsvc,
+    ObjectBase&        _robj,
+    ReactorBase&       _rr,
+    ScheduleFunctionT& _rfct,
+    ErrorConditionT&   _rerr)
+{
+    ObjectIdT retval;
+
+    const size_t svcidx = _rsvc.idx;
+
+    if (svcidx == InvalidIndex()) {
+        _rerr = error_service_unknown;
+        return retval;
     }
+
+    size_t                      objidx      = InvalidIndex();
+    const size_t                svcstoreidx = impl_->aquireReadServiceStore(); //can lock impl_->mtx
+    ServiceStub&                rss         = *impl_->svcstore[svcstoreidx].vec[svcidx];
+    std::lock_guard<std::mutex> lock(rss.rmtx);
+
+    impl_->releaseReadServiceStore(svcstoreidx);
+
+    if (rss.psvc != &_rsvc || rss.state != StateRunningE) {
+        _rerr = error_service_not_running;
+        return retval;
+    }
+
+    objidx = impl_->allocateObjectIndex(rss);
+
     {
         const size_t                objstoreidx = impl_->aquireReadObjectStore();
         ObjectChunk&                robjchk(*impl_->chunk(objstoreidx, objidx));
@@ -671,6 +684,104 @@ ObjectIdT Manager::registerObject(
     return retval;
 }
 
+size_t Manager::registerObjects(
+    const Service&          _rsvc,
+    ObjectBase* const*      _pobjs,
+    ObjectIdT*              _pobjuids,
+    const size_t*           _ppos,
+    const size_t            _count,
+    ReactorBase&            _rr,
+    ScheduleBatchFunctionT& _rfct,
+    ErrorConditionT&        _rerr)
+{
+    const size_t svcidx = _rsvc.idx;
+
+    if (svcidx == InvalidIndex()) {
+        _rerr = error_service_unknown;
+        return 0;
+    }
+
+    if (_count == 0) {
+        return 0;
+    }
+
+    const size_t                svcstoreidx = impl_->aquireReadServiceStore(); //can lock impl_->mtx
+    ServiceStub&                rss         = *impl_->svcstore[svcstoreidx].vec[svcidx];
+    std::lock_guard<std::mutex> lock(rss.rmtx);
+
+    impl_->releaseReadServiceStore(svcstoreidx);
+
+    if (rss.psvc != &_rsvc || rss.state != StateRunningE) {
+        _rerr = error_service_not_running;
+        return 0;
+    }
+
+    std::vector<size_t>       objidxvec(_count);
+    std::vector<ObjectChunk*> chkvec(_count);
+    std::vector<std::mutex*>  mtxvec;
+
+    for (size_t i = 0; i < _count; ++i) {
+        objidxvec[i] = impl_->allocateObjectIndex(rss);
+    }
+    {
+        const size_t objstoreidx = impl_->aquireReadObjectStore();
+
+        for (size_t i = 0; i < _count; ++i) {
+            chkvec[i] = impl_->chunk(objstoreidx, objidxvec[i]);
+            mtxvec.push_back(&chkvec[i]->rmtx);
+        }
+
+        impl_->releaseReadObjectStore(objstoreidx);
+    }
+
+    //chunks can share a mutex - lock every mutex once, in address order
+    std::sort(mtxvec.begin(), mtxvec.end());
+    mtxvec.erase(std::unique(mtxvec.begin(), mtxvec.end()), mtxvec.end());
+
+    std::vector<std::unique_lock<std::mutex>> lockvec;
+    lockvec.reserve(mtxvec.size());
+
+    for (std::mutex* pmtx : mtxvec) {
+        lockvec.emplace_back(*pmtx);
+    }
+
+    for (size_t i = 0; i < _count; ++i) {
+        ObjectChunk& robjchk = *chkvec[i];
+
+        if (robjchk.svcidx == InvalidIndex()) {
+            robjchk.svcidx = _rsvc.idx;
+        }
+
+        SOLID_ASSERT(robjchk.svcidx == _rsvc.idx);
+
+        _pobjs[_ppos[i]]->id(objidxvec[i]);
+    }
+
+    if (_rfct(_rr, _ppos, _count)) {
+        //the objects are scheduled - see registerObject
+        for (size_t i = 0; i < _count; ++i) {
+            ObjectChunk& robjchk = *chkvec[i];
+            ObjectStub&  ros     = robjchk.object(objidxvec[i] % impl_->objchkcnt);
+
+            ros.pobject                = _pobjs[_ppos[i]];
+            ros.preactor               = &_rr;
+            _pobjuids[_ppos[i]].index  = objidxvec[i];
+            _pobjuids[_ppos[i]].unique = ros.unique;
+            ++robjchk.objcnt;
+        }
+        rss.objcnt += _count;
+        return _count;
+    }
+
+    //the objects were not scheduled
+    for (size_t i = 0; i < _count; ++i) {
+        _pobjs[_ppos[i]]->id(InvalidIndex());
+        rss.objcache.push(objidxvec[i]);
+    }
+    _rerr = error_object_schedule;
+    return 0;
+}
+
 void Manager::unregisterObject(ObjectBase& _robj)
 {
     size_t svcidx = InvalidIndex();
@@ -730,6 +841,37 @@ bool Manager::disableObjectVisits(ObjectBase& _robj)
     }
     return retval;
 }
+
+bool Manager::migrateObject(ObjectIdT const& _ruid, SchedulerBase& _rsch, const size_t _reactor_index)
+{
+    const auto do_migrate_fnc = [&_rsch, _reactor_index](VisitContext& _rctx) {
+        return &_rctx.rr_.scheduler() == &_rsch && _rctx.rr_.idInScheduler() != _reactor_index && _rctx.rr_.migrateObject(_rctx.ro_.runId(), _reactor_index);
+    };
+
+    return doVisit(_ruid, ObjectVisitFunctionT{do_migrate_fnc});
+}
+
+bool Manager::moveObject(ObjectBase& _robj, ReactorBase& _rfrom, ReactorBase& _rto, ScheduleFunctionT& _rfct)
+{
+    bool retval = false;
+    if (_robj.isRegistered()) {
+        const size_t                objstoreidx = impl_->aquireReadObjectStore();
+        ObjectChunk&                robjchk(*impl_->chunk(objstoreidx, static_cast<size_t>(_robj.id())));
+        std::lock_guard<std::mutex> lock(robjchk.rmtx);
+
+        impl_->releaseReadObjectStore(objstoreidx);
+
+        ObjectStub& ros = robjchk.object(_robj.id() % impl_->objchkcnt);
+
+        //the object might have started stopping
+        if (ros.pobject == &_robj && ros.preactor == &_rfrom && _rfct(_rto)) {
+            ros.preactor = &_rto;
+            retval       = true;
+        }
+    }
+    return retval;
+}
+
 #if 1
 bool Manager::notify(ObjectIdT const& _ruid, Event&& _uevt)
 {
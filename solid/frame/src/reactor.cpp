@@ -29,12 +29,13 @@
 
 #include "solid/frame/common.hpp"
 #include "solid/frame/completion.hpp"
+#include "solid/frame/manager.hpp"
 #include "solid/frame/object.hpp"
 #include "solid/frame/reactor.hpp"
 #include "solid/frame/reactorcontext.hpp"
 #include "solid/frame/service.hpp"
 #include "solid/frame/timer.hpp"
-#include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
 
 using namespace std;
 
@@ -202,7 +203,7 @@ typedef std::vector<UniqueId>             UidVectorT;
 typedef std::deque<ObjectStub>            ObjectDequeT;
 typedef Queue<ExecStub>                   ExecQueueT;
 typedef Stack<size_t>                     SizeStackT;
-typedef TimeStore<size_t>                 TimeStoreT;
+typedef TimeWheel<size_t>                 TimeStoreT;
 
 struct Reactor::Data {
     Data(
@@ -375,6 +376,29 @@ bool Reactor::push(TaskT& _robj, Service& _rsvc, Event const& _revent)
     return rv;
 }
 
+//Called from outside reactor's thread
+bool Reactor::push(TaskT* const* _ptasks, const size_t _count, Service& _rsvc, Event const& _revent)
+{
+    solid_dbg(logger, Verbose, (void*)this << " count = " << _count << " event = " << _revent);
+    bool rv = true;
+    if (_count != 0) {
+        lock_guard<mutex> lock(impl_->mtx);
+        NewTaskVectorT&   rpushvec  = impl_->pushtskvec[impl_->crtpushtskvecidx];
+        const bool        was_empty = rpushvec.empty();
+
+        for (size_t i = 0; i < _count; ++i) {
+            const UniqueId uid = this->popUid(**_ptasks[i]);
+            rpushvec.push_back(NewTaskStub(uid, *_ptasks[i], _rsvc, _revent));
+        }
+        impl_->crtpushvecsz = rpushvec.size();
+        if (was_empty) {
+            impl_->cnd.notify_one();
+        }
+    }
+
+    return rv;
+}
+
 void Reactor::run()
 {
     solid_dbg(logger, Verbose, "<enter>");
@@ -792,6 +816,97 @@ UniqueId ReactorBase::popUid(ObjectBase& _robj)
     return rv;
 }
 
+BusyPollConfiguration const& ReactorBase::busyPollConfiguration() const
+{
+    return rsch.busyPollConfiguration();
+}
+
+ExecBudgetConfiguration const& ReactorBase::execBudgetConfiguration() const
+{
+    return rsch.execBudgetConfiguration();
+}
+
+bool ReactorBase::timeCompletionsConfiguration() const
+{
+    return rsch.timeCompletions();
+}
+
+ReactorBase::StatisticCounters::StatisticCounters()
+    : iteration_count(0)
+    , wait_nsec(0)
+    , busy_nsec(0)
+    , wakeup_count(0)
+    , event_count(0)
+    , event_max(0)
+    , exec_queue_max(0)
+    , timer_count(0)
+    , timer_fired_count(0)
+    , inbox_count(0)
+    , inbox_max(0)
+    , completion_count(0)
+    , exec_deferred_count(0)
+    , exec_over_share_count(0)
+    , poll_mod_request_count(0)
+    , poll_mod_count(0)
+    , spin_hit_count(0)
+    , spin_miss_count(0)
+{
+    for (auto& rcnt : completion_time_histogram) {
+        rcnt.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ReactorBase::statistic(ReactorStatistic& _rstat) const
+{
+    _rstat.iteration_count        = statcnt.iteration_count.load(std::memory_order_relaxed);
+    _rstat.wait_nsec              = statcnt.wait_nsec.load(std::memory_order_relaxed);
+    _rstat.busy_nsec              = statcnt.busy_nsec.load(std::memory_order_relaxed);
+    _rstat.wakeup_count           = statcnt.wakeup_count.load(std::memory_order_relaxed);
+    _rstat.event_count            = statcnt.event_count.load(std::memory_order_relaxed);
+    _rstat.event_max              = statcnt.event_max.load(std::memory_order_relaxed);
+    _rstat.exec_queue_max         = statcnt.exec_queue_max.load(std::memory_order_relaxed);
+    _rstat.timer_count            = statcnt.timer_count.load(std::memory_order_relaxed);
+    _rstat.timer_fired_count      = statcnt.timer_fired_count.load(std::memory_order_relaxed);
+    _rstat.inbox_count            = statcnt.inbox_count.load(std::memory_order_relaxed);
+    _rstat.inbox_max              = statcnt.inbox_max.load(std::memory_order_relaxed);
+    _rstat.completion_count       = statcnt.completion_count.load(std::memory_order_relaxed);
+    _rstat.exec_deferred_count    = statcnt.exec_deferred_count.load(std::memory_order_relaxed);
+    _rstat.exec_over_share_count  = statcnt.exec_over_share_count.load(std::memory_order_relaxed);
+    _rstat.poll_mod_request_count = statcnt.poll_mod_request_count.load(std::memory_order_relaxed);
+    _rstat.poll_mod_count         = statcnt.poll_mod_count.load(std::memory_order_relaxed);
+    _rstat.spin_hit_count         = statcnt.spin_hit_count.load(std::memory_order_relaxed);
+    _rstat.spin_miss_count        = statcnt.spin_miss_count.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < _rstat.completion_time_histogram.size(); ++i) {
+        _rstat.completion_time_histogram[i] = statcnt.completion_time_histogram[i].load(std::memory_order_relaxed);
+    }
+}
+
+/*virtual*/ bool ReactorBase::migrateObject(UniqueId const& /*_robjuid*/, const size_t /*_reactor_index*/)
+{
+    return false;
+}
+
+/*virtual*/ bool ReactorBase::migrateBusiestObjects(const size_t /*_count*/, const size_t /*_reactor_index*/)
+{
+    return false;
+}
+
+ReactorBase* ReactorBase::acquireReactor(const size_t _reactor_index)
+{
+    return rsch.acquireReactor(_reactor_index);
+}
+
+bool ReactorBase::raiseOnReactor(const size_t _reactor_index, UniqueId const& _robjuid, Event&& _uevt)
+{
+    return rsch.raiseOnReactor(_reactor_index, _robjuid, std::move(_uevt));
+}
+
+bool ReactorBase::moveObject(ObjectBase& _robj, Manager& _rm, ReactorBase& _rtarget, ScheduleFunctionT& _rfct)
+{
+    return _rm.moveObject(_robj, *this, _rtarget, _rfct);
+}
+
 bool ReactorBase::prepareThread(const bool _success)
 {
     return scheduler().prepareThread(idInScheduler(), *this, _success);
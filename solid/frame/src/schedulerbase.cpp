@@ -15,6 +15,7 @@
 #include "solid/utility/algorithm.hpp"
 #include "solid/utility/queue.hpp"
 #include "solid/utility/stack.hpp"
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
@@ -36,7 +37,8 @@ public:
         AlreadyE = 1,
         WorkerE,
         RunningE,
-        ReactorE
+        ReactorE,
+        ReactorIndexE
     };
 
     ErrorCategory() {}
@@ -58,6 +60,8 @@ private:
             return "Scheduler not running";
         case ReactorE:
             return "Reactor failure";
+        case ReactorIndexE:
+            return "Invalid reactor index";
         default:
             return "Unknown";
         }
@@ -80,6 +84,11 @@ inline ErrorConditionT error_running()
     return ErrorConditionT(ErrorCategory::RunningE, ec);
 }
 
+inline ErrorConditionT error_reactor_index()
+{
+    return ErrorConditionT(ErrorCategory::ReactorIndexE, ec);
+}
+
 // inline ErrorConditionT error_reactor(){
 //  return ErrorConditionT(ErrorCategory::ReactorE, ec);
 // }
@@ -138,19 +147,27 @@ struct SchedulerBase::Data {
         , stopwaitcnt(0)
         , status(StatusStoppedE)
         , usecnt(0)
+        , timecompletions(false)
     {
     }
 
-    size_t               crtreactoridx;
-    size_t               reactorcnt;
-    size_t               stopwaitcnt;
-    AtomicStatuesT       status;
-    AtomicSizeT          usecnt;
-    ThreadEnterFunctionT threnfnc;
-    ThreadExitFunctionT  threxfnc;
-    ReactorVectorT       reactorvec;
-    mutex                mtx;
-    condition_variable   cnd;
+    size_t                  crtreactoridx;
+    size_t                  reactorcnt;
+    size_t                  stopwaitcnt;
+    AtomicStatuesT          status;
+    AtomicSizeT             usecnt;
+    ThreadEnterFunctionT    threnfnc;
+    ThreadExitFunctionT     threxfnc;
+    ReactorVectorT          reactorvec;
+    mutable mutex           mtx;
+    condition_variable      cnd;
+    BusyPollConfiguration   busypollcfg;
+    ExecBudgetConfiguration execbudgetcfg;
+    AffinityConfiguration   affinitycfg;
+    RebalanceConfiguration  rebalancecfg;
+    thread                  rebalancethr;
+    condition_variable      rebalancecnd;
+    bool                    timecompletions;
 };
 
 SchedulerBase::SchedulerBase()
@@ -239,6 +256,14 @@ ErrorConditionT SchedulerBase::doStart(
             }
         } else {
             impl_->status = StatusRunningE;
+
+            if (impl_->rebalancecfg.enabled() && impl_->reactorvec.size() > 1) {
+                try {
+                    impl_->rebalancethr = std::thread(&SchedulerBase::runRebalance, this);
+                } catch (...) {
+                    //the scheduler works without rebalancing
+                }
+            }
             return ErrorConditionT();
         }
     }
@@ -269,6 +294,7 @@ void SchedulerBase::doStop(bool _wait /* = true*/)
 
         if (impl_->status == StatusRunningE) {
             impl_->status = _wait ? StatusStoppingWaitE : StatusStoppingE;
+            impl_->rebalancecnd.notify_one();
             for (auto it = impl_->reactorvec.begin(); it != impl_->reactorvec.end(); ++it) {
                 if (it->preactor) {
                     it->preactor->stop();
@@ -295,6 +321,9 @@ void SchedulerBase::doStop(bool _wait /* = true*/)
         while (impl_->usecnt) {
             this_thread::yield();
         }
+        if (impl_->rebalancethr.joinable()) {
+            impl_->rebalancethr.join();
+        }
         for (auto it = impl_->reactorvec.begin(); it != impl_->reactorvec.end(); ++it) {
             if (it->isActive()) {
                 it->thr.join();
@@ -307,6 +336,188 @@ void SchedulerBase::doStop(bool _wait /* = true*/)
     }
 }
 
+void SchedulerBase::doBusyPoll(BusyPollConfiguration const& _rcfg)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    SOLID_ASSERT(impl_->status == StatusStoppedE);
+    impl_->busypollcfg = _rcfg;
+}
+
+void SchedulerBase::doExecBudget(ExecBudgetConfiguration const& _rcfg)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    SOLID_ASSERT(impl_->status == StatusStoppedE);
+    impl_->execbudgetcfg = _rcfg;
+}
+
+void SchedulerBase::doTimeCompletions(const bool _enable)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    SOLID_ASSERT(impl_->status == StatusStoppedE);
+    impl_->timecompletions = _enable;
+}
+
+void SchedulerBase::doStatistics(ReactorStatisticVectorT& _rstat_vec) const
+{
+    lock_guard<mutex> lock(impl_->mtx);
+
+    _rstat_vec.clear();
+    for (auto it = impl_->reactorvec.begin(); it != impl_->reactorvec.end(); ++it) {
+        if (it->preactor) {
+            _rstat_vec.emplace_back();
+            it->preactor->statistic(_rstat_vec.back());
+        }
+    }
+}
+
+void SchedulerBase::doAffinity(AffinityConfiguration const& _rcfg)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    SOLID_ASSERT(impl_->status == StatusStoppedE);
+    impl_->affinitycfg = _rcfg;
+}
+
+void SchedulerBase::doRebalance(RebalanceConfiguration const& _rcfg)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    SOLID_ASSERT(impl_->status == StatusStoppedE);
+    impl_->rebalancecfg = _rcfg;
+}
+
+bool SchedulerBase::doMigrateObject(Manager& _rm, ObjectIdT const& _robjuid, const size_t _reactor_index)
+{
+    ++impl_->usecnt;
+    bool rv = false;
+    if (impl_->status == StatusRunningE && _reactor_index < impl_->reactorvec.size()) {
+        rv = _rm.migrateObject(_robjuid, *this, _reactor_index);
+    }
+    --impl_->usecnt;
+    return rv;
+}
+
+ReactorBase* SchedulerBase::acquireReactor(const size_t _idx)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+
+    //while the scheduler is running, none of its reactors was asked to stop
+    if (impl_->status == StatusRunningE && _idx < impl_->reactorvec.size() && impl_->reactorvec[_idx].preactor) {
+        ReactorBase* preactor = impl_->reactorvec[_idx].preactor;
+        ++preactor->incomingcnt;
+        return preactor;
+    }
+    return nullptr;
+}
+
+bool SchedulerBase::raiseOnReactor(const size_t _idx, UniqueId const& _robjuid, Event&& _uevt)
+{
+    lock_guard<mutex> lock(impl_->mtx);
+
+    //the reactor is not destroyed while it is in reactorvec
+    if (_idx < impl_->reactorvec.size() && impl_->reactorvec[_idx].preactor) {
+        return impl_->reactorvec[_idx].preactor->raise(_robjuid, std::move(_uevt));
+    }
+    return false;
+}
+
+void SchedulerBase::runRebalance()
+{
+    unique_lock<mutex> lock(impl_->mtx);
+    vector<size_t>     busy_vec(impl_->reactorvec.size(), 0);
+    auto               prev_tp = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < busy_vec.size(); ++i) {
+        busy_vec[i] = static_cast<size_t>(impl_->reactorvec[i].preactor->busyTime().count());
+    }
+
+    while (impl_->status == StatusRunningE) {
+        impl_->rebalancecnd.wait_for(lock, impl_->rebalancecfg.period);
+
+        if (impl_->status != StatusRunningE) {
+            break;
+        }
+
+        const auto crt_tp = std::chrono::steady_clock::now();
+
+        doRebalanceStep(busy_vec, crt_tp - prev_tp);
+        prev_tp = crt_tp;
+    }
+}
+
+void SchedulerBase::doRebalanceStep(std::vector<size_t>& _rbusy_vec, std::chrono::nanoseconds const& _relapsed)
+{
+    RebalanceConfiguration const& rcfg       = impl_->rebalancecfg;
+    const size_t                  elapsed    = static_cast<size_t>(_relapsed.count());
+    size_t                        maxidx     = 0;
+    size_t                        minidx     = 0;
+    size_t                        maxpercent = 0;
+    size_t                        minpercent = InvalidSize();
+
+    if (elapsed == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < _rbusy_vec.size(); ++i) {
+        const size_t busy    = static_cast<size_t>(impl_->reactorvec[i].preactor->busyTime().count());
+        const size_t percent = ((busy - _rbusy_vec[i]) * 100) / elapsed;
+
+        _rbusy_vec[i] = busy;
+
+        if (percent >= maxpercent) {
+            maxpercent = percent;
+            maxidx     = i;
+        }
+        if (percent < minpercent) {
+            minpercent = percent;
+            minidx     = i;
+        }
+    }
+
+    if (maxidx != minidx && maxpercent >= rcfg.busy_max_percent && (maxpercent - minpercent) >= rcfg.busy_diff_percent) {
+        impl_->reactorvec[maxidx].preactor->migrateBusiestObjects(rcfg.move_count, minidx);
+    }
+}
+
+/*static*/ bool SchedulerBase::placeThread(SchedulerBase& _rsched, const size_t _idx)
+{
+    //the configuration cannot change while the scheduler is starting
+    AffinityConfiguration const& rcfg = _rsched.impl_->affinitycfg;
+
+    if (!rcfg.numa_node_vec.empty()) {
+        const size_t node = rcfg.numa_node_vec[_idx % rcfg.numa_node_vec.size()];
+
+        if (thread_memory_node(node)) {
+            return false;
+        }
+
+        if (rcfg.cpu_set_vec.empty()) {
+            CpuSetT cpu_set;
+            if (numa_node_cpu_set(node, cpu_set) || thread_affinity(cpu_set)) {
+                return false;
+            }
+        }
+    }
+
+    if (!rcfg.cpu_set_vec.empty() && thread_affinity(rcfg.cpu_set_vec[_idx % rcfg.cpu_set_vec.size()])) {
+        return false;
+    }
+    return true;
+}
+
+BusyPollConfiguration const& SchedulerBase::busyPollConfiguration() const
+{
+    return impl_->busypollcfg;
+}
+
+ExecBudgetConfiguration const& SchedulerBase::execBudgetConfiguration() const
+{
+    return impl_->execbudgetcfg;
+}
+
+bool SchedulerBase::timeCompletions() const
+{
+    return impl_->timecompletions;
+}
+
 ObjectIdT SchedulerBase::doStartObject(ObjectBase& _robj, Service& _rsvc, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr)
 {
     ++impl_->usecnt;
@@ -322,6 +533,95 @@ ObjectIdT SchedulerBase::doStartObject(ObjectBase& _robj, Service& _rsvc, Schedu
     return rv;
 }
 
+ObjectIdT SchedulerBase::doStartObject(ObjectBase& _robj, Service& _rsvc, const size_t _reactor_index, ScheduleFunctionT& _rfct, ErrorConditionT& _rerr)
+{
+    ++impl_->usecnt;
+    ObjectIdT rv;
+    if (impl_->status != StatusRunningE) {
+        _rerr = error_running();
+    } else if (_reactor_index >= impl_->reactorvec.size()) {
+        _rerr = error_reactor_index();
+    } else {
+        ReactorStub& rrs = impl_->reactorvec[_reactor_index];
+
+        rv = _rsvc.registerObject(_robj, *rrs.preactor, _rfct, _rerr);
+    }
+    --impl_->usecnt;
+    return rv;
+}
+
+size_t SchedulerBase::doStartObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t _count, Service& _rsvc, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr)
+{
+    ++impl_->usecnt;
+    size_t rv = 0;
+    if (impl_->status == StatusRunningE) {
+        const size_t   reactorcnt = impl_->reactorvec.size();
+        vector<size_t> loadvec(reactorcnt);
+        vector<size_t> reactoridxvec(_count);
+        vector<size_t> posvec;
+
+        for (size_t i = 0; i < reactorcnt; ++i) {
+            loadvec[i] = impl_->reactorvec[i].preactor->load();
+        }
+
+        //the reactors load the objects later, so spread the batch on the loads known here
+        for (size_t i = 0; i < _count; ++i) {
+            const size_t reactoridx = std::min_element(loadvec.begin(), loadvec.end()) - loadvec.begin();
+
+            reactoridxvec[i] = reactoridx;
+            ++loadvec[reactoridx];
+        }
+
+        //one registration - one lock per chunk and one wakeup - per reactor
+        posvec.reserve(_count);
+        for (size_t i = 0; i < reactorcnt; ++i) {
+            const size_t firstpos = posvec.size();
+
+            for (size_t j = 0; j < _count; ++j) {
+                if (reactoridxvec[j] == i) {
+                    posvec.push_back(j);
+                }
+            }
+
+            if (posvec.size() != firstpos) {
+                rv += _rsvc.registerObjects(_pobjs, _pobjuids, posvec.data() + firstpos, posvec.size() - firstpos, *impl_->reactorvec[i].preactor, _rfct, _rerr);
+            }
+        }
+    } else {
+        _rerr = error_running();
+    }
+    --impl_->usecnt;
+    return rv;
+}
+
+size_t SchedulerBase::doStartObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t _count, Service& _rsvc, const size_t _reactor_index, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr)
+{
+    ++impl_->usecnt;
+    size_t rv = 0;
+    if (impl_->status != StatusRunningE) {
+        _rerr = error_running();
+    } else if (_reactor_index >= impl_->reactorvec.size()) {
+        _rerr = error_reactor_index();
+    } else {
+        ReactorStub&   rrs = impl_->reactorvec[_reactor_index];
+        vector<size_t> posvec(_count);
+
+        for (size_t i = 0; i < _count; ++i) {
+            posvec[i] = i;
+        }
+
+        rv = _rsvc.registerObjects(_pobjs, _pobjuids, posvec.data(), _count, *rrs.preactor, _rfct, _rerr);
+    }
+    --impl_->usecnt;
+    return rv;
+}
+
+size_t SchedulerBase::doReactorCount() const
+{
+    lock_guard<mutex> lock(impl_->mtx);
+    return impl_->status == StatusRunningE ? impl_->reactorvec.size() : 0;
+}
+
 bool less_cmp(ReactorStub const& _rrs1, ReactorStub const& _rrs2)
 {
     return _rrs1.preactor->load() < _rrs2.preactor->load();
@@ -80,6 +80,11 @@ ObjectIdT Service::registerObject(ObjectBase& _robj, ReactorBase& _rr, ScheduleF
     return rm.registerObject(*this, _robj, _rr, _rfct, _rerr);
 }
 
+size_t Service::registerObjects(ObjectBase* const* _pobjs, ObjectIdT* _pobjuids, const size_t* _ppos, const size_t _count, ReactorBase& _rr, ScheduleBatchFunctionT& _rfct, ErrorConditionT& _rerr)
+{
+    return rm.registerObjects(*this, _pobjs, _pobjuids, _ppos, _count, _rr, _rfct, _rerr);
+}
+
 // void Service::unsafeStop(Locker<Mutex> &_rlock, bool _wait){
 //  const size_t    svcidx = idx.load(/*std::memory_order_seq_cst*/);
 //  rm.doWaitStopService(svcidx, _rlock, true);
@@ -0,0 +1,234 @@
+#include "solid/frame/timestore.hpp"
+#include "solid/frame/timewheel.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+using namespace solid;
+using namespace std;
+
+namespace {
+enum struct StoreChoice {
+    Store,
+    Wheel
+};
+
+class TestBase {
+public:
+    virtual ~TestBase() {}
+    virtual void create(const size_t) = 0;
+    virtual bool run(const size_t, const size_t) = 0;
+};
+
+//Simulates a reactor with _timer_count connection timers: every step advances
+//the time, fires the expired timers (which are rearmed, like a keepalive timer)
+//and restarts some of the timers with the full timeout, like on connection activity.
+template <class S>
+class TimeStoreTest : public TestBase {
+    using StoreT        = S;
+    using NanoTimeVecT  = std::vector<NanoTime>;
+    using SizeTVectorT  = std::vector<size_t>;
+
+    struct TimerCallback {
+        TimeStoreTest& rt;
+
+        TimerCallback(TimeStoreTest& _rt)
+            : rt(_rt)
+        {
+        }
+
+        void operator()(const size_t _tidx, const size_t _v) const
+        {
+            rt.onTimer(_tidx, _v);
+        }
+    };
+
+    struct ChangeTimerIndexCallback {
+        TimeStoreTest& rt;
+
+        ChangeTimerIndexCallback(TimeStoreTest& _rt)
+            : rt(_rt)
+        {
+        }
+
+        void operator()(const size_t _v, const size_t _newidx, const size_t _oldidx) const
+        {
+            if (rt.index_vec[_v] != _oldidx) {
+                rt.failed = true;
+            }
+            rt.index_vec[_v] = _newidx;
+        }
+    };
+
+    StoreT       store;
+    NanoTimeVecT time_vec;
+    SizeTVectorT index_vec;
+    NanoTime     prev_time;
+    NanoTime     crt_time;
+    uint64_t     seed;
+    size_t       fire_count;
+    bool         failed;
+
+public:
+    TimeStoreTest()
+        : store(1024)
+        , crt_time(std::chrono::seconds(1000))
+        , seed(0x9e3779b97f4a7c15ULL)
+        , fire_count(0)
+        , failed(false)
+    {
+    }
+
+    void create(const size_t _timer_count) override
+    {
+        //like the reactor, the store has seen the current time before the timers are added
+        store.pop(crt_time, TimerCallback(*this), ChangeTimerIndexCallback(*this));
+
+        time_vec.resize(_timer_count);
+        index_vec.resize(_timer_count);
+        for (size_t i = 0; i < _timer_count; ++i) {
+            time_vec[i]  = randomTime();
+            index_vec[i] = store.push(time_vec[i], i);
+        }
+    }
+
+    bool run(const size_t _step_count, const size_t _change_count) override
+    {
+        const auto                     step = std::chrono::milliseconds(span_msec) / _step_count;
+        const TimerCallback            tcbk(*this);
+        const ChangeTimerIndexCallback ccbk(*this);
+
+        for (size_t i = 0; i < _step_count; ++i) {
+            prev_time = crt_time;
+            crt_time  = crt_time.durationCast<std::chrono::nanoseconds>() + step;
+
+            store.pop(crt_time, tcbk, ccbk);
+
+            for (size_t j = 0; j < _change_count; ++j) {
+                const size_t v = static_cast<size_t>(random() % time_vec.size());
+                time_vec[v]    = restartTime();
+                if (store.change(index_vec[v], time_vec[v]) != v) {
+                    failed = true;
+                }
+            }
+        }
+
+        NanoTime mint = NanoTime::maximum;
+        for (const auto& t : time_vec) {
+            if (t <= crt_time) { //missed timer
+                failed = true;
+            }
+            if (t < mint) {
+                mint = t;
+            }
+        }
+        if (store.size() != time_vec.size() || mint < store.next()) {
+            failed = true;
+        }
+
+        cout << "fire_count = " << fire_count << endl;
+        return !failed;
+    }
+
+private:
+    enum {
+        span_msec = 10 * 1000,
+    };
+
+    uint64_t random()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    }
+
+    NanoTime randomTime()
+    {
+        const auto delta = std::chrono::milliseconds(1) + std::chrono::microseconds(random() % (span_msec * 1000));
+        return crt_time.durationCast<std::chrono::nanoseconds>() + delta;
+    }
+
+    NanoTime restartTime()
+    {
+        return crt_time.durationCast<std::chrono::nanoseconds>() + std::chrono::milliseconds(span_msec);
+    }
+
+    void onTimer(const size_t /*_tidx*/, const size_t _v)
+    {
+        NanoTime const& rt = time_vec[_v];
+        if (crt_time < rt || rt <= prev_time) { //fired too early or too late
+            failed = true;
+        }
+        ++fire_count;
+        time_vec[_v]  = randomTime();
+        index_vec[_v] = store.push(time_vec[_v], _v);
+    }
+};
+
+TestBase* create_test(const StoreChoice _store_choice)
+{
+    switch (_store_choice) {
+    case StoreChoice::Store:
+        return new TimeStoreTest<frame::TimeStore<size_t>>();
+    case StoreChoice::Wheel:
+        return new TimeStoreTest<frame::TimeWheel<size_t>>();
+    }
+    return nullptr;
+}
+
+} //namespace
+
+int test_timestore_perf(int argc, char* argv[])
+{
+    StoreChoice store_choice = StoreChoice::Wheel;
+
+    if (argc > 1) {
+        switch (argv[1][0]) {
+        case 's':
+            store_choice = StoreChoice::Store;
+            break;
+        case 'w':
+            store_choice = StoreChoice::Wheel;
+            break;
+        default:
+            cout << "Unknown store choice!" << endl;
+            return -1;
+        }
+    }
+
+    size_t timer_count = 1000;
+    if (argc > 2) {
+        timer_count = atoi(argv[2]);
+    }
+
+    size_t step_count = 1000;
+    if (argc > 3) {
+        step_count = atoi(argv[3]);
+    }
+    if (step_count == 0) {
+        step_count = 1;
+    }
+
+    size_t change_count = timer_count / 100;
+    if (argc > 4) {
+        change_count = atoi(argv[4]);
+    }
+
+    cout << "Test " << (store_choice == StoreChoice::Store ? "TimeStore" : "TimeWheel") << " with timer_count = " << timer_count << " step_count = " << step_count << " change_count = " << change_count << endl;
+
+    TestBase* pt = create_test(store_choice);
+
+    const auto start_time = std::chrono::steady_clock::now();
+
+    pt->create(timer_count);
+
+    const bool ok = pt->run(step_count, change_count);
+
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+
+    cout << "Duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << "ms" << endl;
+
+    delete pt;
+
+    return ok ? 0 : -1;
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "solid/system/cassert.hpp"
 #include "solid/system/nanotime.hpp"
 #include <vector>
 
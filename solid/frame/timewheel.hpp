@@ -0,0 +1,359 @@
+// solid/frame/timewheel.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/cassert.hpp"
+#include "solid/system/nanotime.hpp"
+#include "solid/utility/common.hpp"
+#include <vector>
+
+namespace solid {
+namespace frame {
+
+//! A hierarchical timing wheel with the same interface as TimeStore
+/*!
+    Timers are kept in a vector of nodes (the returned index is the position
+    in that vector and never changes while the timer is in the store) and are
+    linked into one of SlotCount slots on one of LevelCount levels.
+    A level k slot spans SlotCount^k ticks. When the wheel reaches an upper
+    level slot, its timers are cascaded down to the lower levels.
+
+    push, change and pop(index) are O(1); pop(time) only visits the
+    slots reached since the previous call. A postponed timer is not moved
+    on change but when the wheel reaches its old slot.
+    Because indexes are stable, the index-change callbacks of the pop methods
+    are never called - they are kept for interface compatibility with TimeStore.
+
+    next() is exact when the earliest timers are on the first level and
+    the start time of the earliest upper level slot otherwise - i.e. it
+    never returns a time after the earliest timer, but the reactor may wake
+    up once per level to cascade a far away timer.
+*/
+template <typename V>
+class TimeWheel {
+public:
+    typedef V ValueT;
+
+    TimeWheel(const size_t _cp = 0, const uint64_t _tick_nsec = 1000 * 1000)
+        : free_head_(InvalidIndex())
+        , size_(0)
+        , tick_nsec_(_tick_nsec)
+        , crt_tick_(0)
+        , min_time_(NanoTime::maximum)
+        , min_dirty_(false)
+    {
+        SOLID_ASSERT(tick_nsec_ != 0);
+        nodes_.reserve(_cp);
+        for (size_t i = 0; i < LevelCount; ++i) {
+            level_mask_[i] = 0;
+        }
+        for (size_t i = 0; i < (LevelCount * SlotCount); ++i) {
+            slot_head_[i] = InvalidIndex();
+        }
+    }
+    ~TimeWheel() {}
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    //! The expiry time of the timer at _idx
+    NanoTime const& time(const size_t _idx) const
+    {
+        SOLID_ASSERT(nodes_[_idx].slot != InvalidIndex());
+        return nodes_[_idx].time;
+    }
+
+    size_t push(NanoTime const& _rt, ValueT const& _rv)
+    {
+        SOLID_ASSERT(_rv != InvalidIndex());
+        size_t idx;
+        if (free_head_ != InvalidIndex()) {
+            idx        = free_head_;
+            free_head_ = nodes_[idx].next;
+        } else {
+            idx = nodes_.size();
+            nodes_.push_back(Node());
+        }
+        Node& rn = nodes_[idx];
+        rn.time  = _rt;
+        rn.tick  = timeToTick(_rt);
+        rn.value = _rv;
+        doLink(idx);
+        ++size_;
+        if (!min_dirty_ && _rt < min_time_) {
+            min_time_ = _rt;
+        }
+        return idx;
+    }
+
+    template <typename F>
+    void pop(const size_t _idx, F const& /*_rf*/)
+    {
+        Node& rn = nodes_[_idx];
+        SOLID_ASSERT(rn.slot != InvalidIndex());
+        if (rn.time <= min_time_) {
+            min_dirty_ = true;
+        }
+        doUnlink(_idx);
+        doRelease(_idx);
+    }
+
+    ValueT change(const size_t _idx, NanoTime const& _rt)
+    {
+        Node& rn = nodes_[_idx];
+        SOLID_ASSERT(rn.slot != InvalidIndex());
+        if (rn.time <= min_time_) {
+            min_dirty_ = true;
+        }
+        const uint64_t tick = timeToTick(_rt);
+        rn.time             = _rt;
+        if (tick >= rn.tick) {
+            //postponed timers (e.g. a restarted keepalive) stay in their slot
+            //and are moved when the wheel reaches it
+            rn.tick = tick;
+        } else {
+            rn.tick = tick;
+            if (slotIndex(tick) != rn.slot) {
+                doUnlink(_idx);
+                doLink(_idx);
+            }
+        }
+        if (!min_dirty_ && _rt < min_time_) {
+            min_time_ = _rt;
+        }
+        return rn.value;
+    }
+
+    template <typename F1, typename F2>
+    void pop(NanoTime const& _rt, F1 const& _rf1, F2 const& /*_rf2*/)
+    {
+        const uint64_t target_tick = timeToTick(_rt);
+
+        while (size_ != 0) {
+            size_t         slot;
+            const uint64_t tick = doNextTick(slot);
+
+            if (tick > target_tick) {
+                break;
+            }
+
+            crt_tick_ = tick;
+
+            if (slot >= SlotCount) {
+                doCascade(slot);
+                continue;
+            }
+
+            //_rf1 may push, change or pop timers so restart from the slot head after every call
+            size_t idx = slot_head_[slot];
+            while (idx != InvalidIndex()) {
+                Node& rn = nodes_[idx];
+                if (rn.time <= _rt) {
+                    const ValueT v = rn.value;
+                    doUnlink(idx);
+                    doRelease(idx);
+                    _rf1(idx, v);
+                    idx = slot_head_[slot];
+                } else if (rn.tick > crt_tick_) {
+                    const size_t nextidx = rn.next;
+                    doUnlink(idx);
+                    doLink(idx);
+                    idx = nextidx;
+                } else {
+                    idx = rn.next;
+                }
+            }
+
+            if (slot_head_[slot] != InvalidIndex()) {
+                //the remaining timers expire later within the current tick
+                break;
+            }
+        }
+
+        if (crt_tick_ < target_tick) {
+            crt_tick_ = target_tick;
+        }
+        min_dirty_ = true;
+    }
+
+    NanoTime const& next() const
+    {
+        if (min_dirty_) {
+            min_time_  = doComputeNext();
+            min_dirty_ = false;
+        }
+        return min_time_;
+    }
+
+private:
+    enum : size_t {
+        SlotBits   = 6,
+        SlotCount  = 1 << SlotBits,
+        SlotMask   = SlotCount - 1,
+        LevelCount = (64 + SlotBits - 1) / SlotBits,
+    };
+
+    struct Node {
+        Node()
+            : tick(0)
+            , value(InvalidIndex())
+            , prev(InvalidIndex())
+            , next(InvalidIndex())
+            , slot(InvalidIndex())
+        {
+        }
+
+        NanoTime time;
+        uint64_t tick;
+        ValueT   value;
+        size_t   prev;
+        size_t   next;
+        size_t   slot;
+    };
+
+    typedef std::vector<Node> NodeVectorT;
+
+    uint64_t timeToTick(NanoTime const& _rt) const
+    {
+        if (_rt.isMax()) {
+            return (std::numeric_limits<uint64_t>::max)() / tick_nsec_;
+        }
+        return (static_cast<uint64_t>(_rt.seconds()) * 1000000000ULL + _rt.nanoSeconds()) / tick_nsec_;
+    }
+
+    NanoTime tickToTime(const uint64_t _tick) const
+    {
+        return NanoTime(std::chrono::nanoseconds(_tick * tick_nsec_));
+    }
+
+    //Only the bits above the level's slot are equal between the timer's tick
+    //and the current tick, so the timer is reached exactly when the wheel
+    //gets to its slot.
+    size_t slotIndex(const uint64_t _tick) const
+    {
+        const uint64_t tick  = _tick > crt_tick_ ? _tick : crt_tick_;
+        const uint64_t diff  = tick ^ crt_tick_;
+        const size_t   level = diff != 0 ? (63 - leading_zero_count(diff)) / SlotBits : 0;
+        return level * SlotCount + static_cast<size_t>((tick >> (level * SlotBits)) & SlotMask);
+    }
+
+    void doLink(const size_t _idx)
+    {
+        Node&        rn    = nodes_[_idx];
+        const size_t slot  = slotIndex(rn.tick);
+        const size_t level = slot / SlotCount;
+
+        rn.slot = slot;
+        rn.prev = InvalidIndex();
+        rn.next = slot_head_[slot];
+        if (rn.next != InvalidIndex()) {
+            nodes_[rn.next].prev = _idx;
+        }
+        slot_head_[slot] = _idx;
+        level_mask_[level] |= (static_cast<uint64_t>(1) << (slot & SlotMask));
+    }
+
+    void doUnlink(const size_t _idx)
+    {
+        Node& rn = nodes_[_idx];
+        if (rn.prev != InvalidIndex()) {
+            nodes_[rn.prev].next = rn.next;
+        } else {
+            slot_head_[rn.slot] = rn.next;
+            if (rn.next == InvalidIndex()) {
+                level_mask_[rn.slot / SlotCount] &= ~(static_cast<uint64_t>(1) << (rn.slot & SlotMask));
+            }
+        }
+        if (rn.next != InvalidIndex()) {
+            nodes_[rn.next].prev = rn.prev;
+        }
+        rn.slot = InvalidIndex();
+    }
+
+    void doRelease(const size_t _idx)
+    {
+        nodes_[_idx].next = free_head_;
+        free_head_        = _idx;
+        --size_;
+    }
+
+    void doCascade(const size_t _slot)
+    {
+        size_t idx = slot_head_[_slot];
+
+        slot_head_[_slot] = InvalidIndex();
+        level_mask_[_slot / SlotCount] &= ~(static_cast<uint64_t>(1) << (_slot & SlotMask));
+
+        while (idx != InvalidIndex()) {
+            const size_t nextidx = nodes_[idx].next;
+            doLink(idx);
+            idx = nextidx;
+        }
+    }
+
+    //The start tick of the first non empty slot.
+    //Lower level slots always start before upper level ones.
+    uint64_t doNextTick(size_t& _rslot) const
+    {
+        for (size_t level = 0; level < LevelCount; ++level) {
+            const uint64_t mask = level_mask_[level];
+            if (mask != 0) {
+                const size_t   slotidx = bit_count((mask & (~mask + 1)) - 1);
+                const size_t   shift   = level * SlotBits;
+                const uint64_t base    = (shift + SlotBits) < 64 ? ((crt_tick_ >> (shift + SlotBits)) << (shift + SlotBits)) : 0;
+
+                _rslot = level * SlotCount + slotidx;
+                return base | (static_cast<uint64_t>(slotidx) << shift);
+            }
+        }
+        _rslot = InvalidIndex();
+        return (std::numeric_limits<uint64_t>::max)();
+    }
+
+    NanoTime doComputeNext() const
+    {
+        if (size_ == 0) {
+            return NanoTime::maximum;
+        }
+
+        size_t         slot;
+        const uint64_t tick = doNextTick(slot);
+
+        if (slot < SlotCount) {
+            NanoTime mint = NanoTime::maximum;
+            for (size_t idx = slot_head_[slot]; idx != InvalidIndex(); idx = nodes_[idx].next) {
+                if (nodes_[idx].time < mint) {
+                    mint = nodes_[idx].time;
+                }
+            }
+            //the slot may only hold postponed timers
+            const NanoTime slot_end = tickToTime(tick + 1);
+            return slot_end < mint ? slot_end : mint;
+        }
+        return tickToTime(tick);
+    }
+
+private:
+    NodeVectorT      nodes_;
+    size_t           free_head_;
+    size_t           size_;
+    const uint64_t   tick_nsec_;
+    uint64_t         crt_tick_;
+    uint64_t         level_mask_[LevelCount];
+    size_t           slot_head_[LevelCount * SlotCount];
+    mutable NanoTime min_time_;
+    mutable bool     min_dirty_;
+};
+
+} //namespace frame
+} //namespace solid
@@ -0,0 +1,92 @@
+// solid/system/pipedevice.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/device.hpp"
+#include "solid/system/error.hpp"
+
+namespace solid {
+
+//! A non-blocking kernel pipe used to move data between sockets without copying it to user space
+/*!
+    SocketDevice::recv(PipeDevice&...) fills the pipe from a socket and
+    SocketDevice::send(PipeDevice&...) drains it into another socket, both with splice(2).
+    The pipe keeps the count of the bytes it holds.
+    Only available on Linux - create returns error_not_implemented elsewhere.
+*/
+class PipeDevice {
+public:
+    enum {
+        DefaultCapacity = 64 * 1024
+    };
+
+    PipeDevice();
+    PipeDevice(PipeDevice&& _rpd);
+    ~PipeDevice();
+
+    PipeDevice& operator=(PipeDevice&& _rpd);
+
+    //! Creates the pipe, trying to resize it to _capacity bytes
+    ErrorCodeT create(size_t _capacity = DefaultCapacity);
+
+    void close();
+
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(rd_dev);
+    }
+
+    //! The number of bytes the pipe can hold
+    size_t capacity() const
+    {
+        return cap;
+    }
+
+    //! The number of bytes currently in the pipe
+    size_t size() const
+    {
+        return sz;
+    }
+
+    bool empty() const
+    {
+        return sz == 0;
+    }
+
+    bool full() const
+    {
+        return sz == cap;
+    }
+
+    Device& readDevice()
+    {
+        return rd_dev;
+    }
+
+    Device& writeDevice()
+    {
+        return wr_dev;
+    }
+
+private:
+    friend class SocketDevice;
+
+    PipeDevice(const PipeDevice&);
+    PipeDevice& operator=(const PipeDevice&);
+
+private:
+    Device rd_dev;
+    Device wr_dev;
+    size_t cap;
+    size_t sz;
+};
+
+} //namespace solid
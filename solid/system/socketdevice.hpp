@@ -14,8 +14,50 @@
 #include "solid/system/error.hpp"
 #include "solid/system/socketaddress.hpp"
 
+#ifndef SOLID_ON_WINDOWS
+#include <sys/uio.h>
+#endif
+
 namespace solid {
 
+class FileDevice;
+class PipeDevice;
+
+#ifdef SOLID_ON_WINDOWS
+struct iovec {
+    void*  iov_base;
+    size_t iov_len;
+};
+#endif
+
+//! A buffer for scatter/gather I/O - struct iovec on POSIX
+using IoVecT = struct iovec;
+
+//! One datagram of a batched send or receive
+/*!
+    On receive, buf is filled with at most cap bytes, len is set to the received size
+    and addr to the sender address.
+    On send, len bytes from buf are sent to addr, or to the connected peer if addr is empty.
+    A non zero segment_size on send asks for the buffer to be split into datagrams of
+    segment_size bytes (UDP GSO). On receive it is set when the kernel coalesced
+    several datagrams of segment_size bytes into buf (UDP GRO - see enableReceiveOffload).
+*/
+struct DatagramSlot {
+    char*         buf;
+    size_t        cap;
+    size_t        len;
+    size_t        segment_size;
+    SocketAddress addr;
+
+    DatagramSlot(char* _buf = nullptr, size_t _cap = 0)
+        : buf(_buf)
+        , cap(_cap)
+        , len(0)
+        , segment_size(0)
+    {
+    }
+};
+
 //! A wrapper for berkeley sockets
 class SocketDevice : public Device {
 public:
@@ -25,10 +67,17 @@ public:
     typedef int DescriptorT;
 #endif
 
+    enum {
+        SendFileBufferCapacity = 16 * 1024,
+        DatagramBatchCapacity  = 64,
+    };
+
     //!Copy constructor
     SocketDevice(SocketDevice&& _sd);
     //!Basic constructor
     SocketDevice();
+    //!Takes the ownership of an open socket - e.g. accepted without accept(SocketDevice&)
+    explicit SocketDevice(DescriptorT _desc);
     //!Destructor
     ~SocketDevice();
     //!Assign operator
@@ -72,6 +121,20 @@ public:
     ErrorCodeT enableNoSignal();
     ErrorCodeT disableNoSignal();
 
+    //! SO_REUSEPORT - must be called before prepareAccept
+    /*!
+        On Linux the incoming connections are distributed among all the
+        listening sockets bound with SO_REUSEPORT to the same address.
+    */
+    ErrorCodeT enableReusePort();
+    ErrorCodeT disableReusePort();
+
+    //! SO_ZEROCOPY - allows sendZeroCopy to use MSG_ZEROCOPY, Linux only
+    ErrorCodeT enableZeroCopy();
+
+    //! UDP_GRO - allows recv(DatagramSlot*...) to return coalesced datagrams, Linux only
+    ErrorCodeT enableReceiveOffload();
+
     ErrorCodeT enableLinger();
     ErrorCodeT disableLinger();
 
@@ -92,10 +155,56 @@ public:
     ssize_t send(const char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
     //! Reads data from a socket
     ssize_t recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
+    //! Gather write - sends from _iovcnt buffers with a single system call
+    /*!
+        On Windows only the first non empty buffer is sent.
+    */
+    ssize_t send(const IoVecT* _piov, size_t _iovcnt, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
+    //! Scatter read - fills the _iovcnt buffers in order with a single system call
+    /*!
+        On Windows only the first non empty buffer is filled.
+    */
+    ssize_t recv(IoVecT* _piov, size_t _iovcnt, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags = 0);
+    //! Send _ul bytes from the given file offset - sendfile(2) on Linux
+    /*!
+        Elsewhere the data is read in a SendFileBufferCapacity stack buffer.
+        Returns 0 at the end of the file.
+    */
+    ssize_t sendFile(FileDevice& _rfd, int64_t _off, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Moves at most _ul bytes from the socket into the pipe - splice(2), Linux only
+    ssize_t recv(PipeDevice& _rpd, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Moves at most _ul bytes from the pipe into the socket - splice(2), Linux only
+    ssize_t send(PipeDevice& _rpd, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Send with MSG_ZEROCOPY - the buffer must not change until the kernel reports its release
+    /*!
+        _rzero_copy is set when a notification will follow on the error queue - see recvZeroCopyCompletion.
+        Every such send gets the next id, starting from 0.
+        Falls back to a copying send when the zero copy send is not possible.
+    */
+    ssize_t sendZeroCopy(const char* _pb, size_t _ul, bool& _rzero_copy, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Reads a MSG_ZEROCOPY notification from the error queue
+    /*!
+        Returns 1 when the pages of the sends with ids in [_rfirst, _rlast] were released,
+        0 for other error queue messages and -1 when the queue is empty or on error.
+    */
+    ssize_t recvZeroCopyCompletion(uint32_t& _rfirst, uint32_t& _rlast, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Send a datagram to a socket
     ssize_t send(const char* _pb, size_t _ul, const SocketAddressStub& _sap, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Recv data from a socket
     ssize_t recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Send a batch of datagrams - sendmmsg(2) on Linux
+    /*!
+        Returns the number of slots sent, at most DatagramBatchCapacity.
+        Elsewhere there is one system call per datagram and segment_size is honored
+        by splitting the buffer in user space.
+    */
+    ssize_t send(const DatagramSlot* _pslot, size_t _cnt, bool& _rcan_retry, ErrorCodeT& _rerr);
+    //! Receive a batch of datagrams - recvmmsg(2) on Linux
+    /*!
+        Returns the number of slots filled, at most DatagramBatchCapacity.
+        Elsewhere there is one system call per datagram.
+    */
+    ssize_t recv(DatagramSlot* _pslot, size_t _cnt, bool& _rcan_retry, ErrorCodeT& _rerr);
     //! Gets the remote address for a connected socket
     ErrorCodeT remoteAddress(SocketAddress& _rsa) const;
     //! Gets the local address for a socket
@@ -22,6 +22,21 @@
 #include <unistd.h>
 #endif
 
+#if defined(SOLID_ON_LINUX)
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define SOLID_USE_ZEROCOPY
+#endif
+#if defined(UDP_SEGMENT) && defined(UDP_GRO)
+#define SOLID_USE_DATAGRAM_BATCH
+#endif
+#endif
+
 #include <cassert>
 #include <cerrno>
 #include <cstdio>
@@ -31,6 +46,7 @@
 #include "solid/system/directory.hpp"
 #include "solid/system/exception.hpp"
 #include "solid/system/filedevice.hpp"
+#include "solid/system/pipedevice.hpp"
 #include "solid/system/socketdevice.hpp"
 #include "solid/system/socketinfo.hpp"
 
@@ -308,6 +324,70 @@ bool FileDevice::canRetryOpen() const
     return st.st_size;
 #endif
 }
+//-- PipeDevice ------------------------------------
+PipeDevice::PipeDevice()
+    : cap(0)
+    , sz(0)
+{
+}
+
+PipeDevice::PipeDevice(PipeDevice&& _rpd)
+    : rd_dev(std::move(_rpd.rd_dev))
+    , wr_dev(std::move(_rpd.wr_dev))
+    , cap(_rpd.cap)
+    , sz(_rpd.sz)
+{
+    _rpd.cap = _rpd.sz = 0;
+}
+
+PipeDevice::~PipeDevice()
+{
+}
+
+PipeDevice& PipeDevice::operator=(PipeDevice&& _rpd)
+{
+    rd_dev   = std::move(_rpd.rd_dev);
+    wr_dev   = std::move(_rpd.wr_dev);
+    cap      = _rpd.cap;
+    sz       = _rpd.sz;
+    _rpd.cap = _rpd.sz = 0;
+    return *this;
+}
+
+ErrorCodeT PipeDevice::create(size_t _capacity)
+{
+#if defined(SOLID_ON_LINUX)
+    int fds[2];
+
+    close();
+
+    if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        return last_system_error();
+    }
+
+    rd_dev = Device(fds[0]);
+    wr_dev = Device(fds[1]);
+
+    if (_capacity != 0) {
+        //the kernel rounds the size up - failing to resize is not an error
+        ::fcntl(fds[1], F_SETPIPE_SZ, static_cast<int>(_capacity));
+    }
+
+    const int rv = ::fcntl(fds[1], F_GETPIPE_SZ);
+
+    cap = rv > 0 ? rv : 4096;
+    return ErrorCodeT();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+void PipeDevice::close()
+{
+    rd_dev.close();
+    wr_dev.close();
+    cap = sz = 0;
+}
 //-- Directory -------------------------------------
 #ifdef SOLID_ON_WINDOWS
 int do_create_directory(WCHAR* _pwc, const char* _path, size_t _sz, size_t _wcp)
@@ -554,6 +634,15 @@ SocketDevice::SocketDevice()
 {
 }
 
+SocketDevice::SocketDevice(DescriptorT _desc)
+#ifdef SOLID_ON_WINDOWS
+    : Device((HANDLE)_desc)
+#else
+    : Device(_desc)
+#endif
+{
+}
+
 SocketDevice& SocketDevice::operator=(SocketDevice&& _dev)
 {
     *static_cast<Device*>(this) = static_cast<Device&&>(_dev);
@@ -895,6 +984,162 @@ ssize_t SocketDevice::recv(char* _pb, size_t _ul, bool& _rcan_retry, ErrorCodeT&
     return rv;
 #endif
 }
+#ifdef SOLID_ON_WINDOWS
+namespace {
+size_t first_not_empty(const IoVecT* _piov, const size_t _iovcnt)
+{
+    size_t i = 0;
+    while (i < (_iovcnt - 1) && _piov[i].iov_len == 0) {
+        ++i;
+    }
+    return i;
+}
+} //namespace
+#endif
+
+ssize_t SocketDevice::send(const IoVecT* _piov, size_t _iovcnt, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags)
+{
+    SOLID_ASSERT(_iovcnt != 0);
+#ifdef SOLID_ON_WINDOWS
+    const IoVecT& riov = _piov[first_not_empty(_piov, _iovcnt)];
+    return send(static_cast<const char*>(riov.iov_base), riov.iov_len, _rcan_retry, _rerr, _flags);
+#else
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = const_cast<IoVecT*>(_piov);
+    msg.msg_iovlen = _iovcnt;
+
+    ssize_t rv = ::sendmsg(descriptor(), &msg, 0);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    return rv;
+#endif
+}
+ssize_t SocketDevice::recv(IoVecT* _piov, size_t _iovcnt, bool& _rcan_retry, ErrorCodeT& _rerr, unsigned _flags)
+{
+    SOLID_ASSERT(_iovcnt != 0);
+#ifdef SOLID_ON_WINDOWS
+    IoVecT& riov = _piov[first_not_empty(_piov, _iovcnt)];
+    return recv(static_cast<char*>(riov.iov_base), riov.iov_len, _rcan_retry, _rerr, _flags);
+#else
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = _piov;
+    msg.msg_iovlen = _iovcnt;
+
+    ssize_t rv = ::recvmsg(descriptor(), &msg, 0);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    return rv;
+#endif
+}
+ssize_t SocketDevice::sendFile(FileDevice& _rfd, int64_t _off, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    off_t   off = _off;
+    ssize_t rv = ::sendfile(descriptor(), _rfd.descriptor(), &off, _ul);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    return rv;
+#else
+    //the read is repeated on retry, so nothing needs to be kept between calls
+    char          buf[SendFileBufferCapacity];
+    const ssize_t readsz = _rfd.read(buf, _ul < sizeof(buf) ? _ul : sizeof(buf), _off);
+
+    if (readsz <= 0) {
+        _rcan_retry = false;
+        _rerr       = readsz == 0 ? ErrorCodeT() : last_system_error();
+        return readsz;
+    }
+    return send(buf, readsz, _rcan_retry, _rerr);
+#endif
+}
+ssize_t SocketDevice::recv(PipeDevice& _rpd, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    ssize_t rv = ::splice(descriptor(), nullptr, _rpd.writeDevice().descriptor(), nullptr, _ul, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    if (rv > 0) {
+        _rpd.sz += rv;
+    }
+    return rv;
+#else
+    _rcan_retry = false;
+    _rerr       = solid::error_not_implemented;
+    return -1;
+#endif
+}
+ssize_t SocketDevice::send(PipeDevice& _rpd, size_t _ul, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_ON_LINUX)
+    ssize_t rv = ::splice(_rpd.readDevice().descriptor(), nullptr, descriptor(), nullptr, _ul, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    if (rv > 0) {
+        _rpd.sz -= rv;
+    }
+    return rv;
+#else
+    _rcan_retry = false;
+    _rerr       = solid::error_not_implemented;
+    return -1;
+#endif
+}
+ssize_t SocketDevice::sendZeroCopy(const char* _pb, size_t _ul, bool& _rzero_copy, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_USE_ZEROCOPY)
+    ssize_t rv = ::send(descriptor(), _pb, _ul, MSG_ZEROCOPY);
+    if (rv < 0 && errno == ENOBUFS) {
+        //the locked memory limit was reached - copy this time
+        _rzero_copy = false;
+        return send(_pb, _ul, _rcan_retry, _rerr);
+    }
+    _rzero_copy = rv > 0;
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    return rv;
+#else
+    _rzero_copy = false;
+    return send(_pb, _ul, _rcan_retry, _rerr);
+#endif
+}
+ssize_t SocketDevice::recvZeroCopyCompletion(uint32_t& _rfirst, uint32_t& _rlast, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+#if defined(SOLID_USE_ZEROCOPY)
+    char          control[128];
+    struct msghdr msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t rv = ::recvmsg(descriptor(), &msg, MSG_ERRQUEUE);
+    if (rv < 0) {
+        _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+        _rerr = last_socket_error();
+        return rv;
+    }
+
+    for (struct cmsghdr* pcm = CMSG_FIRSTHDR(&msg); pcm != nullptr; pcm = CMSG_NXTHDR(&msg, pcm)) {
+        if (
+            (pcm->cmsg_level == SOL_IP && pcm->cmsg_type == IP_RECVERR) || (pcm->cmsg_level == SOL_IPV6 && pcm->cmsg_type == IPV6_RECVERR)) {
+            const struct sock_extended_err* pserr = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(pcm));
+
+            if (pserr->ee_errno == 0 && pserr->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                _rfirst = pserr->ee_info;
+                _rlast  = pserr->ee_data;
+                return 1;
+            }
+        }
+    }
+    return 0;
+#else
+    _rcan_retry = false;
+    _rerr       = solid::error_not_implemented;
+    return -1;
+#endif
+}
 ssize_t SocketDevice::send(const char* _pb, size_t _ul, const SocketAddressStub& _sap, bool& _rcan_retry, ErrorCodeT& _rerr)
 {
 #ifdef SOLID_ON_WINDOWS
@@ -927,6 +1172,133 @@ ssize_t SocketDevice::recv(char* _pb, size_t _ul, SocketAddress& _rsa, bool& _rc
     return rv;
 #endif
 }
+ssize_t SocketDevice::send(const DatagramSlot* _pslot, size_t _cnt, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_cnt != 0);
+    if (_cnt > DatagramBatchCapacity) {
+        _cnt = DatagramBatchCapacity;
+    }
+#if defined(SOLID_USE_DATAGRAM_BATCH)
+    struct mmsghdr msgs[DatagramBatchCapacity];
+    IoVecT         iovs[DatagramBatchCapacity];
+    char           control[DatagramBatchCapacity][CMSG_SPACE(sizeof(uint16_t))];
+
+    memset(msgs, 0, sizeof(struct mmsghdr) * _cnt);
+
+    for (size_t i = 0; i < _cnt; ++i) {
+        const DatagramSlot& rslot = _pslot[i];
+        struct msghdr&      rmsg  = msgs[i].msg_hdr;
+
+        iovs[i].iov_base = rslot.buf;
+        iovs[i].iov_len  = rslot.len;
+        rmsg.msg_iov     = &iovs[i];
+        rmsg.msg_iovlen  = 1;
+
+        if (!rslot.addr.empty()) {
+            rmsg.msg_name    = const_cast<sockaddr*>(rslot.addr.sockAddr());
+            rmsg.msg_namelen = rslot.addr.size();
+        }
+
+        if (rslot.segment_size != 0) {
+            const uint16_t segment_size = static_cast<uint16_t>(rslot.segment_size);
+
+            rmsg.msg_control    = control[i];
+            rmsg.msg_controllen = sizeof(control[i]);
+
+            struct cmsghdr* pcm = CMSG_FIRSTHDR(&rmsg);
+            pcm->cmsg_level     = SOL_UDP;
+            pcm->cmsg_type      = UDP_SEGMENT;
+            pcm->cmsg_len       = CMSG_LEN(sizeof(segment_size));
+            memcpy(CMSG_DATA(pcm), &segment_size, sizeof(segment_size));
+        }
+    }
+
+    ssize_t rv = ::sendmmsg(descriptor(), msgs, _cnt, 0);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+    return rv;
+#else
+    //a slot interrupted between its segments is entirely sent again on retry
+    for (size_t i = 0; i < _cnt; ++i) {
+        const DatagramSlot& rslot        = _pslot[i];
+        const size_t        segment_size = rslot.segment_size != 0 ? rslot.segment_size : rslot.len;
+        size_t              off          = 0;
+
+        do {
+            const size_t  sz = (rslot.len - off) < segment_size ? (rslot.len - off) : segment_size;
+            const ssize_t rv = rslot.addr.empty() ? send(rslot.buf + off, sz, _rcan_retry, _rerr) : send(rslot.buf + off, sz, rslot.addr, _rcan_retry, _rerr);
+
+            if (rv < 0) {
+                return i == 0 ? rv : static_cast<ssize_t>(i);
+            }
+            off += sz;
+        } while (off < rslot.len);
+    }
+    return _cnt;
+#endif
+}
+ssize_t SocketDevice::recv(DatagramSlot* _pslot, size_t _cnt, bool& _rcan_retry, ErrorCodeT& _rerr)
+{
+    SOLID_ASSERT(_cnt != 0);
+    if (_cnt > DatagramBatchCapacity) {
+        _cnt = DatagramBatchCapacity;
+    }
+#if defined(SOLID_USE_DATAGRAM_BATCH)
+    struct mmsghdr msgs[DatagramBatchCapacity];
+    IoVecT         iovs[DatagramBatchCapacity];
+    char           control[DatagramBatchCapacity][CMSG_SPACE(sizeof(int))];
+
+    memset(msgs, 0, sizeof(struct mmsghdr) * _cnt);
+
+    for (size_t i = 0; i < _cnt; ++i) {
+        DatagramSlot&  rslot = _pslot[i];
+        struct msghdr& rmsg  = msgs[i].msg_hdr;
+
+        iovs[i].iov_base    = rslot.buf;
+        iovs[i].iov_len     = rslot.cap;
+        rmsg.msg_iov        = &iovs[i];
+        rmsg.msg_iovlen     = 1;
+        rmsg.msg_name       = rslot.addr.sockAddr();
+        rmsg.msg_namelen    = SocketAddress::Capacity;
+        rmsg.msg_control    = control[i];
+        rmsg.msg_controllen = sizeof(control[i]);
+    }
+
+    ssize_t rv = ::recvmmsg(descriptor(), msgs, _cnt, 0, nullptr);
+    _rcan_retry = (errno == EAGAIN || errno == EWOULDBLOCK);
+    _rerr = last_socket_error();
+
+    for (ssize_t i = 0; i < rv; ++i) {
+        DatagramSlot&  rslot = _pslot[i];
+        struct msghdr& rmsg  = msgs[i].msg_hdr;
+
+        rslot.len          = msgs[i].msg_len;
+        rslot.addr.sz      = rmsg.msg_namelen;
+        rslot.segment_size = 0;
+
+        for (struct cmsghdr* pcm = CMSG_FIRSTHDR(&rmsg); pcm != nullptr; pcm = CMSG_NXTHDR(&rmsg, pcm)) {
+            if (pcm->cmsg_level == SOL_UDP && pcm->cmsg_type == UDP_GRO) {
+                int segment_size;
+                memcpy(&segment_size, CMSG_DATA(pcm), sizeof(segment_size));
+                rslot.segment_size = segment_size;
+            }
+        }
+    }
+    return rv;
+#else
+    for (size_t i = 0; i < _cnt; ++i) {
+        DatagramSlot& rslot = _pslot[i];
+        const ssize_t rv    = recv(rslot.buf, rslot.cap, rslot.addr, _rcan_retry, _rerr);
+
+        if (rv < 0) {
+            return i == 0 ? rv : static_cast<ssize_t>(i);
+        }
+        rslot.len          = rv;
+        rslot.segment_size = 0;
+    }
+    return _cnt;
+#endif
+}
 
 ErrorCodeT SocketDevice::remoteAddress(SocketAddress& _rsa) const
 {
@@ -1054,6 +1426,62 @@ ErrorCodeT SocketDevice::disableNoSignal()
 #endif
 }
 
+ErrorCodeT SocketDevice::enableReusePort()
+{
+#if defined(SOLID_ON_WINDOWS) || !defined(SO_REUSEPORT)
+    return solid::error_not_implemented;
+#else
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_SOCKET, SO_REUSEPORT, (char*)&flag, sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#endif
+}
+
+ErrorCodeT SocketDevice::disableReusePort()
+{
+#if defined(SOLID_ON_WINDOWS) || !defined(SO_REUSEPORT)
+    return solid::error_not_implemented;
+#else
+    int flag = 0;
+    int rv   = setsockopt(descriptor(), SOL_SOCKET, SO_REUSEPORT, (char*)&flag, sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#endif
+}
+
+ErrorCodeT SocketDevice::enableZeroCopy()
+{
+#if defined(SOLID_USE_ZEROCOPY)
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_SOCKET, SO_ZEROCOPY, (char*)&flag, sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
+ErrorCodeT SocketDevice::enableReceiveOffload()
+{
+#if defined(SOLID_USE_DATAGRAM_BATCH)
+    int flag = 1;
+    int rv   = setsockopt(descriptor(), SOL_UDP, UDP_GRO, (char*)&flag, sizeof(flag));
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return last_socket_error();
+#else
+    return solid::error_not_implemented;
+#endif
+}
+
 ErrorCodeT SocketDevice::enableLinger()
 {
     return solid::error_not_implemented;
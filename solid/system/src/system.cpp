@@ -10,7 +10,11 @@
 
 #include "solid/system/exception.hpp"
 #include "solid/system/nanotime.hpp"
+#include "solid/system/thread.hpp"
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <string>
 
 #if defined(SOLID_ON_FREEBSD)
 #include <pmc.h>
@@ -36,6 +40,12 @@
 #include <mach/mach_time.h>
 #endif
 
+#if defined(SOLID_ON_LINUX)
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
 namespace solid {
 
 //=============================================================================
@@ -47,4 +57,90 @@ namespace solid {
 #include "solid/system/nanotime.ipp"
 #endif
 
+//=============================================================================
+//  Thread
+//=============================================================================
+
+ErrorCodeT thread_affinity(const CpuSetT& _rcpu_set)
+{
+#if defined(SOLID_ON_LINUX)
+    cpu_set_t cpu_set;
+
+    CPU_ZERO(&cpu_set);
+    for (const size_t cpu : _rcpu_set) {
+        if (cpu >= CPU_SETSIZE) {
+            return ErrorCodeT(EINVAL, std::system_category());
+        }
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    const int rv = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (rv == 0) {
+        return ErrorCodeT();
+    }
+    return ErrorCodeT(rv, std::system_category());
+#else
+    return error_not_implemented;
+#endif
+}
+
+ErrorCodeT thread_memory_node(const size_t _node)
+{
+#if defined(SOLID_ON_LINUX) && defined(SYS_set_mempolicy)
+    const size_t  bits_per_mask = sizeof(unsigned long) * 8;
+    unsigned long mask[16];
+
+    if (_node >= (bits_per_mask * 16)) {
+        return ErrorCodeT(EINVAL, std::system_category());
+    }
+
+    memset(mask, 0, sizeof(mask));
+    mask[_node / bits_per_mask] = 1UL << (_node % bits_per_mask);
+
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, bits_per_mask * 16) == 0) {
+        return ErrorCodeT();
+    }
+    return last_system_error();
+#else
+    return error_not_implemented;
+#endif
+}
+
+ErrorCodeT numa_node_cpu_set(const size_t _node, CpuSetT& _rcpu_set)
+{
+#if defined(SOLID_ON_LINUX)
+    //the cpulist is like "0-3,8-11"
+    std::ifstream ifs("/sys/devices/system/node/node" + std::to_string(_node) + "/cpulist");
+    std::string   line;
+
+    if (!std::getline(ifs, line)) {
+        return ErrorCodeT(ENOENT, std::system_category());
+    }
+
+    _rcpu_set.clear();
+
+    const char* pc = line.c_str();
+    while (*pc >= '0' && *pc <= '9') {
+        char*        pend;
+        const size_t first = strtoul(pc, &pend, 10);
+        size_t       last  = first;
+
+        if (*pend == '-') {
+            last = strtoul(pend + 1, &pend, 10);
+        }
+        for (size_t cpu = first; cpu <= last; ++cpu) {
+            _rcpu_set.push_back(cpu);
+        }
+        pc = *pend == ',' ? pend + 1 : pend;
+    }
+
+    if (_rcpu_set.empty()) {
+        return ErrorCodeT(ENOENT, std::system_category());
+    }
+    return ErrorCodeT();
+#else
+    return error_not_implemented;
+#endif
+}
+
 } //namespace solid
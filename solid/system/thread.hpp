@@ -0,0 +1,34 @@
+// solid/system/thread.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include "solid/system/common.hpp"
+#include "solid/system/error.hpp"
+#include <vector>
+
+namespace solid {
+
+//! A set of cpu indexes, as numbered by the operating system
+using CpuSetT = std::vector<size_t>;
+
+//! Pins the calling thread to the given cpus - Linux only
+ErrorCodeT thread_affinity(const CpuSetT& _rcpu_set);
+
+//! Makes the calling thread prefer allocating memory on the given NUMA node - Linux only
+/*!
+    Only the pages touched for the first time after the call are affected.
+*/
+ErrorCodeT thread_memory_node(const size_t _node);
+
+//! Fills the cpus of the given NUMA node - Linux only
+ErrorCodeT numa_node_cpu_set(const size_t _node, CpuSetT& _rcpu_set);
+
+} //namespace solid
@@ -0,0 +1,88 @@
+// solid/utility/mpscqueue.hpp
+//
+// Copyright (c) 2018 Valentin Palade (vipalade @ gmail . com)
+//
+// This file is part of SolidFrame framework.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt.
+//
+
+#pragma once
+
+#include <atomic>
+
+namespace solid {
+
+//! Intrusive lock-free multiple producers single consumer queue
+/*!
+    T must have a "T* next" member. The queue does not own the nodes.
+    Producers link the node in front of the head with a CAS loop.
+    The consumer takes all the queued nodes at once and gets them back
+    in push order. Because nodes are never popped one by one, there is no ABA.
+
+    push returns true when the queue was empty, so that only one of
+    the producers has to wake the consumer.
+*/
+template <class T>
+class MpscQueue {
+public:
+    MpscQueue()
+        : head_(nullptr)
+    {
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    //! Called by producers - returns true if the queue was empty
+    bool push(T* _pnode)
+    {
+        T* phead = head_.load(std::memory_order_relaxed);
+        do {
+            _pnode->next = phead;
+        } while (!head_.compare_exchange_weak(phead, _pnode, std::memory_order_release, std::memory_order_relaxed));
+        return phead == nullptr;
+    }
+
+    //! Called by producers - links a chain of nodes with a single CAS
+    /*!
+        The chain goes from _pnewest through next down to _poldest, the
+        consumer gets it back in the order from _poldest to _pnewest.
+        Returns true if the queue was empty.
+    */
+    bool push(T* _pnewest, T* _poldest)
+    {
+        T* phead = head_.load(std::memory_order_relaxed);
+        do {
+            _poldest->next = phead;
+        } while (!head_.compare_exchange_weak(phead, _pnewest, std::memory_order_release, std::memory_order_relaxed));
+        return phead == nullptr;
+    }
+
+    //! A hint for the consumer, a push might be in progress
+    bool empty() const
+    {
+        return head_.load(std::memory_order_relaxed) == nullptr;
+    }
+
+    //! Called by the consumer - returns the oldest node, the others follow through next
+    T* pop()
+    {
+        T* pnode = head_.exchange(nullptr, std::memory_order_acquire);
+        T* pprev = nullptr;
+
+        while (pnode != nullptr) {
+            T* pnext    = pnode->next;
+            pnode->next = pprev;
+            pprev       = pnode;
+            pnode       = pnext;
+        }
+        return pprev;
+    }
+
+private:
+    std::atomic<T*> head_;
+};
+
+} //namespace solid